@@ -0,0 +1,417 @@
+/**
+ * @file AdaptiveEncoding.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains adaptive raw, run-length and dictionary encoding of low-cardinality arrays
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_ADAPTIVEENCODING_HPP
+#define BUFFERS_ADAPTIVEENCODING_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "EncodedVector.hpp"
+#include "Varint.hpp"
+#include "BitPacked.hpp"
+
+namespace buffers {
+/**
+ * Encoding which is recorded in one-byte tag before array
+ */
+enum class ArrayEncoding : uint8_t {
+  Raw = 0,
+  RunLength = 1,
+  Dictionary = 2,
+};
+
+/**
+ * Operations on elements of adaptive arrays, trivially copyable values are compared and stored as bytes
+ * @tparam T Trivially copyable type
+ */
+template <typename T>
+struct AdaptiveElement {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "Adaptive encoding supports only trivially copyable types and std::string !!");
+
+  struct Less {
+    bool operator()(const T & _lhs, const T & _rhs) const {
+      return std::memcmp(&_lhs, &_rhs, sizeof(T)) < 0;
+    }
+  };
+
+  static bool isEqual(const T & _lhs, const T & _rhs) {
+    return std::memcmp(&_lhs, &_rhs, sizeof(T)) == 0;
+  }
+
+  static size_t getSize(const T &) {
+    return sizeof(T);
+  }
+
+  static uint8_t * write(const T & _value, uint8_t * _pDst) {
+    std::memcpy(_pDst, &_value, sizeof(T));
+    return _pDst + sizeof(T);
+  }
+
+  /**
+   * Method for reading of value
+   * @return End of read value or nullptr if data is truncated
+   */
+  static uint8_t const * read(uint8_t const * _pSrc, uint8_t const * const _pEnd, T & _value) {
+    uint8_t const * result = nullptr;
+    if (static_cast<size_t>(_pEnd - _pSrc) >= sizeof(T)) {
+      std::memcpy(&_value, _pSrc, sizeof(T));
+      result = _pSrc + sizeof(T);
+    }
+    return result;
+  }
+};
+
+/**
+ * Strings are stored null-terminated one after another like std::string is packed by PackBuffer
+ */
+template <>
+struct AdaptiveElement<std::string> {
+  using Less = std::less<std::string>;
+
+  static bool isEqual(const std::string & _lhs, const std::string & _rhs) {
+    return _lhs == _rhs;
+  }
+
+  static size_t getSize(const std::string & _value) {
+    return _value.size() + 1;
+  }
+
+  static uint8_t * write(const std::string & _value, uint8_t * _pDst) {
+    std::memcpy(_pDst, _value.c_str(), _value.size() + 1);
+    return _pDst + _value.size() + 1;
+  }
+
+  static uint8_t const * read(uint8_t const * _pSrc, uint8_t const * const _pEnd, std::string & _value) {
+    uint8_t const * result = nullptr;
+    const void * pNull = std::memchr(_pSrc, 0, static_cast<size_t>(_pEnd - _pSrc));
+    if (pNull != nullptr) {
+      result = static_cast<uint8_t const *>(pNull);
+      _value.assign(reinterpret_cast<const char *>(_pSrc), reinterpret_cast<const char *>(result));
+      ++result;
+    }
+    return result;
+  }
+};
+
+/**
+ * Encoding of array with the smallest of raw, run-length and dictionary encodings, layout:
+ *     tag | count | encoded array
+ * Raw array is values one after another, run-length array is
+ *     runs count | size of varint run lengths | run lengths | padding | run values
+ * and dictionary array is
+ *     dictionary size | dictionary values | padding | bit-packed indices | padding
+ * Values should be trivially copyable or std::string
+ */
+struct AdaptiveFormat {
+  using SizeType = size_t;
+
+  /**
+   * Dictionary is built only if sample of kSampleSize evenly spread values has at most
+   * half of distinct values, dictionary larger than kMaxDictionarySize is dropped
+   */
+  static constexpr size_t kSampleSize = 1024;
+  static constexpr size_t kMaxDictionarySize = 1 << 16;
+
+  template <typename TBufferContext, typename T>
+  static bool put(TBufferContext & _ctx, const std::vector<T> & _vector) {
+    using Element = AdaptiveElement<T>;
+    size_t rawSize = 0;
+    size_t runsCount = 0;
+    size_t runsSize = 0;
+    size_t lengthsSize = 0;
+    size_t runLength = 0;
+    for (size_t i = 0; i < _vector.size(); ++i) {
+      const size_t kSize = Element::getSize(_vector[i]);
+      rawSize += kSize;
+      if (i == 0 || !Element::isEqual(_vector[i], _vector[i - 1])) {
+        lengthsSize += (i > 0) ? Varint::getSize(runLength) : 0;
+        runsSize += kSize;
+        runLength = 0;
+        ++runsCount;
+      }
+      ++runLength;
+    }
+    lengthsSize += (runsCount > 0) ? Varint::getSize(runLength) : 0;
+
+    std::vector<T> dictionary;
+    std::vector<uint32_t> indices;
+    size_t dictionarySize = 0;
+    if (isDictionaryCandidate(_vector) && buildDictionary(_vector, dictionary, indices)) {
+      for (const T & kValue : dictionary) {
+        dictionarySize += Element::getSize(kValue);
+      }
+    }
+    const unsigned kBits = BitPacking::getBitsCount(dictionary.empty() ? 0 : dictionary.size() - 1);
+    const size_t kIndicesSize = BitPacking::getPackedSize(_vector.size(), kBits);
+
+    ArrayEncoding encoding = ArrayEncoding::Raw;
+    size_t encodedSize = rawSize;
+    if (2 * sizeof(SizeType) + lengthsSize + runsSize < encodedSize) {
+      encoding = ArrayEncoding::RunLength;
+      encodedSize = 2 * sizeof(SizeType) + lengthsSize + runsSize;
+    }
+    if (!dictionary.empty() && sizeof(SizeType) + dictionarySize + kIndicesSize < encodedSize) {
+      encoding = ArrayEncoding::Dictionary;
+    }
+
+    const AlignMemory kAlignment = _ctx.alignment();
+    size_t totalSize = getAlignedSize(sizeof(uint8_t), kAlignment) + getAlignedSize(sizeof(SizeType), kAlignment);
+    switch (encoding) {
+      case ArrayEncoding::Raw:
+        totalSize += getAlignedSize(rawSize, kAlignment);
+        break;
+      case ArrayEncoding::RunLength:
+        totalSize += 2 * getAlignedSize(sizeof(SizeType), kAlignment) + getAlignedSize(lengthsSize, kAlignment) +
+                     getAlignedSize(runsSize, kAlignment);
+        break;
+      case ArrayEncoding::Dictionary:
+        totalSize += getAlignedSize(sizeof(SizeType), kAlignment) + getAlignedSize(dictionarySize, kAlignment) +
+                     getAlignedSize(kIndicesSize, kAlignment);
+        break;
+    }
+
+    bool result = false;
+    if (totalSize <= _ctx.buffer_size()) {
+      PackBuffer::DelegatePackBuffer<uint8_t>{}.put(_ctx, static_cast<uint8_t>(encoding));
+      PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, _vector.size());
+      uint8_t * pDst = _ctx.buffer();
+      switch (encoding) {
+        case ArrayEncoding::Raw:
+          for (const T & kValue : _vector) {
+            pDst = Element::write(kValue, pDst);
+          }
+          _ctx += rawSize;
+          break;
+        case ArrayEncoding::RunLength:
+          PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, runsCount);
+          PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, lengthsSize);
+          putRunLengths(_ctx.buffer(), _vector);
+          _ctx += lengthsSize;
+          pDst = _ctx.buffer();
+          for (size_t i = 0; i < _vector.size(); ++i) {
+            if (i == 0 || !Element::isEqual(_vector[i], _vector[i - 1])) {
+              pDst = Element::write(_vector[i], pDst);
+            }
+          }
+          _ctx += runsSize;
+          break;
+        case ArrayEncoding::Dictionary:
+          PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, dictionary.size());
+          pDst = _ctx.buffer();
+          for (const T & kValue : dictionary) {
+            pDst = Element::write(kValue, pDst);
+          }
+          _ctx += dictionarySize;
+          BitPacking::pack(indices.data(), indices.size(), kBits, _ctx.buffer());
+          _ctx += kIndicesSize;
+          break;
+      }
+      result = true;
+    }
+    return result;
+  }
+
+  /**
+   * Raw encoding is never larger than the other ones
+   */
+  template <typename T>
+  static size_t getTypeSize(const std::vector<T> & _vector) {
+    size_t result = sizeof(uint8_t) + sizeof(SizeType);
+    for (const T & kValue : _vector) {
+      result += AdaptiveElement<T>::getSize(kValue);
+    }
+    return result;
+  }
+
+  template <typename TBufferContext, typename T>
+  static void get(TBufferContext & _ctx, std::vector<T> & _result) {
+    const uint8_t kEncoding = UnpackBuffer::DelegateUnpackBuffer<uint8_t>{}.get(_ctx);
+    const SizeType kCount = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    bool isDecoded = false;
+    switch (static_cast<ArrayEncoding>(kEncoding)) {
+      case ArrayEncoding::Raw:
+        // Every raw value takes at least one byte
+        isDecoded = kCount <= _ctx.buffer_size() && getValues(_ctx, kCount, _result);
+        break;
+      case ArrayEncoding::RunLength:
+        isDecoded = getRunLength(_ctx, kCount, _result);
+        break;
+      case ArrayEncoding::Dictionary:
+        isDecoded = getDictionary(_ctx, kCount, _result);
+        break;
+    }
+    if (!isDecoded) {
+#ifdef __cpp_exceptions
+      throw std::out_of_range("Adaptive array data is corrupted or out of buffer !!");
+#else
+      _result.clear();
+#endif
+    }
+  }
+
+ private:
+  template <typename T>
+  static bool isDictionaryCandidate(const std::vector<T> & _vector) {
+    std::set<T, typename AdaptiveElement<T>::Less> distinct;
+    const size_t kStep = _vector.size() / kSampleSize + 1;
+    size_t sampledCount = 0;
+    for (size_t i = 0; i < _vector.size(); i += kStep) {
+      distinct.insert(_vector[i]);
+      ++sampledCount;
+    }
+    return 2 * distinct.size() <= sampledCount;
+  }
+
+  /**
+   * Method for building of dictionary in order of first appearance of values
+   * @return Return false if dictionary is too large
+   */
+  template <typename T>
+  static bool buildDictionary(const std::vector<T> & _vector, std::vector<T> & _dictionary,
+                              std::vector<uint32_t> & _indices) {
+    std::map<T, uint32_t, typename AdaptiveElement<T>::Less> indexes;
+    _indices.reserve(_vector.size());
+    for (const T & kValue : _vector) {
+      auto iter = indexes.lower_bound(kValue);
+      if (iter == indexes.end() || indexes.key_comp()(kValue, iter->first)) {
+        if (_dictionary.size() == kMaxDictionarySize) {
+          _dictionary.clear();
+          _indices.clear();
+          return false;
+        }
+        iter = indexes.emplace_hint(iter, kValue, static_cast<uint32_t>(_dictionary.size()));
+        _dictionary.push_back(kValue);
+      }
+      _indices.push_back(iter->second);
+    }
+    return true;
+  }
+
+  template <typename T>
+  static void putRunLengths(uint8_t * _pDst, const std::vector<T> & _vector) {
+    size_t runLength = 0;
+    for (size_t i = 0; i < _vector.size(); ++i) {
+      if (i > 0 && !AdaptiveElement<T>::isEqual(_vector[i], _vector[i - 1])) {
+        _pDst = Varint::encode(runLength, _pDst);
+        runLength = 0;
+      }
+      ++runLength;
+    }
+    if (runLength > 0) {
+      Varint::encode(runLength, _pDst);
+    }
+  }
+
+  /**
+   * Method for reading of _count values placed one after another
+   */
+  template <typename TBufferContext, typename T>
+  static bool getValues(TBufferContext & _ctx, const size_t _count, std::vector<T> & _values) {
+    uint8_t const * pSrc = _ctx.buffer();
+    uint8_t const * const pEnd = pSrc + _ctx.buffer_size();
+    _values.resize(_count);
+    for (size_t i = 0; i < _count && pSrc != nullptr; ++i) {
+      pSrc = AdaptiveElement<T>::read(pSrc, pEnd, _values[i]);
+    }
+    if (pSrc != nullptr) {
+      _ctx += static_cast<size_t>(pSrc - _ctx.buffer());
+    }
+    return pSrc != nullptr;
+  }
+
+  template <typename TBufferContext, typename T>
+  static bool getRunLength(TBufferContext & _ctx, const size_t _count, std::vector<T> & _result) {
+    const SizeType kRunsCount = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    const SizeType kLengthsSize = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    if (kLengthsSize > _ctx.buffer_size() || kRunsCount > kLengthsSize || kRunsCount > _count) {
+      return false;
+    }
+    std::vector<uint64_t> lengths(kRunsCount);
+    uint8_t const * pSrc = _ctx.buffer();
+    uint8_t const * const pEnd = pSrc + kLengthsSize;
+    uint64_t total = 0;
+    for (size_t i = 0; i < kRunsCount && pSrc != nullptr; ++i) {
+      pSrc = Varint::decode(pSrc, pEnd, lengths[i]);
+      total += (pSrc != nullptr && lengths[i] <= _count - total) ? lengths[i] : (_count + 1);
+      pSrc = (total <= _count) ? pSrc : nullptr;
+    }
+    if (pSrc == nullptr || total != _count) {
+      return false;
+    }
+    _ctx += kLengthsSize;
+    std::vector<T> values;
+    if (!getValues(_ctx, kRunsCount, values)) {
+      return false;
+    }
+    _result.reserve(_count);
+    for (size_t i = 0; i < kRunsCount; ++i) {
+      _result.insert(_result.end(), static_cast<size_t>(lengths[i]), values[i]);
+    }
+    return true;
+  }
+
+  template <typename TBufferContext, typename T>
+  static bool getDictionary(TBufferContext & _ctx, const size_t _count, std::vector<T> & _result) {
+    const SizeType kDictionarySize = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    std::vector<T> dictionary;
+    if (kDictionarySize == 0 || kDictionarySize > kMaxDictionarySize ||
+        kDictionarySize > _ctx.buffer_size() || !getValues(_ctx, kDictionarySize, dictionary)) {
+      return false;
+    }
+    const unsigned kBits = BitPacking::getBitsCount(kDictionarySize - 1);
+    if (_count > std::numeric_limits<size_t>::max() / BitPacking::kMaxBits ||
+        BitPacking::getPackedSize(_count, kBits) > _ctx.buffer_size()) {
+      return false;
+    }
+    std::vector<uint32_t> indices(_count);
+    BitPacking::unpack(_ctx.buffer(), _count, kBits, indices.data());
+    _result.reserve(_count);
+    for (const uint32_t kIndex : indices) {
+      if (kIndex >= kDictionarySize) {
+        return false;
+      }
+      _result.push_back(dictionary[kIndex]);
+    }
+    _ctx += BitPacking::getPackedSize(_count, kBits);
+    return true;
+  }
+};
+
+/**
+ * std::vector of trivially copyable values or std::string which is packed with adaptive encoding
+ */
+template <typename T>
+using AdaptiveVector = EncodedVector<T, AdaptiveFormat>;
+
+template <typename T>
+using AdaptiveView = EncodedView<T, AdaptiveFormat>;
+
+/**
+ * Method for packing of existing vector with adaptive encoding without copying:
+ *     buffer.put(buffers::adaptive(statuses));
+ * Packed data is unpacked as AdaptiveVector
+ */
+template <typename T>
+AdaptiveView<T> adaptive(const std::vector<T> & _vector) {
+  return AdaptiveView<T>(_vector);
+}
+}
+
+#endif //BUFFERS_ADAPTIVEENCODING_HPP
@@ -9,6 +9,8 @@
 #ifndef BUFFERS_ALIGNMEMORY_HPP
 #define BUFFERS_ALIGNMEMORY_HPP
 
+#include <cstddef>
+
 namespace buffers {
 
 enum class AlignMemory {
@@ -18,6 +20,26 @@ enum class AlignMemory {
   Bits_64 = 8,
 };
 
+/**
+ * Method for rounding of size up to the multiple of alignment
+ * @param _size Size of data
+ * @param _alignment Alignment of packed data
+ * @return Size of data with padding
+ */
+inline size_t getAlignedSize(const size_t _size, AlignMemory _alignment) {
+  const size_t kAlignment = static_cast<size_t>(_alignment);
+  return (_size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+/**
+ * Method for checking of alignment read from shared or persistent memory
+ * @param _alignment Alignment in bytes
+ * @return Return true if it is value of AlignMemory, false otherwise
+ */
+inline bool isValidAlignment(const size_t _alignment) {
+  return _alignment == 1 || _alignment == 2 || _alignment == 4 || _alignment == 8;
+}
+
 }
 
 #endif //BUFFERS_ALIGNMEMORY_HPP
@@ -0,0 +1,531 @@
+/**
+ * @file AsyncSocket.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains C++20 coroutine based sending and receiving of packed buffers over sockets
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_ASYNCSOCKET_HPP
+#define BUFFERS_ASYNCSOCKET_HPP
+
+#if defined(__cpp_impl_coroutine) && (__cplusplus >= 202002L)
+
+#include <stdint.h>
+#include <cerrno>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "Frame.hpp"
+
+namespace buffers {
+template <typename T = void>
+class Task;
+
+/**
+ * Common part of Task promise: lazy start and resuming of awaiting coroutine on completion
+ */
+class TaskPromiseBase {
+ public:
+  struct FinalAwaiter {
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    template <typename TPromise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> _handle) noexcept {
+      std::coroutine_handle<> continuation = _handle.promise().continuation_;
+      return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {
+    }
+  };
+
+  std::suspend_always initial_suspend() const noexcept {
+    return {};
+  }
+
+  FinalAwaiter final_suspend() const noexcept {
+    return {};
+  }
+
+  void unhandled_exception() noexcept {
+#ifdef __cpp_exceptions
+    exception_ = std::current_exception();
+#else
+    std::terminate();
+#endif
+  }
+
+  void rethrowIfFailed() const {
+#ifdef __cpp_exceptions
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+#endif
+  }
+
+  std::coroutine_handle<> continuation_;
+
+ private:
+  std::exception_ptr exception_;
+};
+
+/**
+ * Lazily started coroutine, is started when it is awaited or spawned on EpollExecutor
+ * @tparam T Type of result
+ */
+template <typename T>
+class Task {
+ public:
+  class promise_type : public TaskPromiseBase {
+   public:
+    Task get_return_object() noexcept {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    template <typename TValue>
+    void return_value(TValue && _value) {
+      value_.emplace(std::forward<TValue>(_value));
+    }
+
+    std::optional<T> value_;
+  };
+
+  Task(Task && _other) noexcept
+      : handle_(std::exchange(_other.handle_, {})) {
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  bool await_ready() const noexcept {
+    return !handle_ || handle_.done();
+  }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> _continuation) noexcept {
+    handle_.promise().continuation_ = _continuation;
+    return handle_;
+  }
+
+  T await_resume() {
+    handle_.promise().rethrowIfFailed();
+    return std::move(*handle_.promise().value_);
+  }
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> _handle)
+      : handle_(_handle) {
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template <>
+class Task<void> {
+ public:
+  class promise_type : public TaskPromiseBase {
+   public:
+    Task get_return_object() noexcept {
+      return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    void return_void() const noexcept {
+    }
+  };
+
+  Task(Task && _other) noexcept
+      : handle_(std::exchange(_other.handle_, {})) {
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  bool await_ready() const noexcept {
+    return !handle_ || handle_.done();
+  }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> _continuation) noexcept {
+    handle_.promise().continuation_ = _continuation;
+    return handle_;
+  }
+
+  void await_resume() const {
+    handle_.promise().rethrowIfFailed();
+  }
+
+ private:
+  explicit Task(std::coroutine_handle<promise_type> _handle)
+      : handle_(_handle) {
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * Single-threaded executor which resumes coroutines waiting for socket readiness with epoll
+ */
+class EpollExecutor {
+ public:
+  /**
+   * State of registered file descriptor: coroutines waiting for reading and writing
+   */
+  struct IoState {
+    int fd = -1;
+    std::coroutine_handle<> reader;
+    std::coroutine_handle<> writer;
+  };
+
+  EpollExecutor()
+      : epoll_fd_{::epoll_create1(EPOLL_CLOEXEC)}
+      , num_tasks_{0}
+      , is_stopped_{false} {
+  }
+
+  EpollExecutor(const EpollExecutor&) = delete;
+  EpollExecutor& operator=(const EpollExecutor&) = delete;
+
+  ~EpollExecutor() {
+    if (epoll_fd_ >= 0) {
+      ::close(epoll_fd_);
+    }
+  }
+
+  /**
+   * Method for starting of task, task runs till its first suspension immediately
+   * @param _task Task to run, it is owned by executor till completion
+   */
+  void spawn(Task<void> _task) {
+    ++num_tasks_;
+    runDetached(*this, std::move(_task));
+  }
+
+  /**
+   * Method for running of event loop till all spawned tasks are completed or stop() is called
+   */
+  void run() {
+    is_stopped_ = false;
+    epoll_event events[kMaxEvents];
+    std::vector<std::coroutine_handle<>> ready;
+    while (num_tasks_ > 0 && !is_stopped_) {
+      const int kCount = ::epoll_wait(epoll_fd_, events, kMaxEvents, -1);
+      if (kCount < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        break;
+      }
+      // Handles are collected before resuming, resumed coroutine could destroy other sockets
+      ready.clear();
+      for (int i = 0; i < kCount; ++i) {
+        IoState * pState = static_cast<IoState *>(events[i].data.ptr);
+        const uint32_t kEvents = events[i].events;
+        if ((kEvents & (EPOLLIN | EPOLLRDHUP | EPOLLERR | EPOLLHUP)) && pState->reader) {
+          ready.push_back(std::exchange(pState->reader, {}));
+        }
+        if ((kEvents & (EPOLLOUT | EPOLLERR | EPOLLHUP)) && pState->writer) {
+          ready.push_back(std::exchange(pState->writer, {}));
+        }
+      }
+      for (auto handle : ready) {
+        handle.resume();
+      }
+    }
+  }
+
+  /**
+   * Method for stopping of event loop
+   */
+  void stop() {
+    is_stopped_ = true;
+  }
+
+  /**
+   * Method for registration of file descriptor, readiness is reported edge-triggered
+   * @param _state State of file descriptor, should live till deregistration
+   * @return Return true if registration is succeed, false otherwise
+   */
+  bool add(IoState & _state) {
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = &_state;
+    return ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, _state.fd, &event) == 0;
+  }
+
+  void remove(IoState & _state) {
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, _state.fd, nullptr);
+  }
+
+  size_t getTasksCount() const {
+    return num_tasks_;
+  }
+
+ private:
+  struct Detached {
+    struct promise_type {
+      Detached get_return_object() const noexcept {
+        return {};
+      }
+
+      std::suspend_never initial_suspend() const noexcept {
+        return {};
+      }
+
+      std::suspend_never final_suspend() const noexcept {
+        return {};
+      }
+
+      void return_void() const noexcept {
+      }
+
+      void unhandled_exception() const noexcept {
+        std::terminate();
+      }
+    };
+  };
+
+  static Detached runDetached(EpollExecutor & _executor, Task<void> _task) {
+    co_await _task;
+    --_executor.num_tasks_;
+  }
+
+  static constexpr int kMaxEvents = 256;
+
+  int epoll_fd_;
+  size_t num_tasks_;
+  bool is_stopped_;
+};
+
+/**
+ * Non-blocking socket driven by EpollExecutor, received stream is split into frames
+ */
+class AsyncSocket {
+ public:
+  /**
+   * Awaiter which suspends coroutine till socket becomes readable or writable
+   */
+  class ReadinessAwaiter {
+   public:
+    ReadinessAwaiter(std::coroutine_handle<> & _slot)
+        : slot_(_slot) {
+    }
+
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> _handle) noexcept {
+      slot_ = _handle;
+    }
+
+    void await_resume() const noexcept {
+    }
+
+   private:
+    std::coroutine_handle<> & slot_;
+  };
+
+  /**
+   * Constructor of asynchronous socket
+   * @param _executor Executor which drives the socket
+   * @param _fd Socket, it is switched to non-blocking mode and owned by AsyncSocket
+   * @param _alignment Alignment of packed data
+   */
+  AsyncSocket(EpollExecutor & _executor, const int _fd,
+              AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : executor_(_executor)
+      , alignment_{_alignment}
+      , rx_begin_{0}
+      , rx_end_{0} {
+    state_.fd = _fd;
+    ::fcntl(_fd, F_SETFL, ::fcntl(_fd, F_GETFL) | O_NONBLOCK);
+    is_registered_ = executor_.add(state_);
+  }
+
+  AsyncSocket(const AsyncSocket&) = delete;
+  AsyncSocket& operator=(const AsyncSocket&) = delete;
+
+  ~AsyncSocket() {
+    if (is_registered_) {
+      executor_.remove(state_);
+    }
+    ::close(state_.fd);
+  }
+
+  int getFd() const {
+    return state_.fd;
+  }
+
+  AlignMemory getAlignment() const {
+    return alignment_;
+  }
+
+  ReadinessAwaiter readable() {
+    return ReadinessAwaiter(state_.reader);
+  }
+
+  ReadinessAwaiter writable() {
+    return ReadinessAwaiter(state_.writer);
+  }
+
+  /**
+   * Method for receiving of data till one complete frame is buffered
+   * @return Return true if frame is available, false on end of stream or error
+   */
+  Task<bool> receiveFrame() {
+    bool result = hasFrame();
+    while (!result) {
+      if (rx_.size() - rx_end_ < kReceiveChunk) {
+        compact();
+      }
+      const ssize_t kRead = ::recv(state_.fd, rx_.data() + rx_end_, rx_.size() - rx_end_, 0);
+      if (kRead > 0) {
+        rx_end_ += static_cast<size_t>(kRead);
+        result = hasFrame();
+      } else if (kRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        co_await readable();
+      } else if (kRead == 0 || errno != EINTR) {
+        break;
+      }
+    }
+    co_return result;
+  }
+
+  /**
+   * Method for getting of received frame, is valid till releaseFrame()
+   * @return Unpack buffer limited by the frame
+   */
+  UnpackBuffer getFrame() const {
+    const size_t kHeaderSize = FrameFormat::getHeaderSize(alignment_);
+    return UnpackBuffer(rx_.data() + rx_begin_ + kHeaderSize,
+                        FrameFormat::readHeader(rx_.data() + rx_begin_), alignment_);
+  }
+
+  /**
+   * Method for dropping of received frame
+   */
+  void releaseFrame() {
+    if (hasFrame()) {
+      rx_begin_ += FrameFormat::getFrameSize(FrameFormat::readHeader(rx_.data() + rx_begin_), alignment_);
+    }
+  }
+
+ private:
+  static constexpr size_t kReceiveChunk = 64 * 1024;
+
+  bool hasFrame() const {
+    const size_t kHeaderSize = FrameFormat::getHeaderSize(alignment_);
+    return (rx_end_ - rx_begin_ >= kHeaderSize) &&
+           (FrameFormat::getFrameSize(FrameFormat::readHeader(rx_.data() + rx_begin_), alignment_)
+              <= rx_end_ - rx_begin_);
+  }
+
+  /**
+   * Method for moving of unread data to the beginning of receive buffer and growing it if needed
+   */
+  void compact() {
+    if (rx_begin_ > 0) {
+      std::copy(rx_.begin() + rx_begin_, rx_.begin() + rx_end_, rx_.begin());
+      rx_end_ -= rx_begin_;
+      rx_begin_ = 0;
+    }
+    if (rx_.size() - rx_end_ < kReceiveChunk) {
+      rx_.resize(rx_end_ + kReceiveChunk);
+    }
+  }
+
+  EpollExecutor & executor_;
+  EpollExecutor::IoState state_;
+  bool is_registered_;
+  AlignMemory alignment_;
+  std::vector<uint8_t> rx_;
+  size_t rx_begin_;
+  size_t rx_end_;
+};
+
+/**
+ * Method for sending of packed buffer as one frame
+ * @param _socket Socket to send to
+ * @param _buffer Packed buffer, should live till sending is completed
+ * @return Task which results in true if buffer is sent, false otherwise
+ */
+inline Task<bool> asyncSend(AsyncSocket & _socket, const PackBuffer & _buffer) {
+  uint8_t header[sizeof(uint64_t)];
+  FrameFormat::writeHeader(header, _buffer.getDataSize(), _buffer.getAlignment());
+  iovec iov[2] = {
+    iovec{header, FrameFormat::getHeaderSize(_buffer.getAlignment())},
+    iovec{const_cast<uint8_t *>(_buffer.getData()), _buffer.getDataSize()},
+  };
+  iovec * pIov = iov;
+  size_t numIov = 2;
+  bool result = true;
+  while (result && numIov > 0) {
+    msghdr msg{};
+    msg.msg_iov = pIov;
+    msg.msg_iovlen = numIov;
+    // MSG_NOSIGNAL, otherwise reset by peer raises SIGPIPE for the whole process
+    const ssize_t kWritten = ::sendmsg(_socket.getFd(), &msg, MSG_NOSIGNAL);
+    if (kWritten >= 0) {
+      size_t written = static_cast<size_t>(kWritten);
+      while (numIov > 0 && written >= pIov->iov_len) {
+        written -= pIov->iov_len;
+        ++pIov;
+        --numIov;
+      }
+      if (numIov > 0) {
+        pIov->iov_base = static_cast<uint8_t *>(pIov->iov_base) + written;
+        pIov->iov_len -= written;
+      }
+    } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      co_await _socket.writable();
+    } else if (errno != EINTR) {
+      result = false;
+    }
+  }
+  co_return result;
+}
+
+/**
+ * Method for receiving of one frame and unpacking of value from it.
+ * Value is unpacked with DelegateUnpackBuffer, so user-defined specializations are used
+ * @tparam T Type of value
+ * @param _socket Socket to receive from
+ * @return Task which results in value or std::nullopt on end of stream or error
+ */
+template <typename T>
+Task<std::optional<T>> asyncReceive(AsyncSocket & _socket) {
+  std::optional<T> result;
+  if (co_await _socket.receiveFrame()) {
+    UnpackBuffer frame = _socket.getFrame();
+    result.emplace(frame.get<T>());
+    _socket.releaseFrame();
+  }
+  co_return result;
+}
+}
+
+#endif
+
+#endif //BUFFERS_ASYNCSOCKET_HPP
@@ -0,0 +1,308 @@
+/**
+ * @file BitPacked.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains bit-packed encoding of small enum and integer arrays
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_BITPACKED_HPP
+#define BUFFERS_BITPACKED_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "EncodedVector.hpp"
+#include "Simd.hpp"
+
+namespace buffers {
+/**
+ * Packing of values with fixed number of bits, value i takes bits [i * bits, (i + 1) * bits)
+ * of little endian bit stream. Every 8 values end on byte boundary
+ */
+class BitPacking {
+ public:
+  enum class Kernel {
+    Scalar,
+    Bmi2,
+  };
+
+  static constexpr unsigned kMaxBits = 32;
+
+  /**
+   * Method for checking whether CPU supports kernel
+   */
+  static bool isSupported(const Kernel _kernel) {
+#ifdef BUFFERS_HAS_BMI2
+    return (_kernel == Kernel::Scalar) || __builtin_cpu_supports("bmi2");
+#else
+    return _kernel == Kernel::Scalar;
+#endif
+  }
+
+  /**
+   * Method for getting the fastest kernel supported by CPU, it is detected once
+   */
+  static Kernel getBestKernel() {
+    static const Kernel kKernel = isSupported(Kernel::Bmi2) ? Kernel::Bmi2 : Kernel::Scalar;
+    return kKernel;
+  }
+
+  /**
+   * Method for getting number of bits which are enough for values up to _maxValue
+   */
+  static constexpr unsigned getBitsCount(const uint64_t _maxValue) {
+    return (_maxValue <= 1) ? 1 : (1 + getBitsCount(_maxValue >> 1));
+  }
+
+  static size_t getPackedSize(const size_t _count, const unsigned _bits) {
+    return (_count * _bits + 7) / 8;
+  }
+
+  /**
+   * Method for packing of values, only low _bits of every value are packed
+   * @param _pIn Values
+   * @param _count Number of values
+   * @param _bits Number of bits per value, from 1 to kMaxBits
+   * @param _pOut Destination of getPackedSize(_count, _bits) bytes
+   */
+  static void pack(const uint32_t * _pIn, const size_t _count, const unsigned _bits, uint8_t * _pOut,
+                   const Kernel _kernel = getBestKernel()) {
+    size_t index = 0;
+#ifdef BUFFERS_HAS_BMI2
+    if (_kernel == Kernel::Bmi2 && _bits <= 8) {
+      packBmi2(_pIn, _count, index, _bits, _pOut);
+    }
+#else
+    (void)_kernel;
+#endif
+    packScalar(_pIn, _count, index, _bits, _pOut);
+  }
+
+  /**
+   * Method for unpacking of values
+   * @param _pIn Source of getPackedSize(_count, _bits) bytes
+   * @param _count Number of values
+   * @param _bits Number of bits per value, from 1 to kMaxBits
+   * @param _pOut Destination of values
+   */
+  static void unpack(uint8_t const * _pIn, const size_t _count, const unsigned _bits, uint32_t * _pOut,
+                     const Kernel _kernel = getBestKernel()) {
+    size_t index = 0;
+#ifdef BUFFERS_HAS_BMI2
+    if (_kernel == Kernel::Bmi2 && _bits <= 8) {
+      unpackBmi2(_pIn, _count, index, _bits, _pOut);
+    }
+#else
+    (void)_kernel;
+#endif
+    unpackScalar(_pIn, _count, index, _bits, _pOut);
+  }
+
+ private:
+  /**
+   * Scalar packing of values from _index which should be multiple of 8, values are collected
+   * in 64-bit accumulator and written by 32-bit words
+   */
+  static void packScalar(const uint32_t * _pIn, const size_t _count, size_t _index, const unsigned _bits,
+                         uint8_t * _pOut) {
+    const uint64_t kMask = (uint64_t{1} << _bits) - 1;
+    uint8_t * pOut = _pOut + _index / 8 * _bits;
+    uint64_t bits = 0;
+    unsigned bitsCount = 0;
+    for (; _index < _count; ++_index) {
+      bits |= (_pIn[_index] & kMask) << bitsCount;
+      bitsCount += _bits;
+      if (bitsCount >= 32) {
+        putBytes(pOut, bits, 4);
+        pOut += 4;
+        bits >>= 32;
+        bitsCount -= 32;
+      }
+    }
+    putBytes(pOut, bits, (bitsCount + 7) / 8);
+  }
+
+  static void unpackScalar(uint8_t const * _pIn, const size_t _count, size_t _index, const unsigned _bits,
+                           uint32_t * _pOut) {
+    const uint64_t kMask = (uint64_t{1} << _bits) - 1;
+    uint8_t const * pIn = _pIn + _index / 8 * _bits;
+    uint8_t const * const pInEnd = _pIn + getPackedSize(_count, _bits);
+    uint64_t bits = 0;
+    unsigned bitsCount = 0;
+    for (; _index < _count; ++_index) {
+      while (bitsCount < _bits) {
+        const unsigned kBytesCount = (pInEnd - pIn >= 4) ? 4 : 1;
+        bits |= getBytes(pIn, kBytesCount) << bitsCount;
+        pIn += kBytesCount;
+        bitsCount += 8 * kBytesCount;
+      }
+      _pOut[_index] = static_cast<uint32_t>(bits & kMask);
+      bits >>= _bits;
+      bitsCount -= _bits;
+    }
+  }
+
+  static void putBytes(uint8_t * _pOut, const uint64_t _bits, const unsigned _bytesCount) {
+    for (unsigned i = 0; i < _bytesCount; ++i) {
+      _pOut[i] = static_cast<uint8_t>(_bits >> (8 * i));
+    }
+  }
+
+  static uint64_t getBytes(uint8_t const * _pIn, const unsigned _bytesCount) {
+    uint64_t result = 0;
+    for (unsigned i = 0; i < _bytesCount; ++i) {
+      result |= static_cast<uint64_t>(_pIn[i]) << (8 * i);
+    }
+    return result;
+  }
+
+#ifdef BUFFERS_HAS_BMI2
+  /**
+   * BMI2 kernels handle 8 values of up to 8 bits as bytes of 64-bit word, they are packed
+   * to exactly _bits bytes with one PEXT and unpacked with one PDEP
+   */
+  __attribute__((target("bmi2")))
+  static void packBmi2(const uint32_t * _pIn, const size_t _count, size_t & _index, const unsigned _bits,
+                       uint8_t * _pOut) {
+    const uint64_t kMask = 0x0101010101010101ULL * ((1u << _bits) - 1);
+    for (; _index + 8 <= _count; _index += 8) {
+      uint64_t bytes = 0;
+      for (unsigned k = 0; k < 8; ++k) {
+        bytes |= static_cast<uint64_t>(static_cast<uint8_t>(_pIn[_index + k])) << (8 * k);
+      }
+      const uint64_t kPacked = _pext_u64(bytes, kMask);
+      std::memcpy(_pOut + _index / 8 * _bits, &kPacked, _bits);
+    }
+  }
+
+  __attribute__((target("bmi2")))
+  static void unpackBmi2(uint8_t const * _pIn, const size_t _count, size_t & _index, const unsigned _bits,
+                         uint32_t * _pOut) {
+    const uint64_t kMask = 0x0101010101010101ULL * ((1u << _bits) - 1);
+    for (; _index + 8 <= _count; _index += 8) {
+      uint64_t packed = 0;
+      std::memcpy(&packed, _pIn + _index / 8 * _bits, _bits);
+      const uint64_t kBytes = _pdep_u64(packed, kMask);
+      for (unsigned k = 0; k < 8; ++k) {
+        _pOut[_index + k] = static_cast<uint8_t>(kBytes >> (8 * k));
+      }
+    }
+  }
+#endif
+};
+
+/**
+ * Encoding of enum or integer values up to kMaxValue with
+ * BitPacking::getBitsCount(kMaxValue) bits per value, layout:
+ *     count | bit stream | padding
+ * Putting of value greater than kMaxValue fails
+ * @tparam T Enum or integer type
+ * @tparam kMaxValue Declared maximum value
+ */
+template <typename T, T kMaxValue>
+struct BitPackedFormat {
+  static_assert((std::is_enum<T>::value || std::is_integral<T>::value) && !std::is_same<T, bool>::value,
+                "Bit packing supports only enum and integer types, std::vector<bool> is packed by bits already !!");
+  static_assert(BitPacking::getBitsCount(static_cast<uint64_t>(kMaxValue)) <= BitPacking::kMaxBits,
+                "Maximum value should fit to 32 bits !!");
+
+  using SizeType = size_t;
+
+  /**
+   * Values are converted to uint32_t by chunks on stack, chunk size keeps chunks on byte boundary
+   */
+  static constexpr size_t kChunkSize = 256;
+  static constexpr unsigned kBits = BitPacking::getBitsCount(static_cast<uint64_t>(kMaxValue));
+
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const std::vector<T> & _vector) {
+    bool result = false;
+    const size_t kHeaderSize = getAlignedSize(sizeof(SizeType), _ctx.alignment());
+    const size_t kPackedSize = BitPacking::getPackedSize(_vector.size(), kBits);
+    if (kHeaderSize + getAlignedSize(kPackedSize, _ctx.alignment()) <= _ctx.buffer_size()) {
+      uint8_t * const pOut = _ctx.buffer() + kHeaderSize;
+      uint32_t chunk[kChunkSize];
+      bool isValid = true;
+      for (size_t i = 0; i < _vector.size() && isValid; i += kChunkSize) {
+        size_t count = _vector.size() - i;
+        if (count > kChunkSize) {
+          count = kChunkSize;
+        }
+        for (size_t k = 0; k < count; ++k) {
+          const uint64_t kValue = static_cast<uint64_t>(_vector[i + k]);
+          isValid = isValid && (kValue <= static_cast<uint64_t>(kMaxValue));
+          chunk[k] = static_cast<uint32_t>(kValue);
+        }
+        BitPacking::pack(chunk, count, kBits, pOut + i / 8 * kBits);
+      }
+      if (isValid) {
+        PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, _vector.size());
+        _ctx += kPackedSize;
+        result = true;
+      }
+    }
+    return result;
+  }
+
+  static size_t getTypeSize(const std::vector<T> & _vector) {
+    return sizeof(SizeType) + BitPacking::getPackedSize(_vector.size(), kBits);
+  }
+
+  template <typename TBufferContext>
+  static void get(TBufferContext & _ctx, std::vector<T> & _result) {
+    const SizeType kCount = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    const bool kIsValid = kCount <= std::numeric_limits<size_t>::max() / BitPacking::kMaxBits &&
+                          BitPacking::getPackedSize(kCount, kBits) <= _ctx.buffer_size();
+    if (kIsValid) {
+      uint8_t const * const pIn = _ctx.buffer();
+      uint32_t chunk[kChunkSize];
+      _result.reserve(kCount);
+      for (size_t i = 0; i < kCount; i += kChunkSize) {
+        size_t count = kCount - i;
+        if (count > kChunkSize) {
+          count = kChunkSize;
+        }
+        BitPacking::unpack(pIn + i / 8 * kBits, count, kBits, chunk);
+        for (size_t k = 0; k < count; ++k) {
+          _result.push_back(static_cast<T>(chunk[k]));
+        }
+      }
+      _ctx += BitPacking::getPackedSize(kCount, kBits);
+    } else {
+#ifdef __cpp_exceptions
+      throw std::out_of_range("Bit-packed data is out of buffer !!");
+#endif
+    }
+  }
+};
+
+/**
+ * std::vector of enum or integer values up to kMaxValue which is packed with bits
+ * @tparam T Enum or integer type
+ * @tparam kMaxValue Declared maximum value
+ */
+template <typename T, T kMaxValue>
+using BitPackedVector = EncodedVector<T, BitPackedFormat<T, kMaxValue>>;
+
+template <typename T, T kMaxValue>
+using BitPackedView = EncodedView<T, BitPackedFormat<T, kMaxValue>>;
+
+/**
+ * Method for packing of existing vector with bits without copying:
+ *     buffer.put(buffers::bitPacked<Color, Color::Blue>(pixels));
+ * Packed data is unpacked as BitPackedVector
+ */
+template <typename T, T kMaxValue>
+BitPackedView<T, kMaxValue> bitPacked(const std::vector<T> & _vector) {
+  return BitPackedView<T, kMaxValue>(_vector);
+}
+}
+
+#endif //BUFFERS_BITPACKED_HPP
@@ -0,0 +1,429 @@
+/**
+ * @file BlockCompression.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains LZ77 block compression of packed buffers and decompressing Unpack Buffer
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_BLOCKCOMPRESSION_HPP
+#define BUFFERS_BLOCKCOMPRESSION_HPP
+
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+/**
+ * LZ77 compression of one block. Block is sequence of
+ *     token | extra literals length | literals | offset | extra match length
+ * where high nibble of token is literals length and low nibble is match length minus kMinMatch,
+ * nibble 15 is continued with bytes of 255 and the last byte less than 255.
+ * The last sequence has only literals. Matches refer only to the same block
+ */
+class Lz77 {
+ public:
+  static constexpr size_t kMinMatch = 4;
+  static constexpr size_t kMaxOffset = 0xFFFF;
+  static constexpr unsigned kHashBits = 14;
+
+  Lz77()
+      : table_(size_t{1} << kHashBits) {
+  }
+
+  /**
+   * Method for compressing of block
+   * @param _pSrc Block to compress
+   * @param _srcSize Size of block
+   * @param _pDst Destination of compressed block
+   * @param _dstCapacity Size of destination
+   * @return Size of compressed block or 0 if it does not fit to destination
+   */
+  size_t compress(uint8_t const * _pSrc, const size_t _srcSize, uint8_t * _pDst, const size_t _dstCapacity) {
+    std::fill(table_.begin(), table_.end(), 0);
+    uint8_t * pDst = _pDst;
+    uint8_t * const pDstEnd = _pDst + _dstCapacity;
+    size_t anchor = 0;
+    size_t position = 0;
+    while (position + kMinMatch <= _srcSize && pDst != nullptr) {
+      const uint32_t kSequence = load(_pSrc + position);
+      uint32_t & candidate = table_[hash(kSequence)];
+      const size_t kCandidate = candidate;
+      candidate = static_cast<uint32_t>(position);
+      if (kCandidate < position && position - kCandidate <= kMaxOffset && load(_pSrc + kCandidate) == kSequence) {
+        size_t length = kMinMatch;
+        while (position + length < _srcSize && _pSrc[kCandidate + length] == _pSrc[position + length]) {
+          ++length;
+        }
+        pDst = putSequence(pDst, pDstEnd, _pSrc + anchor, position - anchor, position - kCandidate, length);
+        position += length;
+        anchor = position;
+      } else {
+        // Incompressible data is skipped faster
+        position += 1 + ((position - anchor) >> 6);
+      }
+    }
+    if (pDst != nullptr) {
+      pDst = putSequence(pDst, pDstEnd, _pSrc + anchor, _srcSize - anchor, 0, 0);
+    }
+    return (pDst != nullptr) ? static_cast<size_t>(pDst - _pDst) : 0;
+  }
+
+  /**
+   * Method for decompressing of block
+   * @param _pSrc Compressed block
+   * @param _srcSize Size of compressed block
+   * @param _pDst Destination of block
+   * @param _dstSize Size of block, it should be known from framing
+   * @return Return true if block is decompressed to exactly _dstSize bytes, false if it is corrupted
+   */
+  static bool decompress(uint8_t const * _pSrc, const size_t _srcSize, uint8_t * _pDst, const size_t _dstSize) {
+    uint8_t const * pSrc = _pSrc;
+    uint8_t const * const pSrcEnd = _pSrc + _srcSize;
+    size_t position = 0;
+    while (pSrc != pSrcEnd) {
+      const uint8_t kToken = *pSrc++;
+      size_t literalsLength = kToken >> 4;
+      if (!getLength(pSrc, pSrcEnd, literalsLength) ||
+          static_cast<size_t>(pSrcEnd - pSrc) < literalsLength || _dstSize - position < literalsLength) {
+        return false;
+      }
+      std::memcpy(_pDst + position, pSrc, literalsLength);
+      pSrc += literalsLength;
+      position += literalsLength;
+      if (pSrc == pSrcEnd) {
+        break;
+      }
+      if (pSrcEnd - pSrc < 2) {
+        return false;
+      }
+      const size_t kOffset = static_cast<size_t>(pSrc[0]) | (static_cast<size_t>(pSrc[1]) << 8);
+      pSrc += 2;
+      size_t matchLength = kToken & 0xF;
+      if (!getLength(pSrc, pSrcEnd, matchLength)) {
+        return false;
+      }
+      matchLength += kMinMatch;
+      if (kOffset == 0 || kOffset > position || _dstSize - position < matchLength) {
+        return false;
+      }
+      uint8_t * pMatch = _pDst + position - kOffset;
+      uint8_t * pOut = _pDst + position;
+      if (kOffset >= matchLength) {
+        std::memcpy(pOut, pMatch, matchLength);
+      } else {
+        // Overlapping match repeats the last kOffset bytes
+        for (size_t i = 0; i < matchLength; ++i) {
+          pOut[i] = pMatch[i];
+        }
+      }
+      position += matchLength;
+    }
+    return position == _dstSize;
+  }
+
+ private:
+  static uint32_t load(uint8_t const * _pSrc) {
+    uint32_t result;
+    std::memcpy(&result, _pSrc, sizeof(result));
+    return result;
+  }
+
+  static uint32_t hash(const uint32_t _sequence) {
+    return (_sequence * 2654435761u) >> (32 - kHashBits);
+  }
+
+  static uint8_t * putLength(uint8_t * _pDst, size_t _length) {
+    for (; _length >= 255; _length -= 255) {
+      *_pDst++ = 255;
+    }
+    *_pDst++ = static_cast<uint8_t>(_length);
+    return _pDst;
+  }
+
+  static bool getLength(uint8_t const * & _pSrc, uint8_t const * const _pSrcEnd, size_t & _length) {
+    if (_length == 15) {
+      uint8_t byte = 255;
+      while (byte == 255) {
+        if (_pSrc == _pSrcEnd) {
+          return false;
+        }
+        byte = *_pSrc++;
+        _length += byte;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Method for writing of sequence, match with zero length is not written
+   * @return End of written sequence or nullptr if it does not fit
+   */
+  static uint8_t * putSequence(uint8_t * _pDst, uint8_t * const _pDstEnd, uint8_t const * _pLiterals,
+                               const size_t _literalsLength, const size_t _offset, const size_t _matchLength) {
+    const size_t kMatchCode = (_matchLength > 0) ? (_matchLength - kMinMatch) : 0;
+    // Token, length bytes, literals and offset
+    const size_t kMaxSize = 1 + (_literalsLength / 255 + 1) + _literalsLength + 2 + (kMatchCode / 255 + 1);
+    if (static_cast<size_t>(_pDstEnd - _pDst) < kMaxSize) {
+      return nullptr;
+    }
+    const size_t kLiteralsNibble = (_literalsLength < 15) ? _literalsLength : 15;
+    const size_t kMatchNibble = (kMatchCode < 15) ? kMatchCode : 15;
+    *_pDst++ = static_cast<uint8_t>((kLiteralsNibble << 4) | kMatchNibble);
+    if (kLiteralsNibble == 15) {
+      _pDst = putLength(_pDst, _literalsLength - 15);
+    }
+    std::memcpy(_pDst, _pLiterals, _literalsLength);
+    _pDst += _literalsLength;
+    if (_matchLength > 0) {
+      *_pDst++ = static_cast<uint8_t>(_offset);
+      *_pDst++ = static_cast<uint8_t>(_offset >> 8);
+      if (kMatchNibble == 15) {
+        _pDst = putLength(_pDst, kMatchCode - 15);
+      }
+    }
+    return _pDst;
+  }
+
+  std::vector<uint32_t> table_;
+};
+
+/**
+ * Framed compressed buffer:
+ *     magic | block size | decompressed size | blocks
+ * every block is uint32_t header with size of compressed block and kStoredFlag if block is stored
+ * uncompressed, all blocks except of the last one have block size bytes after decompression
+ */
+struct CompressedFormat {
+  static constexpr uint32_t kMagic = 0x5A425550;
+  static constexpr uint32_t kStoredFlag = 0x80000000u;
+  static constexpr size_t kHeaderSize = 2 * sizeof(uint32_t) + sizeof(uint64_t);
+  static constexpr size_t kBlockHeaderSize = sizeof(uint32_t);
+  static constexpr size_t kDefaultBlockSize = 64 * 1024;
+  static constexpr size_t kMaxBlockSize = 64 * 1024 * 1024;
+
+  static size_t getMaxCompressedSize(const size_t _size, const size_t _blockSize) {
+    return kHeaderSize + (_size + _blockSize - 1) / _blockSize * kBlockHeaderSize + _size;
+  }
+};
+
+/**
+ * Compressor of finished packed buffers, it could be reused for many buffers
+ */
+class BlockCompressor {
+ public:
+  explicit BlockCompressor(const size_t _blockSize = CompressedFormat::kDefaultBlockSize)
+      : block_size_{(_blockSize > 0 && _blockSize <= CompressedFormat::kMaxBlockSize)
+                    ? _blockSize : size_t{CompressedFormat::kDefaultBlockSize}} {
+  }
+
+  /**
+   * Method for compressing of data, incompressible blocks are stored as is
+   * @param _pData Data to compress
+   * @param _size Size of data
+   * @param _compressed Destination of framed compressed buffer, previous content is replaced
+   */
+  void compress(uint8_t const * _pData, const size_t _size, std::vector<uint8_t> & _compressed) {
+    _compressed.resize(CompressedFormat::getMaxCompressedSize(_size, block_size_));
+    uint8_t * pDst = _compressed.data();
+    const uint32_t kHeader[] = {CompressedFormat::kMagic, static_cast<uint32_t>(block_size_)};
+    const uint64_t kSize = _size;
+    std::memcpy(pDst, kHeader, sizeof(kHeader));
+    std::memcpy(pDst + sizeof(kHeader), &kSize, sizeof(kSize));
+    pDst += CompressedFormat::kHeaderSize;
+    for (size_t offset = 0; offset < _size; offset += block_size_) {
+      const size_t kBlockSize = (_size - offset < block_size_) ? (_size - offset) : block_size_;
+      uint8_t * const pBlock = pDst + CompressedFormat::kBlockHeaderSize;
+      size_t compressedSize = lz77_.compress(_pData + offset, kBlockSize, pBlock, kBlockSize - 1);
+      uint32_t blockHeader = static_cast<uint32_t>(compressedSize);
+      if (compressedSize == 0) {
+        std::memcpy(pBlock, _pData + offset, kBlockSize);
+        compressedSize = kBlockSize;
+        blockHeader = static_cast<uint32_t>(kBlockSize) | CompressedFormat::kStoredFlag;
+      }
+      std::memcpy(pDst, &blockHeader, sizeof(blockHeader));
+      pDst = pBlock + compressedSize;
+    }
+    _compressed.resize(static_cast<size_t>(pDst - _compressed.data()));
+  }
+
+  void compress(const PackBuffer & _buffer, std::vector<uint8_t> & _compressed) {
+    compress(_buffer.getData(), _buffer.getDataSize(), _compressed);
+  }
+
+  size_t getBlockSize() const {
+    return block_size_;
+  }
+
+ private:
+  const size_t block_size_;
+  Lz77 lz77_;
+};
+
+/**
+ * Streaming decompressor, every block is decompressed separately,
+ * so memory of one block is enough for reading of any size:
+ *     std::vector<uint8_t> block(decompressor.getBlockSize());
+ *     size_t size = 0;
+ *     while (decompressor.next(block.data(), size)) { ... }
+ */
+class BlockDecompressor {
+ public:
+  BlockDecompressor(uint8_t const * _pData, const size_t _size)
+      : p_data_{_pData}
+      , p_end_{_pData + _size}
+      , block_size_{0}
+      , decompressed_size_{0}
+      , offset_{0}
+      , is_corrupted_{false} {
+    uint32_t header[2] = {0, 0};
+    uint64_t decompressedSize = 0;
+    if (_size >= CompressedFormat::kHeaderSize) {
+      std::memcpy(header, _pData, sizeof(header));
+      std::memcpy(&decompressedSize, _pData + sizeof(header), sizeof(decompressedSize));
+    }
+    // Every block takes at least its header, so decompressed size is bounded by size of data
+    const size_t kMaxBlocksCount = (_size >= CompressedFormat::kHeaderSize)
+                                   ? (_size - CompressedFormat::kHeaderSize) / CompressedFormat::kBlockHeaderSize : 0;
+    is_corrupted_ = header[0] != CompressedFormat::kMagic || header[1] == 0 ||
+                    header[1] > CompressedFormat::kMaxBlockSize ||
+                    decompressedSize / header[1] + (decompressedSize % header[1] != 0) > kMaxBlocksCount;
+    if (!is_corrupted_) {
+      block_size_ = header[1];
+      decompressed_size_ = static_cast<size_t>(decompressedSize);
+      p_data_ += CompressedFormat::kHeaderSize;
+    }
+  }
+
+  /**
+   * Method for decompressing of the next block
+   * @param _pBlock Destination of at least getBlockSize() bytes
+   * @param _size Size of decompressed block
+   * @return Return true if block is decompressed, false at the end of data or if data is corrupted
+   */
+  bool next(uint8_t * _pBlock, size_t & _size) {
+    bool result = false;
+    if (!is_corrupted_ && offset_ < decompressed_size_) {
+      const size_t kBlockSize = (decompressed_size_ - offset_ < block_size_)
+                                ? (decompressed_size_ - offset_) : block_size_;
+      uint32_t blockHeader = 0;
+      if (static_cast<size_t>(p_end_ - p_data_) >= CompressedFormat::kBlockHeaderSize) {
+        std::memcpy(&blockHeader, p_data_, sizeof(blockHeader));
+        p_data_ += CompressedFormat::kBlockHeaderSize;
+        const size_t kCompressedSize = blockHeader & ~CompressedFormat::kStoredFlag;
+        if (kCompressedSize <= static_cast<size_t>(p_end_ - p_data_)) {
+          if ((blockHeader & CompressedFormat::kStoredFlag) != 0) {
+            result = kCompressedSize == kBlockSize;
+            if (result) {
+              std::memcpy(_pBlock, p_data_, kBlockSize);
+            }
+          } else {
+            result = Lz77::decompress(p_data_, kCompressedSize, _pBlock, kBlockSize);
+          }
+          p_data_ += kCompressedSize;
+        }
+      }
+      is_corrupted_ = !result;
+      if (result) {
+        offset_ += kBlockSize;
+        _size = kBlockSize;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for checking whether all blocks were decompressed successfully
+   */
+  bool isFinished() const {
+    return !is_corrupted_ && offset_ == decompressed_size_;
+  }
+
+  bool isCorrupted() const {
+    return is_corrupted_;
+  }
+
+  size_t getBlockSize() const {
+    return block_size_;
+  }
+
+  size_t getDecompressedSize() const {
+    return decompressed_size_;
+  }
+
+ private:
+  uint8_t const * p_data_;
+  uint8_t const * const p_end_;
+  size_t block_size_;
+  size_t decompressed_size_;
+  size_t offset_;
+  bool is_corrupted_;
+};
+
+/**
+ * Unpack buffer which decompresses framed compressed buffer to its own memory,
+ * then data is unpacked like from the original PackBuffer
+ */
+class DecompressedUnpackBuffer
+    : public UnpackBuffer {
+ public:
+  /**
+   * Constructor which decompresses data
+   * @param _pData Framed compressed buffer
+   * @param _size Size of compressed buffer
+   * @param _alignment Alignment of packed data
+   */
+  DecompressedUnpackBuffer(uint8_t const * _pData, const size_t _size,
+                           AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : UnpackBuffer(nullptr, 0, _alignment)
+      , is_open_{false} {
+    BlockDecompressor decompressor(_pData, _size);
+    if (!decompressor.isCorrupted()) {
+      // Memory grows with decompressed blocks, so corrupted size in header does not allocate it at once
+      size_t offset = 0;
+      size_t blockSize = 0;
+      bool result = true;
+      while (result && offset < decompressor.getDecompressedSize()) {
+        storage_.resize(offset + std::min(decompressor.getDecompressedSize() - offset, decompressor.getBlockSize()));
+        result = decompressor.next(storage_.data() + offset, blockSize);
+        offset += blockSize;
+      }
+      is_open_ = decompressor.isFinished();
+    }
+    if (is_open_) {
+      rebind(storage_.data(), storage_.size());
+    } else {
+      storage_.clear();
+#ifdef __cpp_exceptions
+      throw std::out_of_range("Compressed buffer is corrupted !!");
+#endif
+    }
+  }
+
+  explicit DecompressedUnpackBuffer(const std::vector<uint8_t> & _compressed,
+                                    AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : DecompressedUnpackBuffer(_compressed.data(), _compressed.size(), _alignment) {
+  }
+
+  DecompressedUnpackBuffer(const DecompressedUnpackBuffer&) = delete;
+  DecompressedUnpackBuffer& operator=(const DecompressedUnpackBuffer&) = delete;
+
+  /**
+   * Method for checking if data was successfully decompressed
+   * @return Return true if data is decompressed, false otherwise
+   */
+  bool isOpen() const {
+    return is_open_;
+  }
+
+ private:
+  std::vector<uint8_t> storage_;
+  bool is_open_;
+};
+}
+
+#endif //BUFFERS_BLOCKCOMPRESSION_HPP
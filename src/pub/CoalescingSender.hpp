@@ -0,0 +1,356 @@
+/**
+ * @file CoalescingSender.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains sender which coalesces packed buffers into writev/sendmmsg batches
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_COALESCINGSENDER_HPP
+#define BUFFERS_COALESCINGSENDER_HPP
+
+#include <stdint.h>
+#include <cerrno>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include "PackBuffer.hpp"
+#include "Frame.hpp"
+#include "FrozenMessage.hpp"
+
+namespace buffers {
+/**
+ * Sender which collects packed buffers and flushes them with one writev (stream sockets)
+ * or sendmmsg (datagram sockets). Flush happens when byte threshold, count threshold
+ * or latency deadline is reached, whichever comes first.
+ * On stream sockets every message is prefixed by frame header, so receiver could use FrameReader
+ */
+class CoalescingSender {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Options {
+    Options()
+        : max_bytes{64 * 1024}
+        , max_messages{64}
+        , max_delay{100}
+        , framed{true} {
+    }
+
+    size_t max_bytes;
+    size_t max_messages;
+    std::chrono::microseconds max_delay;
+    bool framed;
+  };
+
+  struct Statistics {
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    uint64_t syscalls = 0;
+    uint64_t flushes = 0;
+    uint64_t flushes_by_bytes = 0;
+    uint64_t flushes_by_count = 0;
+    uint64_t flushes_by_deadline = 0;
+    uint64_t flushes_by_request = 0;
+    uint64_t partial_writes = 0;
+    uint64_t errors = 0;
+  };
+
+  /**
+   * Constructor of coalescing sender
+   * @param _fd Socket (or any file descriptor for stream mode) to write to, not owned
+   * @param _options Flush thresholds
+   */
+  explicit CoalescingSender(const int _fd, const Options & _options = Options())
+      : fd_{_fd}
+      , options_(_options)
+      , is_datagram_{false}
+      , is_socket_{false}
+      , pending_bytes_{0}
+      , sent_offset_{0} {
+    int type = 0;
+    socklen_t typeLen = sizeof(type);
+    if (::getsockopt(fd_, SOL_SOCKET, SO_TYPE, &type, &typeLen) == 0) {
+      is_socket_ = true;
+      is_datagram_ = (type == SOCK_DGRAM || type == SOCK_SEQPACKET);
+    }
+  }
+
+  CoalescingSender(const CoalescingSender&) = delete;
+  CoalescingSender& operator=(const CoalescingSender&) = delete;
+
+  /**
+   * Method for queueing of completed buffer, buffer is not copied but owned till it is sent
+   * @param _buffer Completed packed buffer
+   * @return Return false if flush triggered by this buffer failed, true otherwise
+   */
+  bool send(std::unique_ptr<PackBuffer> _buffer) {
+    bool result = false;
+    if (_buffer) {
+      const uint8_t * const kData = _buffer->getData();
+      const size_t kSize = _buffer->getDataSize();
+      const AlignMemory kAlignment = _buffer->getAlignment();
+      result = enqueue(Message{std::move(_buffer), kData, kSize, kAlignment, 0, FrozenMessage()});
+    }
+    return result;
+  }
+
+  /**
+   * Method for queueing of frozen message, message is shared with other senders without copying
+   * @param _message Frozen message
+   * @return Return false if flush triggered by this message failed, true otherwise
+   */
+  bool send(FrozenMessage _message) {
+    bool result = false;
+    if (_message) {
+      const uint8_t * const kData = _message.getData();
+      const size_t kSize = _message.getDataSize();
+      const AlignMemory kAlignment = _message.getAlignment();
+      result = enqueue(Message{nullptr, kData, kSize, kAlignment, 0, std::move(_message)});
+    }
+    return result;
+  }
+
+  /**
+   * Method for sending all queued buffers
+   * @return Return true if everything is sent, false otherwise (errno is set)
+   */
+  bool flush() {
+    return flush(Reason::Request);
+  }
+
+  /**
+   * Method for flushing if latency deadline is reached, should be called from event loop
+   * @return Return false if flush failed, true otherwise
+   */
+  bool poll() {
+    bool result = true;
+    if (!pending_.empty() && Clock::now() >= getDeadline()) {
+      result = flush(Reason::Deadline);
+    }
+    return result;
+  }
+
+  /**
+   * Method for getting time when queued buffers should be flushed
+   * @return Deadline of the oldest queued buffer or max time point if queue is empty
+   */
+  Clock::time_point getDeadline() const {
+    return pending_.empty() ? Clock::time_point::max() : (first_enqueue_ + options_.max_delay);
+  }
+
+  /**
+   * Method for dropping of all queued buffers
+   */
+  void clear() {
+    pending_.clear();
+    pending_bytes_ = 0;
+    sent_offset_ = 0;
+  }
+
+  size_t getPendingCount() const {
+    return pending_.size();
+  }
+
+  size_t getPendingBytes() const {
+    return pending_bytes_;
+  }
+
+  const Statistics & getStatistics() const {
+    return statistics_;
+  }
+
+ private:
+  enum class Reason {
+    Bytes,
+    Count,
+    Deadline,
+    Request,
+  };
+
+  struct Message {
+    std::unique_ptr<PackBuffer> owner;
+    const uint8_t * data;
+    size_t size;
+    AlignMemory alignment;
+    uint64_t header;
+    FrozenMessage shared;
+  };
+
+  bool isFramed() const {
+    return options_.framed && !is_datagram_;
+  }
+
+  size_t getHeaderSize(const Message & _message) const {
+    return isFramed() ? FrameFormat::getHeaderSize(_message.alignment) : 0;
+  }
+
+  bool enqueue(Message && _message) {
+    if (pending_.empty()) {
+      first_enqueue_ = Clock::now();
+    }
+    if (isFramed()) {
+      FrameFormat::writeHeader(reinterpret_cast<uint8_t *>(&_message.header),
+                               _message.size, _message.alignment);
+    }
+    pending_bytes_ += getHeaderSize(_message) + _message.size;
+    pending_.push_back(std::move(_message));
+
+    bool result = true;
+    if (pending_bytes_ >= options_.max_bytes) {
+      result = flush(Reason::Bytes);
+    } else if (pending_.size() >= options_.max_messages) {
+      result = flush(Reason::Count);
+    } else if (options_.max_delay.count() <= 0 || Clock::now() >= getDeadline()) {
+      result = flush(Reason::Deadline);
+    }
+    return result;
+  }
+
+  bool flush(const Reason _reason) {
+    bool result = true;
+    if (!pending_.empty()) {
+      const uint64_t kBytes = pending_bytes_ - sent_offset_;
+      const uint64_t kMessages = pending_.size();
+      result = is_datagram_ ? flushDatagrams() : flushStream();
+      if (result) {
+        ++statistics_.flushes;
+        statistics_.messages += kMessages;
+        statistics_.bytes += kBytes;
+        switch (_reason) {
+          case Reason::Bytes: ++statistics_.flushes_by_bytes; break;
+          case Reason::Count: ++statistics_.flushes_by_count; break;
+          case Reason::Deadline: ++statistics_.flushes_by_deadline; break;
+          case Reason::Request: ++statistics_.flushes_by_request; break;
+        }
+      } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        ++statistics_.errors;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for writing of queued buffers to stream with writev, partial writes are continued,
+   * on EAGAIN unsent rest of data stays in queue
+   */
+  bool flushStream() {
+    bool result = true;
+    size_t first = 0;
+    size_t offset = sent_offset_;
+    while (result && first < pending_.size()) {
+      iovecs_.clear();
+      size_t skip = offset;
+      for (size_t i = first; i < pending_.size() && iovecs_.size() + 2 <= kMaxIovecs; ++i) {
+        Message & message = pending_[i];
+        addIovec(reinterpret_cast<uint8_t *>(&message.header), getHeaderSize(message), skip);
+        addIovec(message.data, message.size, skip);
+      }
+      const ssize_t kWritten = write(iovecs_.data(), iovecs_.size());
+      if (kWritten < 0) {
+        result = (errno == EINTR);
+        continue;
+      }
+      offset += static_cast<size_t>(kWritten);
+      while (first < pending_.size() &&
+             offset >= getHeaderSize(pending_[first]) + pending_[first].size) {
+        offset -= getHeaderSize(pending_[first]) + pending_[first].size;
+        ++first;
+      }
+      if (first < pending_.size() && offset > 0) {
+        ++statistics_.partial_writes;
+      }
+    }
+    release(first, offset);
+    return result;
+  }
+
+  /**
+   * Method for sending every queued buffer as one datagram with sendmmsg
+   */
+  bool flushDatagrams() {
+    bool result = true;
+    size_t first = 0;
+    while (result && first < pending_.size()) {
+      const size_t kCount = (pending_.size() - first < kMaxIovecs) ? (pending_.size() - first) : kMaxIovecs;
+      iovecs_.resize(kCount);
+      headers_.resize(kCount);
+      for (size_t i = 0; i < kCount; ++i) {
+        iovecs_[i].iov_base = const_cast<uint8_t *>(pending_[first + i].data);
+        iovecs_[i].iov_len = pending_[first + i].size;
+        headers_[i] = mmsghdr{};
+        headers_[i].msg_hdr.msg_iov = &iovecs_[i];
+        headers_[i].msg_hdr.msg_iovlen = 1;
+      }
+      ++statistics_.syscalls;
+      const int kSent = ::sendmmsg(fd_, headers_.data(), static_cast<unsigned int>(kCount), MSG_NOSIGNAL);
+      if (kSent < 0) {
+        result = (errno == EINTR);
+      } else {
+        first += static_cast<size_t>(kSent);
+      }
+    }
+    release(first, 0);
+    return result;
+  }
+
+  void addIovec(const uint8_t * _pData, const size_t _size, size_t & _skip) {
+    if (_skip >= _size) {
+      _skip -= _size;
+    } else {
+      iovecs_.push_back(iovec{const_cast<uint8_t *>(_pData) + _skip, _size - _skip});
+      _skip = 0;
+    }
+  }
+
+  ssize_t write(const iovec * _iov, const size_t _count) {
+    ++statistics_.syscalls;
+    ssize_t result;
+    if (is_socket_) {
+      msghdr msg{};
+      msg.msg_iov = const_cast<iovec *>(_iov);
+      msg.msg_iovlen = _count;
+      result = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+    } else {
+      result = ::writev(fd_, _iov, static_cast<int>(_count));
+    }
+    return result;
+  }
+
+  /**
+   * Method for releasing of sent buffers
+   * @param _count Number of completely sent buffers
+   * @param _offset Number of sent bytes of the first unsent buffer
+   */
+  void release(const size_t _count, const size_t _offset) {
+    for (size_t i = 0; i < _count; ++i) {
+      pending_bytes_ -= getHeaderSize(pending_[i]) + pending_[i].size;
+    }
+    pending_.erase(pending_.begin(), pending_.begin() + _count);
+    sent_offset_ = _offset;
+    if (_count > 0 && !pending_.empty()) {
+      first_enqueue_ = Clock::now();
+    }
+  }
+
+  static constexpr size_t kMaxIovecs = 1024;
+
+  const int fd_;
+  const Options options_;
+  bool is_datagram_;
+  bool is_socket_;
+  std::vector<Message> pending_;
+  size_t pending_bytes_;
+  size_t sent_offset_;
+  Clock::time_point first_enqueue_;
+  Statistics statistics_;
+  std::vector<iovec> iovecs_;
+  std::vector<mmsghdr> headers_;
+};
+}
+
+#endif //BUFFERS_COALESCINGSENDER_HPP
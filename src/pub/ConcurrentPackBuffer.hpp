@@ -0,0 +1,231 @@
+/**
+ * @file ConcurrentPackBuffer.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains append buffer for packing of records by many threads concurrently
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_CONCURRENTPACKBUFFER_HPP
+#define BUFFERS_CONCURRENTPACKBUFFER_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "RecordWriter.hpp"
+
+namespace buffers {
+/**
+ * Fixed size append buffer shared by many writer threads.
+ * Writer reserves space for record with one atomic fetch-add and packs to it without locks.
+ * Every record starts with 64-bit header which is zero till commit:
+ *     record size (high 32 bits) | payload size or abort marker (low 32 bits)
+ * Readers see only committed prefix of records, aborted records are skipped
+ */
+class ConcurrentPackBuffer {
+ public:
+  /**
+   * Buffer of one writer thread, packs one record directly to the shared buffer
+   */
+  using Writer = RecordWriter<ConcurrentPackBuffer>;
+
+  /**
+   * Iterator over committed records, stops on the first record which is not committed yet
+   */
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = UnpackBuffer;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = UnpackBuffer;
+
+    Iterator(const ConcurrentPackBuffer * _buffer, const size_t _offset)
+        : buffer_{_buffer}
+        , offset_{_offset} {
+      skipAborted();
+    }
+
+    UnpackBuffer operator*() const {
+      const uint64_t kHeader = buffer_->header(offset_).load(std::memory_order_acquire);
+      return UnpackBuffer(buffer_->data() + offset_ + kHeaderSize,
+                          static_cast<uint32_t>(kHeader),
+                          buffer_->alignment_);
+    }
+
+    Iterator & operator++() {
+      offset_ = buffer_->next(offset_);
+      skipAborted();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator result = *this;
+      ++(*this);
+      return result;
+    }
+
+    bool operator==(const Iterator & _other) const {
+      return offset_ == _other.offset_;
+    }
+
+    bool operator!=(const Iterator & _other) const {
+      return !(*this == _other);
+    }
+
+    /**
+     * Method for getting of offset of current record from the beginning of buffer
+     */
+    size_t offset() const {
+      return offset_;
+    }
+
+   private:
+    void skipAborted() {
+      while (offset_ != kNoRecord &&
+             static_cast<uint32_t>(buffer_->header(offset_).load(std::memory_order_acquire)) == kAbortMarker) {
+        offset_ = buffer_->next(offset_);
+      }
+    }
+
+    const ConcurrentPackBuffer * buffer_;
+    size_t offset_;
+  };
+
+  /**
+   * Constructor of concurrent buffer
+   * @param _capacity Capacity in bytes, rounded up to 8 bytes
+   * @param _alignment Alignment of packed data
+   */
+  explicit ConcurrentPackBuffer(const size_t _capacity,
+                                AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : capacity_{(_capacity + kHeaderSize - 1) / kHeaderSize * kHeaderSize}
+      , alignment_{_alignment}
+      , storage_(new uint64_t[capacity_ / sizeof(uint64_t)]())
+      , reserved_{0} {
+  }
+
+  ConcurrentPackBuffer(const ConcurrentPackBuffer&) = delete;
+  ConcurrentPackBuffer& operator=(const ConcurrentPackBuffer&) = delete;
+
+  /**
+   * Method for packing of one value as record, could be called by many threads concurrently.
+   * Type T should provide getTypeSize(), otherwise use Writer with known size
+   * @tparam T Type of value
+   * @param _t Value for packing
+   * @return Return true if value is committed, false if buffer is full
+   */
+  template <typename T>
+  bool append(const T & _t) {
+    return Writer::push(*this, _t);
+  }
+
+  Iterator begin() const {
+    return Iterator(this, isVisible(0) ? 0 : kNoRecord);
+  }
+
+  Iterator end() const {
+    return Iterator(this, kNoRecord);
+  }
+
+  /**
+   * Method for getting of size of committed prefix of records
+   * @return Size in bytes from the beginning of buffer till the first not committed record
+   */
+  size_t getCommittedSize() const {
+    size_t offset = 0;
+    while (isVisible(offset)) {
+      offset += static_cast<size_t>(header(offset).load(std::memory_order_acquire) >> 32);
+    }
+    return offset;
+  }
+
+  /**
+   * Method for getting of size of reserved space, limited by capacity after overflow
+   */
+  size_t getReservedSize() const {
+    const size_t kReserved = reserved_.load(std::memory_order_acquire);
+    return (kReserved < capacity_) ? kReserved : capacity_;
+  }
+
+  /**
+   * Method for checking if all reserved records are committed or aborted
+   */
+  bool isComplete() const {
+    return getCommittedSize() == getReservedSize();
+  }
+
+  size_t getCapacity() const {
+    return capacity_;
+  }
+
+  AlignMemory getAlignment() const {
+    return alignment_;
+  }
+
+  /**
+   * Method for clearing of buffer, should be called only when there are no active writers
+   */
+  void clear() {
+    std::memset(data(), 0, getReservedSize());
+    reserved_.store(0, std::memory_order_release);
+  }
+
+ private:
+  friend Writer;
+
+  static constexpr size_t kHeaderSize = RecordFormat::kHeaderSize;
+  static constexpr size_t kAbortMarker = RecordFormat::kSkipMarker;
+  static constexpr size_t kNoRecord = RecordFormat::kNoRecord;
+
+  uint8_t * data() const {
+    return reinterpret_cast<uint8_t *>(storage_.get());
+  }
+
+  std::atomic<uint64_t> & header(const size_t _offset) const {
+    return *reinterpret_cast<std::atomic<uint64_t> *>(data() + _offset);
+  }
+
+  bool isVisible(const size_t _offset) const {
+    return _offset < capacity_ && header(_offset).load(std::memory_order_acquire) != 0;
+  }
+
+  size_t next(const size_t _offset) const {
+    const size_t kNext = _offset + static_cast<size_t>(header(_offset).load(std::memory_order_acquire) >> 32);
+    return isVisible(kNext) ? kNext : kNoRecord;
+  }
+
+  /**
+   * Method for reservation of record by fetch-add, reservation crossing the end of buffer
+   * is aborted, so readers could pass it
+   * @return Offset of reserved record or kNoRecord if buffer is full
+   */
+  size_t reserve(const size_t _recordSize) {
+    size_t result = reserved_.fetch_add(_recordSize, std::memory_order_relaxed);
+    if (result + _recordSize > capacity_) {
+      if (result < capacity_) {
+        publish(result, capacity_ - result, kAbortMarker);
+      }
+      result = kNoRecord;
+    }
+    return result;
+  }
+
+  void publish(const size_t _offset, const size_t _recordSize, const size_t _payloadSize) {
+    const uint64_t kHeader = (static_cast<uint64_t>(_recordSize) << 32) | static_cast<uint32_t>(_payloadSize);
+    header(_offset).store(kHeader, std::memory_order_release);
+  }
+
+  const size_t capacity_;
+  const AlignMemory alignment_;
+  std::unique_ptr<uint64_t[]> storage_;
+  std::atomic<size_t> reserved_;
+};
+}
+
+#endif //BUFFERS_CONCURRENTPACKBUFFER_HPP
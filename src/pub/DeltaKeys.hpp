@@ -0,0 +1,298 @@
+/**
+ * @file DeltaKeys.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains delta + varint encoding of integer keys of sorted std::set and std::map
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_DELTAKEYS_HPP
+#define BUFFERS_DELTAKEYS_HPP
+
+#include <stdint.h>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "Varint.hpp"
+
+namespace buffers {
+/**
+ * std::set which is packed with delta encoded keys, layout:
+ *     count | size of keys | first key, delta, delta, ... (varints) | padding
+ * @tparam K Integer type of key
+ */
+template <typename K>
+class DeltaSet : public std::set<K> {
+ public:
+  using std::set<K>::set;
+
+  DeltaSet() = default;
+
+  DeltaSet(const std::set<K> & _set)
+      : std::set<K>(_set) {
+  }
+
+  DeltaSet(std::set<K> && _set)
+      : std::set<K>(std::move(_set)) {
+  }
+};
+
+/**
+ * std::map which is packed with delta encoded keys, values are packed as usual after keys:
+ *     count | size of keys | first key, delta, delta, ... (varints) | padding | value | value | ...
+ * @tparam K Integer type of key
+ * @tparam V Type of value
+ */
+template <typename K, typename V>
+class DeltaMap : public std::map<K, V> {
+ public:
+  using std::map<K, V>::map;
+
+  DeltaMap() = default;
+
+  DeltaMap(const std::map<K, V> & _map)
+      : std::map<K, V>(_map) {
+  }
+
+  DeltaMap(std::map<K, V> && _map)
+      : std::map<K, V>(std::move(_map)) {
+  }
+};
+
+/**
+ * Wrapper for packing of existing std::set or std::map with delta encoded keys without copying:
+ *     buffer.put(buffers::deltaKeys(ids));
+ * Packed data is unpacked as DeltaSet or DeltaMap
+ */
+template <typename C>
+struct DeltaKeysView {
+  explicit DeltaKeysView(const C & _container)
+      : container(_container) {
+  }
+
+  const C & container;
+};
+
+template <typename C>
+DeltaKeysView<C> deltaKeys(const C & _container) {
+  return DeltaKeysView<C>(_container);
+}
+
+/**
+ * Encoding of sorted keys: the first key as varint (zigzag for signed keys) and differences
+ * between consecutive keys as varints. Keys of std::set and std::map are strictly increasing,
+ * so differences are positive and dense keys take one byte
+ */
+struct DeltaKeysFormat {
+  using SizeType = size_t;
+
+  template <typename TBufferContext, typename C>
+  static bool put(TBufferContext & _ctx, const C & _container) {
+    using Key = typename C::key_type;
+    static_assert(std::is_integral<Key>::value && !std::is_same<Key, bool>::value,
+                  "Delta encoding supports only integer keys !!");
+    bool result = false;
+    const size_t kHeaderSize = 2 * getAlignedSize(sizeof(SizeType), _ctx.alignment());
+    if (kHeaderSize <= _ctx.buffer_size()) {
+      uint8_t * const pKeys = _ctx.buffer() + kHeaderSize;
+      uint8_t * const pKeysEnd = putKeys(_container, pKeys, _ctx.buffer() + _ctx.buffer_size());
+      const size_t kKeysSize = pKeysEnd ? static_cast<size_t>(pKeysEnd - pKeys) : 0;
+      if (pKeysEnd && kHeaderSize + getAlignedSize(kKeysSize, _ctx.alignment()) <= _ctx.buffer_size()) {
+        PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, _container.size());
+        PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, kKeysSize);
+        _ctx += kKeysSize;
+        result = true;
+        for (auto it = _container.begin(); result && it != _container.end(); ++it) {
+          result = putValue(_ctx, *it);
+        }
+      }
+    }
+    return result;
+  }
+
+  template <typename C>
+  static size_t getTypeSize(const C & _container) {
+    size_t result = 2 * sizeof(SizeType);
+    bool isFirst = true;
+    typename UnsignedKey<C>::type previous = 0;
+    for (auto & element : _container) {
+      result += Varint::getSize(encodeKey(getKey(element), previous, isFirst)) + getValueSize(element);
+    }
+    return result;
+  }
+
+  template <typename TBufferContext, typename C>
+  static C get(TBufferContext & _ctx) {
+    using Key = typename C::key_type;
+    C result;
+    const SizeType kCount = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    const SizeType kKeysSize = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    if (kKeysSize > _ctx.buffer_size()) {
+#ifdef __cpp_exceptions
+      throw std::out_of_range("Delta encoded keys are out of buffer !!");
+#else
+      return result;
+#endif
+    }
+    uint8_t const * pKeys = _ctx.buffer();
+    uint8_t const * const pKeysEnd = pKeys + kKeysSize;
+    _ctx += kKeysSize;
+    typename UnsignedKey<C>::type previous = 0;
+    for (SizeType i = 0; i < kCount; ++i) {
+      uint64_t value = 0;
+      pKeys = Varint::decode(pKeys, pKeysEnd, value);
+      if (pKeys == nullptr) {
+#ifdef __cpp_exceptions
+        throw std::out_of_range("Delta encoded key is truncated !!");
+#else
+        break;
+#endif
+      }
+      previous = (i == 0) ? static_cast<typename UnsignedKey<C>::type>(Varint::fromUnsigned<Key>(value))
+                          : static_cast<typename UnsignedKey<C>::type>(previous + value);
+      emplaceBack(_ctx, result, static_cast<Key>(previous));
+    }
+    return result;
+  }
+
+ private:
+  template <typename C>
+  struct UnsignedKey {
+    using type = typename std::make_unsigned<typename C::key_type>::type;
+  };
+
+  template <typename K>
+  static const K & getKey(const K & _key) {
+    return _key;
+  }
+
+  template <typename K, typename V>
+  static const K & getKey(const std::pair<const K, V> & _entry) {
+    return _entry.first;
+  }
+
+  /**
+   * Method for mapping of key to value of varint, previous key is updated
+   */
+  template <typename K, typename U>
+  static uint64_t encodeKey(const K _key, U & _previous, bool & _isFirst) {
+    const uint64_t kResult = _isFirst ? Varint::toUnsigned(_key)
+                                      : static_cast<uint64_t>(static_cast<U>(static_cast<U>(_key) - _previous));
+    _previous = static_cast<U>(_key);
+    _isFirst = false;
+    return kResult;
+  }
+
+  /**
+   * Method for writing of keys till end of buffer
+   * @return Pointer after the last key or nullptr if keys do not fit
+   */
+  template <typename C>
+  static uint8_t * putKeys(const C & _container, uint8_t * _pDst, uint8_t * const _pEnd) {
+    bool isFirst = true;
+    typename UnsignedKey<C>::type previous = 0;
+    for (auto & element : _container) {
+      const uint64_t kValue = encodeKey(getKey(element), previous, isFirst);
+      const size_t kLeft = static_cast<size_t>(_pEnd - _pDst);
+      if (kLeft < Varint::kMaxSize && Varint::getSize(kValue) > kLeft) {
+        return nullptr;
+      }
+      _pDst = Varint::encode(kValue, _pDst);
+    }
+    return _pDst;
+  }
+
+  template <typename TBufferContext, typename K>
+  static bool putValue(TBufferContext &, const K &) {
+    return true;
+  }
+
+  template <typename TBufferContext, typename K, typename V>
+  static bool putValue(TBufferContext & _ctx, const std::pair<const K, V> & _entry) {
+    return PackBuffer::DelegatePackBuffer<V>{}.put(_ctx, _entry.second);
+  }
+
+  template <typename K>
+  static size_t getValueSize(const K &) {
+    return 0;
+  }
+
+  template <typename K, typename V>
+  static size_t getValueSize(const std::pair<const K, V> & _entry) {
+    return PackBuffer::DelegatePackBuffer<V>{}.getTypeSize(_entry.second);
+  }
+
+  template <typename TBufferContext, typename K>
+  static void emplaceBack(TBufferContext &, std::set<K> & _set, const K _key) {
+    _set.emplace_hint(_set.end(), _key);
+  }
+
+  template <typename TBufferContext, typename K, typename V>
+  static void emplaceBack(TBufferContext & _ctx, std::map<K, V> & _map, const K _key) {
+    _map.emplace_hint(_map.end(), _key, UnpackBuffer::DelegateUnpackBuffer<V>{}.get(_ctx));
+  }
+};
+
+template <typename K>
+class PackBuffer::DelegatePackBuffer<DeltaSet<K>> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const DeltaSet<K> & _set) {
+    return DeltaKeysFormat::put(_ctx, _set);
+  }
+
+  static size_t getTypeSize(const DeltaSet<K> & _set) {
+    return DeltaKeysFormat::getTypeSize(_set);
+  }
+};
+
+template <typename K, typename V>
+class PackBuffer::DelegatePackBuffer<DeltaMap<K, V>> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const DeltaMap<K, V> & _map) {
+    return DeltaKeysFormat::put(_ctx, _map);
+  }
+
+  static size_t getTypeSize(const DeltaMap<K, V> & _map) {
+    return DeltaKeysFormat::getTypeSize(_map);
+  }
+};
+
+template <typename C>
+class PackBuffer::DelegatePackBuffer<DeltaKeysView<C>> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const DeltaKeysView<C> & _view) {
+    return DeltaKeysFormat::put(_ctx, _view.container);
+  }
+
+  static size_t getTypeSize(const DeltaKeysView<C> & _view) {
+    return DeltaKeysFormat::getTypeSize(_view.container);
+  }
+};
+
+template <typename K>
+class UnpackBuffer::DelegateUnpackBuffer<DeltaSet<K>> {
+ public:
+  template <typename TBufferContext>
+  static DeltaSet<K> get(TBufferContext & _ctx) {
+    return DeltaSet<K>(DeltaKeysFormat::get<TBufferContext, std::set<K>>(_ctx));
+  }
+};
+
+template <typename K, typename V>
+class UnpackBuffer::DelegateUnpackBuffer<DeltaMap<K, V>> {
+ public:
+  template <typename TBufferContext>
+  static DeltaMap<K, V> get(TBufferContext & _ctx) {
+    return DeltaMap<K, V>(DeltaKeysFormat::get<TBufferContext, std::map<K, V>>(_ctx));
+  }
+};
+}
+
+#endif //BUFFERS_DELTAKEYS_HPP
@@ -0,0 +1,499 @@
+/**
+ * @file DeltaSnapshot.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains delta encoding of message against the previous snapshot sent on channel
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_DELTASNAPSHOT_HPP
+#define BUFFERS_DELTASNAPSHOT_HPP
+
+#include <stdint.h>
+#include <array>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "StructFields.hpp"
+
+namespace buffers {
+/**
+ * Every encoded difference is sequence of uint32_t and values packed with PackBuffer:
+ *     message: flags | difference of root value
+ *     flags: sequence number of message in channel (high 31 bits) | key frame (low bit)
+ *     struct: number of changed fields | (field index | difference of field) ...
+ *     std::array: number of changed elements | (index | difference of element) ...
+ *     std::vector: size | number of changed elements | (index | difference of element) ... |
+ *                  difference of every appended element against default value
+ *     std::map: number of removed keys | key ... | number of upserted keys |
+ *               (key | difference against old or default value) ...
+ *     other value: value
+ * Indexes are strictly increasing. Key frame is difference against default constructed message.
+ * Sequence number wraps around and lets decoder detect missed message
+ */
+struct DeltaFormat {
+  using Index = uint32_t;
+
+  static constexpr uint32_t kKeyFrame = 1;
+  static constexpr uint32_t kSequenceShift = 1;
+  static constexpr uint32_t kSequenceMask = 0x7FFFFFFF;
+};
+
+/**
+ * Codec of difference between two values of the same type
+ * @tparam T Type of value
+ */
+template <typename T, typename = void>
+struct DeltaCodec {
+  static bool isEqual(const T & _previous, const T & _current) {
+    return isEqualValue(_previous, _current, 0);
+  }
+
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const T &, const T & _current) {
+    return PackBuffer::DelegatePackBuffer<T>{}.put(_ctx, _current);
+  }
+
+  static bool apply(UnpackBuffer & _buffer, T & _value) {
+    _value = _buffer.get<T>();
+    return true;
+  }
+
+ private:
+  // Trivially copyable values are compared bitwise, so NaN is not resent and -0.0 is not lost
+  template <typename U>
+  static auto isEqualValue(const U & _previous, const U & _current, int)
+      -> typename std::enable_if<std::is_trivially_copyable<U>::value, bool>::type {
+    return std::memcmp(&_previous, &_current, sizeof(U)) == 0;
+  }
+
+  template <typename U>
+  static bool isEqualValue(const U & _previous, const U & _current, long) {
+    return _previous == _current;
+  }
+};
+
+/**
+ * Helpers for packing of indexes and changed elements of arrays
+ */
+struct DeltaElements {
+  template <typename TBufferContext>
+  static bool putIndex(TBufferContext & _ctx, const size_t _index) {
+    return PackBuffer::DelegatePackBuffer<DeltaFormat::Index>{}.put(_ctx, static_cast<DeltaFormat::Index>(_index));
+  }
+
+  /**
+   * Method for packing of number of changed elements followed by changed elements
+   */
+  template <typename TBufferContext, typename E>
+  static bool put(TBufferContext & _ctx, E const * _pPrevious, E const * _pCurrent, const size_t _size) {
+    // Number of changes is written after they are counted
+    uint8_t * const pCount = _ctx.buffer();
+    bool result = putIndex(_ctx, 0);
+    DeltaFormat::Index count = 0;
+    for (size_t i = 0; result && i < _size; ++i) {
+      if (!DeltaCodec<E>::isEqual(_pPrevious[i], _pCurrent[i])) {
+        result = putIndex(_ctx, i) && DeltaCodec<E>::put(_ctx, _pPrevious[i], _pCurrent[i]);
+        ++count;
+      }
+    }
+    if (result) {
+      std::memcpy(pCount, &count, sizeof(count));
+    }
+    return result;
+  }
+
+  template <typename E>
+  static bool apply(UnpackBuffer & _buffer, E * _pValues, const size_t _size) {
+    const size_t kCount = _buffer.get<DeltaFormat::Index>();
+    bool result = kCount <= _size;
+    size_t next = 0;
+    for (size_t i = 0; result && i < kCount; ++i) {
+      const size_t kIndex = _buffer.get<DeltaFormat::Index>();
+      result = kIndex >= next && kIndex < _size && DeltaCodec<E>::apply(_buffer, _pValues[kIndex]);
+      next = kIndex + 1;
+    }
+    return result;
+  }
+};
+
+/**
+ * Field-wise codec of struct registered with StructFields
+ */
+template <typename T>
+struct DeltaCodec<T, typename std::enable_if<HasStructFields<T>::value>::type> {
+  static bool isEqual(const T & _previous, const T & _current) {
+    EqualVisitor visitor{_previous, _current, true};
+    StructFields<T>::visit(visitor);
+    return visitor.result;
+  }
+
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const T & _previous, const T & _current) {
+    uint8_t * const pCount = _ctx.buffer();
+    PutVisitor<TBufferContext> visitor{_ctx, _previous, _current, 0, 0, DeltaElements::putIndex(_ctx, 0)};
+    StructFields<T>::visit(visitor);
+    if (visitor.result) {
+      std::memcpy(pCount, &visitor.count, sizeof(visitor.count));
+    }
+    return visitor.result;
+  }
+
+  static bool apply(UnpackBuffer & _buffer, T & _value) {
+    const size_t kCount = _buffer.get<DeltaFormat::Index>();
+    ApplyVisitor visitor{_buffer, _value, 0, kCount, 0, true};
+    if (kCount > 0) {
+      visitor.next = _buffer.get<DeltaFormat::Index>();
+    }
+    StructFields<T>::visit(visitor);
+    // Changes of unknown fields or in wrong order are left unapplied
+    return visitor.result && visitor.remaining == 0;
+  }
+
+ private:
+  struct EqualVisitor {
+    template <typename M>
+    void operator()(M T::* _member) {
+      result = result && DeltaCodec<M>::isEqual(previous.*_member, current.*_member);
+    }
+
+    const T & previous;
+    const T & current;
+    bool result;
+  };
+
+  template <typename TBufferContext>
+  struct PutVisitor {
+    template <typename M>
+    void operator()(M T::* _member) {
+      if (result && !DeltaCodec<M>::isEqual(previous.*_member, current.*_member)) {
+        result = DeltaElements::putIndex(ctx, index) && DeltaCodec<M>::put(ctx, previous.*_member, current.*_member);
+        ++count;
+      }
+      ++index;
+    }
+
+    TBufferContext & ctx;
+    const T & previous;
+    const T & current;
+    size_t index;
+    DeltaFormat::Index count;
+    bool result;
+  };
+
+  struct ApplyVisitor {
+    template <typename M>
+    void operator()(M T::* _member) {
+      if (result && remaining > 0 && index == next) {
+        result = DeltaCodec<M>::apply(buffer, value.*_member);
+        --remaining;
+        if (result && remaining > 0) {
+          next = buffer.get<DeltaFormat::Index>();
+        }
+      }
+      ++index;
+    }
+
+    UnpackBuffer & buffer;
+    T & value;
+    size_t index;
+    size_t remaining;
+    size_t next;
+    bool result;
+  };
+};
+
+/**
+ * Element-wise codec of std::array
+ */
+template <typename E, size_t N>
+struct DeltaCodec<std::array<E, N>> {
+  static bool isEqual(const std::array<E, N> & _previous, const std::array<E, N> & _current) {
+    bool result = true;
+    for (size_t i = 0; result && i < N; ++i) {
+      result = DeltaCodec<E>::isEqual(_previous[i], _current[i]);
+    }
+    return result;
+  }
+
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const std::array<E, N> & _previous, const std::array<E, N> & _current) {
+    return DeltaElements::put(_ctx, _previous.data(), _current.data(), N);
+  }
+
+  static bool apply(UnpackBuffer & _buffer, std::array<E, N> & _value) {
+    return DeltaElements::apply(_buffer, _value.data(), N);
+  }
+};
+
+/**
+ * Element-wise codec of std::vector, std::vector<bool> is packed as a whole value
+ */
+template <typename E>
+struct DeltaCodec<std::vector<E>, typename std::enable_if<!std::is_same<E, bool>::value>::type> {
+  static bool isEqual(const std::vector<E> & _previous, const std::vector<E> & _current) {
+    bool result = _previous.size() == _current.size();
+    for (size_t i = 0; result && i < _current.size(); ++i) {
+      result = DeltaCodec<E>::isEqual(_previous[i], _current[i]);
+    }
+    return result;
+  }
+
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const std::vector<E> & _previous, const std::vector<E> & _current) {
+    const size_t kCommonSize = (_previous.size() < _current.size()) ? _previous.size() : _current.size();
+    bool result = DeltaElements::putIndex(_ctx, _current.size()) &&
+                  DeltaElements::put(_ctx, _previous.data(), _current.data(), kCommonSize);
+    const E kDefault{};
+    for (size_t i = kCommonSize; result && i < _current.size(); ++i) {
+      result = DeltaCodec<E>::put(_ctx, kDefault, _current[i]);
+    }
+    return result;
+  }
+
+  static bool apply(UnpackBuffer & _buffer, std::vector<E> & _value) {
+    const size_t kSize = _buffer.get<DeltaFormat::Index>();
+    const size_t kOldSize = _value.size();
+    // Every appended element takes at least one byte, so corrupted size does not allocate memory
+    bool result = kSize <= kOldSize || kSize - kOldSize <= _buffer.getBufferSize();
+    if (result) {
+      _value.resize(kSize);
+      const size_t kCommonSize = (kOldSize < kSize) ? kOldSize : kSize;
+      result = DeltaElements::apply(_buffer, _value.data(), kCommonSize);
+      for (size_t i = kCommonSize; result && i < kSize; ++i) {
+        result = DeltaCodec<E>::apply(_buffer, _value[i]);
+      }
+    }
+    return result;
+  }
+};
+
+/**
+ * Key-wise codec of std::map
+ */
+template <typename K, typename V>
+struct DeltaCodec<std::map<K, V>> {
+  static bool isEqual(const std::map<K, V> & _previous, const std::map<K, V> & _current) {
+    bool result = _previous.size() == _current.size();
+    for (auto previous = _previous.begin(), current = _current.begin();
+         result && current != _current.end(); ++previous, ++current) {
+      result = !(previous->first < current->first) && !(current->first < previous->first) &&
+               DeltaCodec<V>::isEqual(previous->second, current->second);
+    }
+    return result;
+  }
+
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const std::map<K, V> & _previous, const std::map<K, V> & _current) {
+    uint8_t * const pRemovedCount = _ctx.buffer();
+    bool result = DeltaElements::putIndex(_ctx, 0);
+    DeltaFormat::Index removedCount = 0;
+    auto current = _current.begin();
+    for (auto previous = _previous.begin(); result && previous != _previous.end(); ++previous) {
+      while (current != _current.end() && current->first < previous->first) {
+        ++current;
+      }
+      if (current == _current.end() || previous->first < current->first) {
+        result = PackBuffer::DelegatePackBuffer<K>{}.put(_ctx, previous->first);
+        ++removedCount;
+      }
+    }
+    uint8_t * const pUpsertedCount = _ctx.buffer();
+    result = result && DeltaElements::putIndex(_ctx, 0);
+    DeltaFormat::Index upsertedCount = 0;
+    const V kDefault{};
+    auto previous = _previous.begin();
+    for (current = _current.begin(); result && current != _current.end(); ++current) {
+      while (previous != _previous.end() && previous->first < current->first) {
+        ++previous;
+      }
+      const bool kIsNew = previous == _previous.end() || current->first < previous->first;
+      const V & kOldValue = kIsNew ? kDefault : previous->second;
+      if (kIsNew || !DeltaCodec<V>::isEqual(kOldValue, current->second)) {
+        result = PackBuffer::DelegatePackBuffer<K>{}.put(_ctx, current->first) &&
+                 DeltaCodec<V>::put(_ctx, kOldValue, current->second);
+        ++upsertedCount;
+      }
+    }
+    if (result) {
+      std::memcpy(pRemovedCount, &removedCount, sizeof(removedCount));
+      std::memcpy(pUpsertedCount, &upsertedCount, sizeof(upsertedCount));
+    }
+    return result;
+  }
+
+  static bool apply(UnpackBuffer & _buffer, std::map<K, V> & _value) {
+    const size_t kRemovedCount = _buffer.get<DeltaFormat::Index>();
+    bool result = kRemovedCount <= _value.size();
+    for (size_t i = 0; result && i < kRemovedCount; ++i) {
+      result = _value.erase(_buffer.get<K>()) == 1;
+    }
+    const size_t kUpsertedCount = result ? _buffer.get<DeltaFormat::Index>() : 0;
+    result = result && kUpsertedCount <= _buffer.getBufferSize();
+    for (size_t i = 0; result && i < kUpsertedCount; ++i) {
+      result = DeltaCodec<V>::apply(_buffer, _value[_buffer.get<K>()]);
+    }
+    return result;
+  }
+};
+
+template <typename T>
+class DeltaEncoder;
+
+/**
+ * Wrapper for packing of message as difference against the previous one:
+ *     buffer.put(encoder.delta(snapshot));
+ * Packed data is unpacked with DeltaDecoder::get
+ */
+template <typename T>
+struct DeltaMessage {
+  DeltaMessage(DeltaEncoder<T> & _encoder, const T & _message)
+      : encoder(_encoder)
+      , message(_message) {
+  }
+
+  DeltaEncoder<T> & encoder;
+  const T & message;
+};
+
+/**
+ * Encoder side of delta channel, it keeps copy of the last packed message. It is not thread-safe
+ * and should be used for one ordered channel. Every message packed with it should be delivered,
+ * otherwise call reset() to send the next message as key frame
+ * @tparam T Type of message, it should be default constructible and copyable
+ */
+template <typename T>
+class DeltaEncoder {
+ public:
+  DeltaEncoder()
+      : previous_()
+      , is_key_frame_{true}
+      , sequence_{0} {
+  }
+
+  DeltaEncoder(const DeltaEncoder &) = delete;
+  DeltaEncoder & operator=(const DeltaEncoder &) = delete;
+
+  DeltaMessage<T> delta(const T & _message) {
+    return DeltaMessage<T>(*this, _message);
+  }
+
+  /**
+   * Method for packing of difference, the previous message is changed only if packing is succeed
+   * @return Return true if packing is succeed, false otherwise
+   */
+  template <typename TBufferContext>
+  bool put(TBufferContext & _ctx, const T & _message) {
+    uint32_t flags = sequence_ << DeltaFormat::kSequenceShift;
+    if (is_key_frame_) {
+      flags |= DeltaFormat::kKeyFrame;
+    }
+    const bool kResult = PackBuffer::DelegatePackBuffer<uint32_t>{}.put(_ctx, flags) &&
+                         DeltaCodec<T>::put(_ctx, previous_, _message);
+    if (kResult) {
+      previous_ = _message;
+      is_key_frame_ = false;
+      sequence_ = (sequence_ + 1) & DeltaFormat::kSequenceMask;
+    }
+    return kResult;
+  }
+
+  /**
+   * Method for starting of channel again, the next message is packed as key frame
+   */
+  void reset() {
+    previous_ = T();
+    is_key_frame_ = true;
+  }
+
+  const T & getPrevious() const {
+    return previous_;
+  }
+
+ private:
+  T previous_;
+  bool is_key_frame_;
+  uint32_t sequence_;
+};
+
+/**
+ * Decoder side of delta channel, it applies differences to its own copy of message
+ * @tparam T Type of message
+ */
+template <typename T>
+class DeltaDecoder {
+ public:
+  DeltaDecoder()
+      : current_()
+      , is_synchronized_{false}
+      , next_sequence_{0} {
+  }
+
+  DeltaDecoder(const DeltaDecoder &) = delete;
+  DeltaDecoder & operator=(const DeltaDecoder &) = delete;
+
+  /**
+   * Method for unpacking of message packed with DeltaEncoder. After failure decoder waits for key frame
+   * @return Message after applying of difference or nullptr if the previous message is unknown,
+   *         message before this one was missed or difference is corrupted
+   */
+  T const * get(UnpackBuffer & _buffer) {
+    const uint32_t kFlags = _buffer.get<uint32_t>();
+    const uint32_t kSequence = (kFlags >> DeltaFormat::kSequenceShift) & DeltaFormat::kSequenceMask;
+    if ((kFlags & DeltaFormat::kKeyFrame) != 0) {
+      current_ = T();
+      is_synchronized_ = true;
+    } else if (kSequence != next_sequence_) {
+      // Difference is against message which was not applied
+      is_synchronized_ = false;
+    }
+    next_sequence_ = (kSequence + 1) & DeltaFormat::kSequenceMask;
+    // Decoder is out of sync until difference is fully applied
+    const bool kIsSynchronized = is_synchronized_;
+    is_synchronized_ = false;
+    is_synchronized_ = kIsSynchronized && DeltaCodec<T>::apply(_buffer, current_);
+    if (!is_synchronized_) {
+#ifdef __cpp_exceptions
+      throw std::out_of_range("Delta message could not be applied, key frame is required !!");
+#endif
+    }
+    return is_synchronized_ ? &current_ : nullptr;
+  }
+
+  /**
+   * Method for dropping of current message, only key frame is accepted after it
+   */
+  void reset() {
+    current_ = T();
+    is_synchronized_ = false;
+  }
+
+  bool isSynchronized() const {
+    return is_synchronized_;
+  }
+
+  const T & getCurrent() const {
+    return current_;
+  }
+
+ private:
+  T current_;
+  bool is_synchronized_;
+  uint32_t next_sequence_;
+};
+
+template <typename T>
+class PackBuffer::DelegatePackBuffer<DeltaMessage<T>> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const DeltaMessage<T> & _delta) {
+    return _delta.encoder.put(_ctx, _delta.message);
+  }
+};
+}
+
+#endif //BUFFERS_DELTASNAPSHOT_HPP
@@ -0,0 +1,97 @@
+/**
+ * @file EncodedVector.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains std::vector wrappers which are packed with array encodings
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_ENCODEDVECTOR_HPP
+#define BUFFERS_ENCODEDVECTOR_HPP
+
+#include <utility>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+/**
+ * std::vector which is packed as one array with encoding TFormat instead of element by element.
+ * Encoding should provide:
+ *     template <typename TBufferContext>
+ *     static bool put(TBufferContext & _ctx, const std::vector<T> & _vector);
+ *     static size_t getTypeSize(const std::vector<T> & _vector);
+ *     template <typename TBufferContext>
+ *     static void get(TBufferContext & _ctx, std::vector<T> & _result);
+ * Every encoding names its vector with alias, for example StreamVByteVector
+ * @tparam T Type of elements
+ * @tparam TFormat Encoding of array
+ */
+template <typename T, typename TFormat>
+class EncodedVector : public std::vector<T> {
+ public:
+  using std::vector<T>::vector;
+
+  EncodedVector() = default;
+
+  EncodedVector(const std::vector<T> & _vector)
+      : std::vector<T>(_vector) {
+  }
+
+  EncodedVector(std::vector<T> && _vector)
+      : std::vector<T>(std::move(_vector)) {
+  }
+};
+
+/**
+ * Wrapper for packing of existing vector with encoding TFormat without copying,
+ * packed data is unpacked as EncodedVector with the same encoding
+ */
+template <typename T, typename TFormat>
+struct EncodedView {
+  explicit EncodedView(const std::vector<T> & _vector)
+      : vector(_vector) {
+  }
+
+  const std::vector<T> & vector;
+};
+
+template <typename T, typename TFormat>
+class PackBuffer::DelegatePackBuffer<EncodedVector<T, TFormat>> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const EncodedVector<T, TFormat> & _vector) {
+    return TFormat::put(_ctx, _vector);
+  }
+
+  static size_t getTypeSize(const EncodedVector<T, TFormat> & _vector) {
+    return TFormat::getTypeSize(_vector);
+  }
+};
+
+template <typename T, typename TFormat>
+class PackBuffer::DelegatePackBuffer<EncodedView<T, TFormat>> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const EncodedView<T, TFormat> & _view) {
+    return TFormat::put(_ctx, _view.vector);
+  }
+
+  static size_t getTypeSize(const EncodedView<T, TFormat> & _view) {
+    return TFormat::getTypeSize(_view.vector);
+  }
+};
+
+template <typename T, typename TFormat>
+class UnpackBuffer::DelegateUnpackBuffer<EncodedVector<T, TFormat>> {
+ public:
+  template <typename TBufferContext>
+  static EncodedVector<T, TFormat> get(TBufferContext & _ctx) {
+    EncodedVector<T, TFormat> result;
+    TFormat::get(_ctx, result);
+    return result;
+  }
+};
+}
+
+#endif //BUFFERS_ENCODEDVECTOR_HPP
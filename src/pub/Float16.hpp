@@ -0,0 +1,336 @@
+/**
+ * @file Float16.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains quantisation of float vectors to IEEE half and bfloat16 with SIMD kernels
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_FLOAT16_HPP
+#define BUFFERS_FLOAT16_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "EncodedVector.hpp"
+#include "Simd.hpp"
+
+namespace buffers {
+enum class FloatFormat {
+  Half,
+  BFloat16,
+};
+
+/**
+ * Conversion of float values to 16-bit formats and back. Both formats are rounded to nearest even,
+ * NaN stays quiet NaN, half overflows to infinity. All kernels give the same bits
+ */
+class Float16 {
+ public:
+  enum class Kernel {
+    Scalar,
+    Avx2,
+    Avx512,
+  };
+
+  /**
+   * Method for checking whether CPU supports kernel
+   */
+  static bool isSupported(const Kernel _kernel) {
+#ifdef BUFFERS_HAS_X86_SIMD
+    switch (_kernel) {
+      case Kernel::Avx512: return __builtin_cpu_supports("avx512f");
+      case Kernel::Avx2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c");
+      default: return true;
+    }
+#else
+    return _kernel == Kernel::Scalar;
+#endif
+  }
+
+  /**
+   * Method for getting the fastest kernel supported by CPU, it is detected once
+   */
+  static Kernel getBestKernel() {
+    static const Kernel kKernel = isSupported(Kernel::Avx512) ? Kernel::Avx512
+                                  : isSupported(Kernel::Avx2) ? Kernel::Avx2
+                                  : Kernel::Scalar;
+    return kKernel;
+  }
+
+  /**
+   * Method for encoding of values
+   * @param _pIn Values
+   * @param _count Number of values
+   * @param _pOut Destination of 2 * _count bytes, it may be unaligned
+   */
+  static void encode(const FloatFormat _format, const float * _pIn, const size_t _count, uint8_t * _pOut,
+                     const Kernel _kernel = getBestKernel()) {
+    size_t index = 0;
+#ifdef BUFFERS_HAS_X86_SIMD
+    if (_kernel == Kernel::Avx512) {
+      encodeAvx512(_format, _pIn, _count, index, _pOut);
+    } else if (_kernel == Kernel::Avx2) {
+      encodeAvx2(_format, _pIn, _count, index, _pOut);
+    }
+#else
+    (void)_kernel;
+#endif
+    for (; index < _count; ++index) {
+      uint32_t bits;
+      std::memcpy(&bits, _pIn + index, sizeof(bits));
+      const uint16_t kValue = (_format == FloatFormat::Half) ? toHalf(bits) : toBFloat16(bits);
+      std::memcpy(_pOut + 2 * index, &kValue, sizeof(kValue));
+    }
+  }
+
+  /**
+   * Method for decoding of values
+   * @param _pIn Source of 2 * _count bytes, it may be unaligned
+   * @param _count Number of values
+   * @param _pOut Destination of values
+   */
+  static void decode(const FloatFormat _format, uint8_t const * _pIn, const size_t _count, float * _pOut,
+                     const Kernel _kernel = getBestKernel()) {
+    size_t index = 0;
+#ifdef BUFFERS_HAS_X86_SIMD
+    if (_kernel == Kernel::Avx512) {
+      decodeAvx512(_format, _pIn, _count, index, _pOut);
+    } else if (_kernel == Kernel::Avx2) {
+      decodeAvx2(_format, _pIn, _count, index, _pOut);
+    }
+#else
+    (void)_kernel;
+#endif
+    for (; index < _count; ++index) {
+      uint16_t value;
+      std::memcpy(&value, _pIn + 2 * index, sizeof(value));
+      const uint32_t kBits = (_format == FloatFormat::Half) ? fromHalf(value) : fromBFloat16(value);
+      std::memcpy(_pOut + index, &kBits, sizeof(kBits));
+    }
+  }
+
+ private:
+  static float toFloat(const uint32_t _bits) {
+    float result;
+    std::memcpy(&result, &_bits, sizeof(result));
+    return result;
+  }
+
+  static uint32_t toBits(const float _value) {
+    uint32_t result;
+    std::memcpy(&result, &_value, sizeof(result));
+    return result;
+  }
+
+  /**
+   * Subnormal halves are rounded by adding of float whose ulp equals to ulp of subnormal half,
+   * normal ones by adding of half ulp minus one plus the lowest kept bit
+   */
+  static uint16_t toHalf(uint32_t _bits) {
+    const uint32_t kSign = (_bits >> 16) & 0x8000u;
+    const uint32_t kDenormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+    uint32_t result;
+    _bits &= 0x7FFFFFFFu;
+    if (_bits > 0x7F800000u) {
+      result = 0x7E00u | ((_bits >> 13) & 0x3FFu);
+    } else if (_bits >= ((127 + 16) << 23)) {
+      result = 0x7C00u;
+    } else if (_bits < ((127 - 14) << 23)) {
+      result = toBits(toFloat(_bits) + toFloat(kDenormMagic)) - kDenormMagic;
+    } else {
+      result = (_bits + (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu + ((_bits >> 13) & 1)) >> 13;
+    }
+    return static_cast<uint16_t>(result | kSign);
+  }
+
+  static uint32_t fromHalf(const uint16_t _value) {
+    const uint32_t kShiftedExponent = 0x7C00u << 13;
+    uint32_t result = (_value & 0x7FFFu) << 13;
+    const uint32_t kExponent = result & kShiftedExponent;
+    result += (127 - 15) << 23;
+    if (kExponent == kShiftedExponent) {
+      result += (128 - 16) << 23;
+      result |= (result & 0x7FFFFFu) ? 0x400000u : 0;
+    } else if (kExponent == 0) {
+      result = toBits(toFloat(result + (1u << 23)) - toFloat((127 - 14) << 23));
+    }
+    return result | (static_cast<uint32_t>(_value & 0x8000u) << 16);
+  }
+
+  static uint16_t toBFloat16(const uint32_t _bits) {
+    return ((_bits & 0x7FFFFFFFu) > 0x7F800000u)
+           ? static_cast<uint16_t>((_bits >> 16) | 0x40u)
+           : static_cast<uint16_t>((_bits + 0x7FFFu + ((_bits >> 16) & 1)) >> 16);
+  }
+
+  static uint32_t fromBFloat16(const uint16_t _value) {
+    return static_cast<uint32_t>(_value) << 16;
+  }
+
+#ifdef BUFFERS_HAS_X86_SIMD
+  /**
+   * bfloat16 rounding of eight floats, result is in low halves of 32-bit lanes
+   */
+  __attribute__((target("avx2")))
+  static __m256i toBFloat16Avx2(const __m256i _bits) {
+    const __m256i kLowest = _mm256_and_si256(_mm256_srli_epi32(_bits, 16), _mm256_set1_epi32(1));
+    const __m256i kRounded = _mm256_srli_epi32(
+        _mm256_add_epi32(_bits, _mm256_add_epi32(kLowest, _mm256_set1_epi32(0x7FFF))), 16);
+    const __m256i kNan = _mm256_cmpgt_epi32(_mm256_and_si256(_bits, _mm256_set1_epi32(0x7FFFFFFF)),
+                                            _mm256_set1_epi32(0x7F800000));
+    const __m256i kQuiet = _mm256_or_si256(_mm256_srli_epi32(_bits, 16), _mm256_set1_epi32(0x40));
+    return _mm256_blendv_epi8(kRounded, kQuiet, kNan);
+  }
+
+  __attribute__((target("avx2,f16c")))
+  static void encodeAvx2(const FloatFormat _format, const float * _pIn, const size_t _count, size_t & _index,
+                         uint8_t * _pOut) {
+    if (_format == FloatFormat::Half) {
+      for (; _index + 8 <= _count; _index += 8) {
+        const __m128i kHalves = _mm256_cvtps_ph(_mm256_loadu_ps(_pIn + _index),
+                                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(_pOut + 2 * _index), kHalves);
+      }
+    } else {
+      for (; _index + 16 <= _count; _index += 16) {
+        const __m256i kLow = toBFloat16Avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(_pIn + _index)));
+        const __m256i kHigh = toBFloat16Avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(_pIn + _index + 8)));
+        // Packing works inside of 128-bit lanes, permutation restores order of values
+        const __m256i kPacked = _mm256_permute4x64_epi64(_mm256_packus_epi32(kLow, kHigh), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(_pOut + 2 * _index), kPacked);
+      }
+    }
+  }
+
+  __attribute__((target("avx2,f16c")))
+  static void decodeAvx2(const FloatFormat _format, uint8_t const * _pIn, const size_t _count, size_t & _index,
+                         float * _pOut) {
+    for (; _index + 8 <= _count; _index += 8) {
+      const __m128i kValues = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_pIn + 2 * _index));
+      if (_format == FloatFormat::Half) {
+        _mm256_storeu_ps(_pOut + _index, _mm256_cvtph_ps(kValues));
+      } else {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(_pOut + _index),
+                            _mm256_slli_epi32(_mm256_cvtepu16_epi32(kValues), 16));
+      }
+    }
+  }
+
+// GCC 12 warns about _mm512_undefined_* used inside of its own AVX-512 intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+  __attribute__((target("avx512f")))
+  static void encodeAvx512(const FloatFormat _format, const float * _pIn, const size_t _count, size_t & _index,
+                           uint8_t * _pOut) {
+    for (; _index + 16 <= _count; _index += 16) {
+      __m256i values;
+      if (_format == FloatFormat::Half) {
+        values = _mm512_cvtps_ph(_mm512_loadu_ps(_pIn + _index), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+      } else {
+        const __m512i kBits = _mm512_loadu_si512(_pIn + _index);
+        const __m512i kLowest = _mm512_and_si512(_mm512_srli_epi32(kBits, 16), _mm512_set1_epi32(1));
+        const __m512i kRounded = _mm512_srli_epi32(
+            _mm512_add_epi32(kBits, _mm512_add_epi32(kLowest, _mm512_set1_epi32(0x7FFF))), 16);
+        const __mmask16 kNan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(kBits, _mm512_set1_epi32(0x7FFFFFFF)),
+                                                       _mm512_set1_epi32(0x7F800000));
+        const __m512i kQuiet = _mm512_or_si512(_mm512_srli_epi32(kBits, 16), _mm512_set1_epi32(0x40));
+        values = _mm512_cvtepi32_epi16(_mm512_mask_blend_epi32(kNan, kRounded, kQuiet));
+      }
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(_pOut + 2 * _index), values);
+    }
+  }
+
+  __attribute__((target("avx512f")))
+  static void decodeAvx512(const FloatFormat _format, uint8_t const * _pIn, const size_t _count, size_t & _index,
+                           float * _pOut) {
+    for (; _index + 16 <= _count; _index += 16) {
+      const __m256i kValues = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_pIn + 2 * _index));
+      if (_format == FloatFormat::Half) {
+        _mm512_storeu_ps(_pOut + _index, _mm512_cvtph_ps(kValues));
+      } else {
+        _mm512_storeu_si512(_pOut + _index, _mm512_slli_epi32(_mm512_cvtepu16_epi32(kValues), 16));
+      }
+    }
+  }
+#pragma GCC diagnostic pop
+#endif
+};
+
+/**
+ * Encoding of float array with 16-bit values, layout:
+ *     count | 16-bit values | padding
+ * Unpacked values are rounded, half keeps 11 bits of mantissa in range up to 65504,
+ * bfloat16 keeps range of float with 8 bits of mantissa
+ * @tparam F Format of packed values
+ */
+template <FloatFormat F>
+struct QuantizedFormat {
+  using SizeType = size_t;
+
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const std::vector<float> & _vector) {
+    bool result = false;
+    const size_t kHeaderSize = getAlignedSize(sizeof(SizeType), _ctx.alignment());
+    const size_t kEncodedSize = 2 * _vector.size();
+    if (kHeaderSize + getAlignedSize(kEncodedSize, _ctx.alignment()) <= _ctx.buffer_size()) {
+      PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, _vector.size());
+      Float16::encode(F, _vector.data(), _vector.size(), _ctx.buffer());
+      _ctx += kEncodedSize;
+      result = true;
+    }
+    return result;
+  }
+
+  static size_t getTypeSize(const std::vector<float> & _vector) {
+    return sizeof(SizeType) + 2 * _vector.size();
+  }
+
+  template <typename TBufferContext>
+  static void get(TBufferContext & _ctx, std::vector<float> & _result) {
+    const SizeType kCount = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    const bool kIsValid = kCount <= _ctx.buffer_size() / 2;
+    if (kIsValid) {
+      _result.resize(kCount);
+      Float16::decode(F, _ctx.buffer(), kCount, _result.data());
+      _ctx += 2 * kCount;
+    } else {
+#ifdef __cpp_exceptions
+      throw std::out_of_range("Quantized data is out of buffer !!");
+#endif
+    }
+  }
+};
+
+/**
+ * std::vector of float which is packed with 16-bit values
+ * @tparam F Format of packed values
+ */
+template <FloatFormat F>
+using QuantizedVector = EncodedVector<float, QuantizedFormat<F>>;
+
+template <FloatFormat F>
+using QuantizedView = EncodedView<float, QuantizedFormat<F>>;
+
+using HalfVector = QuantizedVector<FloatFormat::Half>;
+using BFloat16Vector = QuantizedVector<FloatFormat::BFloat16>;
+
+/**
+ * Methods for packing of existing vector with 16-bit values without copying:
+ *     buffer.put(buffers::half(features));
+ * Packed data is unpacked as HalfVector or BFloat16Vector
+ */
+inline QuantizedView<FloatFormat::Half> half(const std::vector<float> & _vector) {
+  return QuantizedView<FloatFormat::Half>(_vector);
+}
+
+inline QuantizedView<FloatFormat::BFloat16> bfloat16(const std::vector<float> & _vector) {
+  return QuantizedView<FloatFormat::BFloat16>(_vector);
+}
+}
+
+#endif //BUFFERS_FLOAT16_HPP
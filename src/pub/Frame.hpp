@@ -0,0 +1,297 @@
+/**
+ * @file Frame.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains length-prefixed framing of many messages in one buffer
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_FRAME_HPP
+#define BUFFERS_FRAME_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+/**
+ * Layout of frame:
+ *     uint32_t payload size | padding up to alignment | payload padded up to alignment
+ * Frames are packed back-to-back, so many messages could share one buffer
+ */
+struct FrameFormat {
+  using SizeType = uint32_t;
+
+  /**
+   * Method for getting size of frame header
+   * @param _alignment Alignment of packed data
+   * @return Size of frame header including padding
+   */
+  static size_t getHeaderSize(AlignMemory _alignment) {
+    return getAlignedSize(sizeof(SizeType), _alignment);
+  }
+
+  /**
+   * Method for getting size of whole frame
+   * @param _payloadSize Size of packed message
+   * @param _alignment Alignment of packed data
+   * @return Size of frame including header and padding
+   */
+  static size_t getFrameSize(const size_t _payloadSize, AlignMemory _alignment) {
+    return getHeaderSize(_alignment) + getAlignedSize(_payloadSize, _alignment);
+  }
+
+  /**
+   * Method for writing frame header to raw memory, padding is zeroed
+   * @param _pHeader Pointer to memory of getHeaderSize() bytes
+   * @param _payloadSize Size of packed message
+   * @param _alignment Alignment of packed data
+   */
+  static void writeHeader(uint8_t * _pHeader, const size_t _payloadSize, AlignMemory _alignment) {
+    const SizeType kSize = static_cast<SizeType>(_payloadSize);
+    std::memset(_pHeader, 0, getHeaderSize(_alignment));
+    std::memcpy(_pHeader, &kSize, sizeof(kSize));
+  }
+
+  /**
+   * Method for reading size of payload from frame header
+   * @param _pHeader Pointer to frame header
+   * @return Size of packed message
+   */
+  static size_t readHeader(uint8_t const * _pHeader) {
+    SizeType result;
+    std::memcpy(&result, _pHeader, sizeof(result));
+    return result;
+  }
+};
+
+/**
+ * Class for packing of length-prefixed frames to the PackBuffer
+ */
+class FrameWriter {
+ public:
+  /**
+   * Constructor of frame writer
+   * @param _buffer Buffer to which frames are packed
+   */
+  explicit FrameWriter(PackBuffer & _buffer)
+      : buffer_(_buffer)
+      , frame_offset_{kNoFrame}
+      , num_frames_{0} {
+  }
+
+  FrameWriter(const FrameWriter&) = delete;
+  FrameWriter& operator=(const FrameWriter&) = delete;
+
+  /**
+   * Method for starting of new frame, message should be put to the buffer after it
+   * @return Return true if frame is started, false otherwise
+   */
+  bool beginFrame() {
+    bool result = false;
+    if (frame_offset_ == kNoFrame) {
+      const size_t kOffset = buffer_.getDataSize();
+      if (buffer_.put(FrameFormat::SizeType{0})) {
+        frame_offset_ = kOffset;
+        result = true;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for committing of frame started by beginFrame()
+   * @return Return true if frame is committed, false otherwise
+   */
+  bool commitFrame() {
+    bool result = false;
+    if (frame_offset_ != kNoFrame) {
+      const size_t kPayloadSize = buffer_.getDataSize() - frame_offset_ -
+                                  FrameFormat::getHeaderSize(buffer_.getAlignment());
+      if (kPayloadSize <= std::numeric_limits<FrameFormat::SizeType>::max()) {
+        result = buffer_.putAt(frame_offset_, static_cast<FrameFormat::SizeType>(kPayloadSize));
+      }
+      if (result) {
+        ++num_frames_;
+        frame_offset_ = kNoFrame;
+      } else {
+        abortFrame();
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for dropping of frame started by beginFrame()
+   */
+  void abortFrame() {
+    if (frame_offset_ != kNoFrame) {
+      buffer_.reset(frame_offset_);
+      frame_offset_ = kNoFrame;
+    }
+  }
+
+  /**
+   * Method for packing of frame which consists of one value
+   * @tparam T Type of value
+   * @param _t Value for packing
+   * @return Return true if packing is succeed, false otherwise
+   */
+  template <typename T>
+  bool put(const T & _t) {
+    bool result = false;
+    if (beginFrame()) {
+      if (buffer_.put(_t)) {
+        result = commitFrame();
+      } else {
+        abortFrame();
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for getting number of committed frames
+   * @return Number of committed frames
+   */
+  size_t getFramesCount() const {
+    return num_frames_;
+  }
+
+ private:
+  static constexpr size_t kNoFrame = std::numeric_limits<size_t>::max();
+
+  PackBuffer & buffer_;
+  size_t frame_offset_;
+  size_t num_frames_;
+};
+
+/**
+ * Class for iterating over frames without copying, every frame is unpacked by its own UnpackBuffer.
+ * Incomplete frame at the end of buffer is not visited, so the reader could be used on partial stream data
+ */
+class FrameReader {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = UnpackBuffer;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = UnpackBuffer;
+
+    Iterator(const FrameReader & _reader, const size_t _offset)
+        : reader_(&_reader)
+        , offset_{_offset} {
+    }
+
+    /**
+     * Method for getting unpack buffer of current frame
+     * @return Unpack buffer which is limited by current frame
+     */
+    UnpackBuffer operator*() const {
+      return UnpackBuffer(reader_->p_data_ + offset_ + reader_->header_size_,
+                          FrameFormat::readHeader(reader_->p_data_ + offset_),
+                          reader_->alignment_);
+    }
+
+    /**
+     * Method for getting offset of current frame, for end() it is size of complete frames
+     * @return Offset of current frame
+     */
+    size_t offset() const {
+      return offset_;
+    }
+
+    Iterator & operator++() {
+      offset_ = reader_->next(offset_);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator result = *this;
+      ++(*this);
+      return result;
+    }
+
+    bool operator==(const Iterator & _other) const {
+      return offset_ == _other.offset_;
+    }
+
+    bool operator!=(const Iterator & _other) const {
+      return offset_ != _other.offset_;
+    }
+
+   private:
+    const FrameReader * reader_;
+    size_t offset_;
+  };
+
+  /**
+   * Constructor of frame reader
+   * @param _pData Pointer to the frames
+   * @param _size Size of the frames data
+   * @param _alignment Alignment of packed data
+   */
+  FrameReader(uint8_t const * _pData, const size_t _size,
+              AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : p_data_(_pData)
+      , size_{_size}
+      , alignment_{_alignment}
+      , header_size_{FrameFormat::getHeaderSize(_alignment)}
+      , end_offset_{0} {
+    while (isComplete(end_offset_)) {
+      end_offset_ += frameSize(end_offset_);
+    }
+  }
+
+  /**
+   * Constructor of frame reader for packed buffer
+   * @param _buffer Buffer with packed frames
+   */
+  explicit FrameReader(const PackBuffer & _buffer)
+      : FrameReader(_buffer.getData(), _buffer.getDataSize(), _buffer.getAlignment()) {
+  }
+
+  Iterator begin() const {
+    return Iterator(*this, 0);
+  }
+
+  Iterator end() const {
+    return Iterator(*this, end_offset_);
+  }
+
+  /**
+   * Method for getting size of complete frames, rest of data is the beginning of incomplete frame
+   * @return Size of complete frames
+   */
+  size_t getCompleteSize() const {
+    return end_offset_;
+  }
+
+ private:
+  size_t frameSize(const size_t _offset) const {
+    return header_size_ +
+           getAlignedSize(FrameFormat::readHeader(p_data_ + _offset), alignment_);
+  }
+
+  bool isComplete(const size_t _offset) const {
+    return (_offset + header_size_ <= size_) && (frameSize(_offset) <= size_ - _offset);
+  }
+
+  size_t next(const size_t _offset) const {
+    return _offset + frameSize(_offset);
+  }
+
+  uint8_t const * p_data_;
+  size_t size_;
+  AlignMemory alignment_;
+  size_t header_size_;
+  size_t end_offset_;
+};
+}
+
+#endif //BUFFERS_FRAME_HPP
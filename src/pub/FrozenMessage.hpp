@@ -0,0 +1,330 @@
+/**
+ * @file FrozenMessage.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains immutable reference-counted packed messages and pool of pack buffers
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_FROZENMESSAGE_HPP
+#define BUFFERS_FROZENMESSAGE_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "HeapPackBuffer.hpp"
+
+// NUMA placement of pooled buffers uses mbind, so it is available only on Linux
+#if defined(__linux__)
+#include "NumaPackBuffer.hpp"
+#define BUFFERS_HAS_NUMA 1
+#endif
+
+namespace buffers {
+class PackBufferPool;
+class PooledPackBuffer;
+
+/**
+ * Handle of immutable packed message with atomic reference counter.
+ * Copying of handle only increments counter, so one message could be shared by many threads and
+ * read by any number of UnpackBuffer concurrently. Memory is released to its owner when the last
+ * handle is destroyed
+ */
+class FrozenMessage {
+ public:
+  FrozenMessage()
+      : block_(nullptr) {
+  }
+
+  FrozenMessage(const FrozenMessage & _other)
+      : block_(_other.block_) {
+    if (block_) {
+      block_->references.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  FrozenMessage(FrozenMessage && _other) noexcept
+      : block_(_other.block_) {
+    _other.block_ = nullptr;
+  }
+
+  FrozenMessage& operator=(FrozenMessage _other) {
+    std::swap(block_, _other.block_);
+    return *this;
+  }
+
+  ~FrozenMessage() {
+    if (block_ && block_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      block_->destroy(block_);
+    }
+  }
+
+  /**
+   * Method for freezing of heap buffer without copying, buffer is left empty
+   * @param _buffer Buffer with finished message
+   * @return Handle of message
+   */
+  static FrozenMessage freeze(HeapPackBuffer & _buffer) {
+    const size_t kSize = _buffer.getDataSize();
+    const AlignMemory kAlignment = _buffer.getAlignment();
+    Block * pBlock = new Block(_buffer.release(), kSize, kAlignment, &destroyHeap, nullptr);
+    return FrozenMessage(pBlock);
+  }
+
+  /**
+   * Method for freezing of copy of any buffer, counter and data share one allocation
+   * @param _buffer Buffer with finished message
+   * @return Handle of message
+   */
+  static FrozenMessage copy(const PackBuffer & _buffer) {
+    uint8_t * pStorage = new uint8_t[kBlockSize + _buffer.getDataSize()];
+    std::memcpy(pStorage + kBlockSize, _buffer.getData(), _buffer.getDataSize());
+    Block * pBlock = new (pStorage) Block(pStorage + kBlockSize, _buffer.getDataSize(),
+                                          _buffer.getAlignment(), &destroyStorage, pStorage);
+    return FrozenMessage(pBlock);
+  }
+
+  explicit operator bool() const {
+    return block_ != nullptr;
+  }
+
+  uint8_t const * getData() const {
+    return block_ ? block_->data : nullptr;
+  }
+
+  size_t getDataSize() const {
+    return block_ ? block_->size : 0;
+  }
+
+  AlignMemory getAlignment() const {
+    return block_ ? block_->alignment : static_cast<AlignMemory>(sizeof(int));
+  }
+
+  /**
+   * Method for creating of reader of message, every reader has its own cursor
+   * @return Unpack buffer over message
+   */
+  UnpackBuffer getUnpackBuffer() const {
+    return UnpackBuffer(getData(), getDataSize(), getAlignment());
+  }
+
+  /**
+   * Method for getting number of handles of message, result is approximate if called concurrently
+   */
+  size_t getReferencesCount() const {
+    return block_ ? block_->references.load(std::memory_order_relaxed) : 0;
+  }
+
+ private:
+  friend class PackBufferPool;
+  friend class PooledPackBuffer;
+
+  struct Block {
+    Block(uint8_t const * _data, const size_t _size, AlignMemory _alignment,
+          void (*_destroy)(Block *), void * _owner)
+        : references{1}
+        , data(_data)
+        , size{_size}
+        , alignment{_alignment}
+        , destroy(_destroy)
+        , owner(_owner) {
+    }
+
+    std::atomic<size_t> references;
+    uint8_t const * data;
+    size_t size;
+    AlignMemory alignment;
+    void (*destroy)(Block *);
+    void * owner;
+  };
+
+  // Block is placed before data in shared allocation, data keeps alignment of allocation
+  static constexpr size_t kBlockSize = (sizeof(Block) + 15) / 16 * 16;
+
+  explicit FrozenMessage(Block * _block)
+      : block_(_block) {
+  }
+
+  static void destroyHeap(Block * _block) {
+    delete [] _block->data;
+    delete _block;
+  }
+
+  static void destroyStorage(Block * _block) {
+    uint8_t * pStorage = static_cast<uint8_t *>(_block->owner);
+    _block->~Block();
+    delete [] pStorage;
+  }
+
+  Block * block_;
+};
+
+/**
+ * Thread-safe pool of fixed size buffers, buffers of frozen messages return to it from any thread.
+ * Pool should outlive all its buffers and messages
+ */
+class PackBufferPool {
+ public:
+  /**
+   * Constructor of pool
+   * @param _bufferSize Size of every buffer
+   * @param _alignment Alignment of packed data
+   */
+  explicit PackBufferPool(const size_t _bufferSize,
+                          AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : buffer_size_{_bufferSize}
+      , alignment_{_alignment}
+      , is_numa_{false} {
+  }
+
+#ifdef BUFFERS_HAS_NUMA
+  /**
+   * Constructor of pool which places buffers on NUMA node
+   * @param _bufferSize Size of every buffer
+   * @param _numa Placement of buffers, node should be node of consumer of messages
+   * @param _alignment Alignment of packed data
+   */
+  PackBufferPool(const size_t _bufferSize,
+                 const NumaOptions & _numa,
+                 AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : buffer_size_{_bufferSize}
+      , alignment_{_alignment}
+      , is_numa_{true}
+      , numa_(_numa) {
+  }
+#endif
+
+  PackBufferPool(const PackBufferPool&) = delete;
+  PackBufferPool& operator=(const PackBufferPool&) = delete;
+
+  ~PackBufferPool() {
+    for (uint8_t * pStorage : free_) {
+      deallocate(pStorage);
+    }
+  }
+
+  size_t getBufferSize() const {
+    return buffer_size_;
+  }
+
+  AlignMemory getAlignment() const {
+    return alignment_;
+  }
+
+  /**
+   * Method for getting number of buffers which are ready for reuse
+   */
+  size_t getFreeCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return free_.size();
+  }
+
+ private:
+  friend class PooledPackBuffer;
+
+  /**
+   * Method for taking of storage, storage has space for block of frozen message before data
+   */
+  uint8_t * acquire() {
+    uint8_t * result = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!free_.empty()) {
+        result = free_.back();
+        free_.pop_back();
+      }
+    }
+    if (result == nullptr) {
+#ifdef BUFFERS_HAS_NUMA
+      result = is_numa_ ? NumaMemory::allocate(FrozenMessage::kBlockSize + buffer_size_, numa_)
+                        : new uint8_t[FrozenMessage::kBlockSize + buffer_size_];
+#else
+      result = new uint8_t[FrozenMessage::kBlockSize + buffer_size_];
+#endif
+    }
+    return result;
+  }
+
+  void deallocate(uint8_t * _pStorage) {
+#ifdef BUFFERS_HAS_NUMA
+    if (is_numa_) {
+      NumaMemory::deallocate(_pStorage, FrozenMessage::kBlockSize + buffer_size_, numa_);
+      return;
+    }
+#endif
+    delete [] _pStorage;
+  }
+
+  void recycle(uint8_t * _pStorage) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_.push_back(_pStorage);
+  }
+
+  static void destroyPooled(FrozenMessage::Block * _block) {
+    PackBufferPool * pPool = static_cast<PackBufferPool *>(_block->owner);
+    uint8_t * pStorage = reinterpret_cast<uint8_t *>(_block);
+    _block->~Block();
+    pPool->recycle(pStorage);
+  }
+
+  const size_t buffer_size_;
+  const AlignMemory alignment_;
+  const bool is_numa_;
+#ifdef BUFFERS_HAS_NUMA
+  const NumaOptions numa_;
+#endif
+  mutable std::mutex mutex_;
+  std::vector<uint8_t *> free_;
+};
+
+/**
+ * Pack buffer which takes its memory from pool and returns it back if it was not frozen
+ */
+class PooledPackBuffer : public PackBuffer {
+ public:
+  explicit PooledPackBuffer(PackBufferPool & _pool)
+      : PackBuffer(nullptr, 0, _pool.getAlignment())
+      , pool_(_pool)
+      , p_storage_(_pool.acquire()) {
+    if (p_storage_) {
+      rebind(p_storage_ + FrozenMessage::kBlockSize, _pool.getBufferSize());
+    }
+  }
+
+  ~PooledPackBuffer() {
+    if (p_storage_) {
+      pool_.recycle(p_storage_);
+    }
+  }
+
+  /**
+   * Method for freezing of packed message without copying, memory returns to pool with the last handle.
+   * After freezing buffer is empty
+   * @return Handle of message
+   */
+  FrozenMessage freeze() {
+    FrozenMessage result;
+    if (p_storage_) {
+      FrozenMessage::Block * pBlock = new (p_storage_) FrozenMessage::Block(
+          getData(), getDataSize(), getAlignment(), &PackBufferPool::destroyPooled, &pool_);
+      result = FrozenMessage(pBlock);
+      p_storage_ = nullptr;
+      reset();
+      rebind(nullptr, 0);
+    }
+    return result;
+  }
+
+ private:
+  PackBufferPool & pool_;
+  uint8_t * p_storage_;
+};
+}
+
+#endif //BUFFERS_FROZENMESSAGE_HPP
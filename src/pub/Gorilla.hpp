@@ -0,0 +1,321 @@
+/**
+ * @file Gorilla.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains Gorilla XOR compression of float and double time series
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_GORILLA_HPP
+#define BUFFERS_GORILLA_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "EncodedVector.hpp"
+
+namespace buffers {
+/**
+ * Writer of bit stream, bits are written from the most significant one
+ */
+class BitWriter {
+ public:
+  BitWriter(uint8_t * _pBegin, uint8_t * const _pEnd)
+      : p_data_(_pBegin)
+      , p_end_(_pEnd)
+      , bits_{0}
+      , count_{0}
+      , is_overflow_{false} {
+  }
+
+  /**
+   * Method for writing of low _count bits of value
+   */
+  void write(uint64_t _value, unsigned _count) {
+    if (_count > 32) {
+      write(_value >> 32, _count - 32);
+      _value &= 0xFFFFFFFFu;
+      _count = 32;
+    }
+    bits_ = (bits_ << _count) | (_value & ((uint64_t{1} << _count) - 1));
+    count_ += _count;
+    while (count_ >= 8) {
+      count_ -= 8;
+      putByte(static_cast<uint8_t>(bits_ >> count_));
+    }
+  }
+
+  /**
+   * Method for writing of the last incomplete byte
+   * @return End of written data or nullptr if data does not fit
+   */
+  uint8_t * finish() {
+    if (count_ > 0) {
+      putByte(static_cast<uint8_t>(bits_ << (8 - count_)));
+      count_ = 0;
+    }
+    return is_overflow_ ? nullptr : p_data_;
+  }
+
+ private:
+  void putByte(const uint8_t _byte) {
+    if (p_data_ != p_end_) {
+      *p_data_++ = _byte;
+    } else {
+      is_overflow_ = true;
+    }
+  }
+
+  uint8_t * p_data_;
+  uint8_t * const p_end_;
+  uint64_t bits_;
+  unsigned count_;
+  bool is_overflow_;
+};
+
+/**
+ * Reader of bit stream written by BitWriter, reading after the end gives zero bits and sets error
+ */
+class BitReader {
+ public:
+  BitReader(uint8_t const * _pBegin, uint8_t const * const _pEnd)
+      : p_data_(_pBegin)
+      , p_end_(_pEnd)
+      , bits_{0}
+      , count_{0}
+      , is_overflow_{false} {
+  }
+
+  uint64_t read(unsigned _count) {
+    uint64_t result = 0;
+    if (_count > 32) {
+      result = read(_count - 32) << 32;
+      _count = 32;
+    }
+    while (count_ < _count) {
+      bits_ = (bits_ << 8) | getByte();
+      count_ += 8;
+    }
+    count_ -= _count;
+    return result | ((bits_ >> count_) & ((uint64_t{1} << _count) - 1));
+  }
+
+  bool isOverflow() const {
+    return is_overflow_;
+  }
+
+ private:
+  uint8_t getByte() {
+    uint8_t result = 0;
+    if (p_data_ != p_end_) {
+      result = *p_data_++;
+    } else {
+      is_overflow_ = true;
+    }
+    return result;
+  }
+
+  uint8_t const * p_data_;
+  uint8_t const * const p_end_;
+  uint64_t bits_;
+  unsigned count_;
+  bool is_overflow_;
+};
+
+/**
+ * Gorilla encoding: the first value is stored raw, every next value is XOR with previous one.
+ * Zero XOR takes one bit, XOR which fits meaningful bits of previous XOR takes two control bits,
+ * otherwise number of leading zeros and length of meaningful bits are stored before them
+ * @tparam T float or double
+ */
+template <typename T>
+struct GorillaCodec {
+  static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+                "Gorilla encoding supports only float and double !!");
+  using Bits = typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+
+  static constexpr unsigned kBits = 8 * sizeof(T);
+  static constexpr unsigned kLeadingBits = 5;
+  static constexpr unsigned kLengthBits = (sizeof(T) == 4) ? 5 : 6;
+  static constexpr unsigned kMaxLeading = (1u << kLeadingBits) - 1;
+
+  /**
+   * Method for encoding of values
+   * @return End of encoded data or nullptr if data does not fit
+   */
+  static uint8_t * encode(const T * _pIn, const size_t _count, uint8_t * _pData, uint8_t * const _pDataEnd) {
+    BitWriter writer(_pData, _pDataEnd);
+    Bits previous = 0;
+    unsigned leading = kBits + 1;
+    unsigned trailing = 0;
+    for (size_t i = 0; i < _count; ++i) {
+      const Bits kValue = toBits(_pIn[i]);
+      if (i == 0) {
+        writer.write(kValue, kBits);
+      } else {
+        const Bits kXor = kValue ^ previous;
+        if (kXor == 0) {
+          writer.write(0, 1);
+        } else {
+          unsigned newLeading = countLeadingZeros(kXor);
+          const unsigned kNewTrailing = countTrailingZeros(kXor);
+          if (newLeading > kMaxLeading) {
+            newLeading = kMaxLeading;
+          }
+          if (leading <= kBits && newLeading >= leading && kNewTrailing >= trailing) {
+            writer.write(0x2, 2);
+            writer.write(kXor >> trailing, kBits - leading - trailing);
+          } else {
+            const unsigned kLength = kBits - newLeading - kNewTrailing;
+            writer.write(0x3, 2);
+            writer.write(newLeading, kLeadingBits);
+            writer.write(kLength - 1, kLengthBits);
+            writer.write(kXor >> kNewTrailing, kLength);
+            leading = newLeading;
+            trailing = kNewTrailing;
+          }
+        }
+      }
+      previous = kValue;
+    }
+    return writer.finish();
+  }
+
+  /**
+   * Method for decoding of values
+   * @return Return true if values are decoded, false if data is truncated or corrupted
+   */
+  static bool decode(uint8_t const * _pData, uint8_t const * const _pDataEnd, const size_t _count, T * _pOut) {
+    BitReader reader(_pData, _pDataEnd);
+    Bits previous = 0;
+    unsigned leading = 0;
+    unsigned trailing = 0;
+    for (size_t i = 0; i < _count && !reader.isOverflow(); ++i) {
+      if (i == 0) {
+        previous = static_cast<Bits>(reader.read(kBits));
+      } else if (reader.read(1) != 0) {
+        if (reader.read(1) != 0) {
+          leading = static_cast<unsigned>(reader.read(kLeadingBits));
+          const unsigned kLength = static_cast<unsigned>(reader.read(kLengthBits)) + 1;
+          if (leading + kLength > kBits) {
+            return false;
+          }
+          trailing = kBits - leading - kLength;
+        }
+        previous ^= static_cast<Bits>(reader.read(kBits - leading - trailing) << trailing);
+      }
+      _pOut[i] = fromBits(previous);
+    }
+    return !reader.isOverflow();
+  }
+
+ private:
+  static Bits toBits(const T _value) {
+    Bits result;
+    std::memcpy(&result, &_value, sizeof(result));
+    return result;
+  }
+
+  static T fromBits(const Bits _bits) {
+    T result;
+    std::memcpy(&result, &_bits, sizeof(result));
+    return result;
+  }
+
+  static unsigned countLeadingZeros(const uint32_t _value) {
+    return static_cast<unsigned>(__builtin_clz(_value));
+  }
+
+  static unsigned countLeadingZeros(const uint64_t _value) {
+    return static_cast<unsigned>(__builtin_clzll(_value));
+  }
+
+  static unsigned countTrailingZeros(const uint32_t _value) {
+    return static_cast<unsigned>(__builtin_ctz(_value));
+  }
+
+  static unsigned countTrailingZeros(const uint64_t _value) {
+    return static_cast<unsigned>(__builtin_ctzll(_value));
+  }
+};
+
+/**
+ * Encoding of float or double array with Gorilla XOR encoding, layout:
+ *     count | size of encoded bytes | bit stream | padding
+ */
+struct GorillaFormat {
+  using SizeType = size_t;
+
+  template <typename TBufferContext, typename T>
+  static bool put(TBufferContext & _ctx, const std::vector<T> & _vector) {
+    bool result = false;
+    const size_t kHeaderSize = 2 * getAlignedSize(sizeof(SizeType), _ctx.alignment());
+    if (kHeaderSize <= _ctx.buffer_size()) {
+      uint8_t * const pData = _ctx.buffer() + kHeaderSize;
+      uint8_t * const pDataEnd = GorillaCodec<T>::encode(_vector.data(), _vector.size(), pData,
+                                                         _ctx.buffer() + _ctx.buffer_size());
+      const size_t kEncodedSize = pDataEnd ? static_cast<size_t>(pDataEnd - pData) : 0;
+      if (pDataEnd && kHeaderSize + getAlignedSize(kEncodedSize, _ctx.alignment()) <= _ctx.buffer_size()) {
+        PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, _vector.size());
+        PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, kEncodedSize);
+        _ctx += kEncodedSize;
+        result = true;
+      }
+    }
+    return result;
+  }
+
+  template <typename T>
+  static size_t getTypeSize(const std::vector<T> & _vector) {
+    // Worst case of value is two control bits, leading zeros, length and all bits of value
+    const size_t kMaxBits = 2 + GorillaCodec<T>::kLeadingBits + GorillaCodec<T>::kLengthBits + 8 * sizeof(T);
+    return 2 * sizeof(SizeType) + (_vector.size() * kMaxBits + 7) / 8;
+  }
+
+  template <typename TBufferContext, typename T>
+  static void get(TBufferContext & _ctx, std::vector<T> & _result) {
+    const SizeType kCount = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    const SizeType kEncodedSize = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    bool isDecoded = false;
+    // Every value takes at least one bit
+    if (kEncodedSize <= _ctx.buffer_size() && kCount <= 8 * kEncodedSize) {
+      _result.resize(kCount);
+      isDecoded = GorillaCodec<T>::decode(_ctx.buffer(), _ctx.buffer() + kEncodedSize, kCount, _result.data());
+    }
+    if (!isDecoded) {
+#ifdef __cpp_exceptions
+      throw std::out_of_range("Gorilla data is out of buffer !!");
+#else
+      _result.clear();
+#endif
+    }
+    _ctx += isDecoded ? kEncodedSize : 0;
+  }
+};
+
+/**
+ * std::vector of float or double which is packed with Gorilla XOR encoding
+ */
+template <typename T>
+using GorillaVector = EncodedVector<T, GorillaFormat>;
+
+template <typename T>
+using GorillaView = EncodedView<T, GorillaFormat>;
+
+/**
+ * Method for packing of existing vector with Gorilla XOR encoding without copying:
+ *     buffer.put(buffers::gorilla(samples));
+ * Packed data is unpacked as GorillaVector
+ */
+template <typename T>
+GorillaView<T> gorilla(const std::vector<T> & _vector) {
+  return GorillaView<T>(_vector);
+}
+}
+
+#endif //BUFFERS_GORILLA_HPP
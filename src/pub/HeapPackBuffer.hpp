@@ -27,6 +27,17 @@ class HeapPackBuffer
   ~HeapPackBuffer() {
     delete [] getData();
   }
+
+  /**
+   * Method for taking ownership of heap memory, after it buffer is empty
+   * @return Pointer to the memory which should be deleted by delete []
+   */
+  uint8_t * release() {
+    uint8_t * result = p_buf_;
+    reset();
+    rebind(nullptr, 0);
+    return result;
+  }
 };
 }
 
@@ -0,0 +1,690 @@
+/**
+ * @file IoRing.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains batched I/O of packed buffers through io_uring with writev/readv fallback
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_IORING_HPP
+#define BUFFERS_IORING_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/syscall.h>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+#if defined(__linux__) && defined(__NR_io_uring_setup) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define BUFFERS_HAS_IO_URING 1
+#endif
+#endif
+
+namespace buffers {
+/**
+ * Ring of asynchronous reads and writes of packed buffers.
+ * Memory of all buffers is one pool which is registered in kernel once, so writes and reads
+ * use fixed buffers and many operations are submitted with one io_uring_enter.
+ * When io_uring is not available operations are queued and executed on submit:
+ * consecutive writes or reads of the same file are coalesced into one writev/pwritev or readv/preadv.
+ * Ring is not thread-safe, every journaling or egress thread should use its own ring
+ */
+class IoRing {
+ public:
+  // Offset for reading or writing at current position of file or for sockets and pipes
+  static constexpr int64_t kCurrentPosition = -1;
+
+  struct Options {
+    Options()
+        : entries{256}
+        , buffers_count{64}
+        , buffer_size{64 * 1024}
+        , alignment{static_cast<AlignMemory>(sizeof(int))}
+        , use_uring{true} {
+    }
+
+    uint32_t entries;
+    uint32_t buffers_count;
+    size_t buffer_size;
+    AlignMemory alignment;
+    bool use_uring;
+  };
+
+  /**
+   * Buffer from registered pool, it packs directly to memory which is used by kernel.
+   * Buffer is handed over to ring by write(), afterwards it is empty and could be acquired again
+   */
+  class Buffer : public PackBuffer {
+   public:
+    explicit Buffer(IoRing & _ring)
+        : PackBuffer(nullptr, 0, _ring.options_.alignment)
+        , ring_(_ring)
+        , slot_{kNoSlot} {
+      acquire();
+    }
+
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    ~Buffer() {
+      if (slot_ != kNoSlot) {
+        ring_.releaseSlot(slot_);
+      }
+    }
+
+    /**
+     * Method for taking of free buffer from pool if this buffer is empty
+     * @return Return true if buffer has memory, false if pool is exhausted
+     */
+    bool acquire() {
+      if (slot_ == kNoSlot) {
+        slot_ = ring_.acquireSlot();
+        if (slot_ != kNoSlot) {
+          reset();
+          rebind(ring_.getSlotData(slot_), ring_.options_.buffer_size);
+        }
+      }
+      return slot_ != kNoSlot;
+    }
+
+    bool isValid() const {
+      return slot_ != kNoSlot;
+    }
+
+   private:
+    friend class IoRing;
+
+    uint32_t detach() {
+      const uint32_t kSlot = slot_;
+      slot_ = kNoSlot;
+      reset();
+      rebind(nullptr, 0);
+      return kSlot;
+    }
+
+    IoRing & ring_;
+    uint32_t slot_;
+  };
+
+  /**
+   * Result of finished operation, valid only inside of callback of poll()
+   */
+  class Completion {
+   public:
+    uint64_t getUserData() const {
+      return user_data_;
+    }
+
+    /**
+     * Method for getting result of operation
+     * @return Number of transferred bytes or negative errno
+     */
+    int32_t getResult() const {
+      return result_;
+    }
+
+    bool isRead() const {
+      return is_read_;
+    }
+
+    /**
+     * Method for getting of data read by operation
+     * @return Unpack buffer over read bytes, empty for writes and failed reads
+     */
+    UnpackBuffer getUnpackBuffer() const {
+      const size_t kSize = (is_read_ && result_ > 0) ? static_cast<size_t>(result_) : 0;
+      return UnpackBuffer(p_data_, kSize, alignment_);
+    }
+
+   private:
+    friend class IoRing;
+
+    Completion(const uint64_t _userData, const int32_t _result, const bool _isRead,
+               uint8_t const * _pData, AlignMemory _alignment)
+        : user_data_{_userData}
+        , result_{_result}
+        , is_read_{_isRead}
+        , p_data_(_pData)
+        , alignment_{_alignment} {
+    }
+
+    uint64_t user_data_;
+    int32_t result_;
+    bool is_read_;
+    uint8_t const * p_data_;
+    AlignMemory alignment_;
+  };
+
+  explicit IoRing(const Options & _options = Options())
+      : options_(_options)
+      , p_buffers_{nullptr}
+      , ring_fd_{-1}
+      , is_fixed_{false}
+      , p_sq_ring_{nullptr}
+      , sq_ring_size_{0}
+      , p_cq_ring_{nullptr}
+      , cq_ring_size_{0}
+      , p_sqes_{nullptr}
+      , sq_tail_{0}
+      , to_submit_{0}
+      , inflight_{0} {
+    const size_t kSize = options_.buffer_size * options_.buffers_count;
+    void * pMap = (kSize > 0)
+                  ? ::mmap(nullptr, kSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+                  : MAP_FAILED;
+    if (pMap != MAP_FAILED) {
+      p_buffers_ = static_cast<uint8_t *>(pMap);
+      slots_.resize(options_.buffers_count);
+      for (uint32_t i = options_.buffers_count; i > 0; --i) {
+        free_slots_.push_back(i - 1);
+      }
+      if (options_.use_uring) {
+        openUring();
+      }
+    }
+  }
+
+  IoRing(const IoRing&) = delete;
+  IoRing& operator=(const IoRing&) = delete;
+
+  /**
+   * Destructor, operations in flight are waited for, because kernel still uses their buffers
+   */
+  ~IoRing() {
+    while (inflight_ > 0 && poll([](const Completion &) {}, 1) > 0) {
+    }
+    closeUring();
+    if (p_buffers_) {
+      ::munmap(p_buffers_, options_.buffer_size * options_.buffers_count);
+    }
+  }
+
+  /**
+   * Method for checking that pool of buffers is allocated
+   */
+  bool isOpen() const {
+    return p_buffers_ != nullptr;
+  }
+
+  /**
+   * Method for checking whether operations go through io_uring or through fallback
+   */
+  bool isUringEnabled() const {
+    return ring_fd_ >= 0;
+  }
+
+  /**
+   * Method for checking whether pool of buffers is registered in kernel
+   */
+  bool isFixed() const {
+    return is_fixed_;
+  }
+
+  /**
+   * Method for queueing of write of packed buffer, buffer is handed over to ring
+   * @param _fd File or socket
+   * @param _buffer Packed buffer from this ring, it is empty after call
+   * @param _offset Offset in file or kCurrentPosition
+   * @param _userData Value which is returned in completion
+   * @return Return true if operation is queued, false otherwise
+   */
+  bool write(const int _fd, Buffer & _buffer, const int64_t _offset, const uint64_t _userData) {
+    bool result = false;
+    if (_buffer.isValid() && &_buffer.ring_ == this) {
+      const size_t kSize = _buffer.getDataSize();
+      result = enqueue(_buffer.detach(), Operation{_userData, _offset, kSize, _fd, false, 0});
+    }
+    return result;
+  }
+
+  /**
+   * Method for queueing of read to buffer from pool
+   * @param _fd File or socket
+   * @param _size Maximal number of bytes to read, limited by size of buffer
+   * @param _offset Offset in file or kCurrentPosition
+   * @param _userData Value which is returned in completion
+   * @return Return true if operation is queued, false if pool is exhausted
+   */
+  bool read(const int _fd, const size_t _size, const int64_t _offset, const uint64_t _userData) {
+    bool result = false;
+    const uint32_t kSlot = acquireSlot();
+    if (kSlot != kNoSlot) {
+      const size_t kSize = (_size < options_.buffer_size) ? _size : options_.buffer_size;
+      result = enqueue(kSlot, Operation{_userData, _offset, kSize, _fd, true, 0});
+    }
+    return result;
+  }
+
+  /**
+   * Method for submitting of all queued operations with one system call
+   * @return Return false if submitting failed (errno is set), true otherwise
+   */
+  bool submit() {
+    return isUringEnabled() ? enter(0) : execute();
+  }
+
+  /**
+   * Method for submitting of queued operations and handling of finished ones
+   * @tparam F Type of function with signature void(const Completion & completion)
+   * @param _fn Callback of finished operation, buffer of operation returns to pool after it
+   * @param _minCompletions Number of completions to wait for, 0 does not block
+   * @return Number of handled completions
+   */
+  template <typename F>
+  size_t poll(F && _fn, const size_t _minCompletions = 0) {
+    size_t result = 0;
+    const uint32_t kWait = static_cast<uint32_t>((_minCompletions < inflight_) ? _minCompletions : inflight_);
+    if (isUringEnabled()) {
+      if (to_submit_ > 0 || kWait > 0) {
+        enter(kWait);
+      }
+      result = reapUring(_fn);
+    } else {
+      execute();
+      result = reapFallback(_fn);
+    }
+    return result;
+  }
+
+  /**
+   * Method for getting number of queued and not yet handled operations
+   */
+  size_t getInflightCount() const {
+    return inflight_;
+  }
+
+  size_t getFreeBuffersCount() const {
+    return free_slots_.size();
+  }
+
+ private:
+  static constexpr uint32_t kNoSlot = UINT32_MAX;
+  static constexpr size_t kMaxIovecs = IOV_MAX;
+
+  struct Operation {
+    uint64_t user_data;
+    int64_t offset;
+    size_t size;
+    int fd;
+    bool is_read;
+    int32_t result;
+  };
+
+  uint8_t * getSlotData(const uint32_t _slot) const {
+    return p_buffers_ + static_cast<size_t>(_slot) * options_.buffer_size;
+  }
+
+  uint32_t acquireSlot() {
+    uint32_t result = kNoSlot;
+    if (!free_slots_.empty()) {
+      result = free_slots_.back();
+      free_slots_.pop_back();
+    }
+    return result;
+  }
+
+  void releaseSlot(const uint32_t _slot) {
+    free_slots_.push_back(_slot);
+  }
+
+  bool enqueue(const uint32_t _slot, const Operation & _operation) {
+    slots_[_slot] = _operation;
+    bool result = isUringEnabled() ? prepare(_slot) : true;
+    if (result) {
+      if (!isUringEnabled()) {
+        queued_.push_back(_slot);
+      }
+      ++inflight_;
+    } else {
+      releaseSlot(_slot);
+    }
+    return result;
+  }
+
+  /**
+   * Method for executing of queued operations synchronously, writes or reads of the same file
+   * with contiguous offsets are done by one writev/pwritev or readv/preadv
+   */
+  bool execute() {
+    bool result = true;
+    size_t i = 0;
+    while (i < queued_.size()) {
+      const Operation & kFirst = slots_[queued_[i]];
+      size_t end = i + 1;
+      int64_t next = (kFirst.offset == kCurrentPosition) ? kCurrentPosition : kFirst.offset + kFirst.size;
+      while (end < queued_.size() && end - i < kMaxIovecs) {
+        const Operation & kNext = slots_[queued_[end]];
+        if (kNext.is_read != kFirst.is_read || kNext.fd != kFirst.fd || kNext.offset != next) {
+          break;
+        }
+        next = (next == kCurrentPosition) ? kCurrentPosition : next + kNext.size;
+        ++end;
+      }
+      if (kFirst.is_read) {
+        readBatch(i, end);
+      } else {
+        writeBatch(i, end);
+      }
+      for (size_t k = i; k < end; ++k) {
+        result = result && slots_[queued_[k]].result >= 0;
+        completed_.push_back(queued_[k]);
+      }
+      i = end;
+    }
+    queued_.clear();
+    return result;
+  }
+
+  void writeBatch(const size_t _begin, const size_t _end) {
+    iovecs_.clear();
+    for (size_t k = _begin; k < _end; ++k) {
+      iovecs_.push_back(iovec{getSlotData(queued_[k]), slots_[queued_[k]].size});
+      slots_[queued_[k]].result = 0;
+    }
+    const int kFd = slots_[queued_[_begin]].fd;
+    int64_t offset = slots_[queued_[_begin]].offset;
+    const bool kIsSocket = (offset == kCurrentPosition) && isSocket(kFd);
+    size_t first = 0;
+    while (first < iovecs_.size()) {
+      const int kCount = static_cast<int>(iovecs_.size() - first);
+      ssize_t kWritten;
+      if (kIsSocket) {
+        // MSG_NOSIGNAL, otherwise reset by peer raises SIGPIPE for the whole process
+        msghdr msg{};
+        msg.msg_iov = iovecs_.data() + first;
+        msg.msg_iovlen = static_cast<size_t>(kCount);
+        kWritten = ::sendmsg(kFd, &msg, MSG_NOSIGNAL);
+      } else if (offset == kCurrentPosition) {
+        kWritten = ::writev(kFd, iovecs_.data() + first, kCount);
+      } else {
+        kWritten = ::pwritev(kFd, iovecs_.data() + first, kCount, offset);
+      }
+      if (kWritten < 0 && errno == EINTR) {
+        continue;
+      }
+      if (kWritten <= 0) {
+        // Operations which were not written at all report error, partially written one reports its bytes
+        const int32_t kError = (kWritten < 0) ? -errno : -EIO;
+        for (size_t k = first; k < iovecs_.size(); ++k) {
+          Operation & operation = slots_[queued_[_begin + k]];
+          if (operation.result == 0) {
+            operation.result = kError;
+          }
+        }
+        break;
+      }
+      if (offset != kCurrentPosition) {
+        offset += kWritten;
+      }
+      size_t left = static_cast<size_t>(kWritten);
+      while (left > 0) {
+        iovec & vector = iovecs_[first];
+        const size_t kPart = (left < vector.iov_len) ? left : vector.iov_len;
+        slots_[queued_[_begin + first]].result += static_cast<int32_t>(kPart);
+        vector.iov_base = static_cast<uint8_t *>(vector.iov_base) + kPart;
+        vector.iov_len -= kPart;
+        left -= kPart;
+        if (vector.iov_len == 0) {
+          ++first;
+        }
+      }
+    }
+  }
+
+  /**
+   * Method for reading of contiguous operations by readv/preadv. Operation which is read partially
+   * completes with its bytes as single read would and the next operations are read by the next call
+   */
+  void readBatch(const size_t _begin, const size_t _end) {
+    iovecs_.clear();
+    for (size_t k = _begin; k < _end; ++k) {
+      iovecs_.push_back(iovec{getSlotData(queued_[k]), slots_[queued_[k]].size});
+      slots_[queued_[k]].result = 0;
+    }
+    const int kFd = slots_[queued_[_begin]].fd;
+    int64_t offset = slots_[queued_[_begin]].offset;
+    size_t first = 0;
+    while (first < iovecs_.size()) {
+      const int kCount = static_cast<int>(iovecs_.size() - first);
+      const ssize_t kRead = (offset == kCurrentPosition)
+                            ? ::readv(kFd, iovecs_.data() + first, kCount)
+                            : ::preadv(kFd, iovecs_.data() + first, kCount, offset);
+      if (kRead < 0 && errno == EINTR) {
+        continue;
+      }
+      if (kRead <= 0) {
+        // End of file completes the rest with 0 bytes, error is reported by every operation
+        const int32_t kResult = (kRead < 0) ? -errno : 0;
+        for (size_t k = first; k < iovecs_.size(); ++k) {
+          slots_[queued_[_begin + k]].result = kResult;
+        }
+        break;
+      }
+      if (offset != kCurrentPosition) {
+        offset += kRead;
+      }
+      size_t left = static_cast<size_t>(kRead);
+      while (left > 0 && left >= iovecs_[first].iov_len) {
+        slots_[queued_[_begin + first]].result = static_cast<int32_t>(iovecs_[first].iov_len);
+        left -= iovecs_[first].iov_len;
+        ++first;
+      }
+      if (left > 0) {
+        slots_[queued_[_begin + first]].result = static_cast<int32_t>(left);
+        ++first;
+      }
+    }
+  }
+
+  static bool isSocket(const int _fd) {
+    int type = 0;
+    socklen_t typeLen = sizeof(type);
+    return ::getsockopt(_fd, SOL_SOCKET, SO_TYPE, &type, &typeLen) == 0;
+  }
+
+  template <typename F>
+  size_t reapFallback(F & _fn) {
+    size_t result = 0;
+    for (const uint32_t kSlot : completed_) {
+      const Operation & kOperation = slots_[kSlot];
+      _fn(Completion(kOperation.user_data, kOperation.result, kOperation.is_read,
+                     getSlotData(kSlot), options_.alignment));
+      releaseSlot(kSlot);
+      --inflight_;
+      ++result;
+    }
+    completed_.clear();
+    return result;
+  }
+
+#ifdef BUFFERS_HAS_IO_URING
+  static std::atomic<uint32_t> & ringValue(void * _pRing, const uint32_t _offset) {
+    return *reinterpret_cast<std::atomic<uint32_t> *>(static_cast<uint8_t *>(_pRing) + _offset);
+  }
+
+  void openUring() {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    // Completion queue fits completions of all buffers, so it never overflows
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = (options_.buffers_count > 2 * options_.entries)
+                        ? options_.buffers_count : 2 * options_.entries;
+    ring_fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, options_.entries, &params));
+    if (ring_fd_ < 0) {
+      return;
+    }
+    params_ = params;
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      sq_ring_size_ = cq_ring_size_ = (sq_ring_size_ > cq_ring_size_) ? sq_ring_size_ : cq_ring_size_;
+    }
+    p_sq_ring_ = mapRing(sq_ring_size_, IORING_OFF_SQ_RING);
+    p_cq_ring_ = (params.features & IORING_FEAT_SINGLE_MMAP) ? p_sq_ring_ : mapRing(cq_ring_size_, IORING_OFF_CQ_RING);
+    p_sqes_ = static_cast<io_uring_sqe *>(mapRing(params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES));
+    if (p_sq_ring_ == nullptr || p_cq_ring_ == nullptr || p_sqes_ == nullptr) {
+      closeUring();
+      return;
+    }
+    sq_tail_ = ringValue(p_sq_ring_, params.sq_off.tail).load(std::memory_order_relaxed);
+    std::vector<iovec> buffers(options_.buffers_count);
+    for (uint32_t i = 0; i < options_.buffers_count; ++i) {
+      buffers[i] = iovec{getSlotData(i), options_.buffer_size};
+    }
+    // Registration could fail because of limit of locked memory, then plain reads and writes are used
+    is_fixed_ = ::syscall(__NR_io_uring_register, ring_fd_, IORING_REGISTER_BUFFERS,
+                          buffers.data(), options_.buffers_count) == 0;
+  }
+
+  void * mapRing(const size_t _size, const off_t _offset) {
+    void * pMap = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, _offset);
+    return (pMap != MAP_FAILED) ? pMap : nullptr;
+  }
+
+  void closeUring() {
+    if (p_sqes_) {
+      ::munmap(p_sqes_, params_.sq_entries * sizeof(io_uring_sqe));
+      p_sqes_ = nullptr;
+    }
+    if (p_cq_ring_ && p_cq_ring_ != p_sq_ring_) {
+      ::munmap(p_cq_ring_, cq_ring_size_);
+    }
+    p_cq_ring_ = nullptr;
+    if (p_sq_ring_) {
+      ::munmap(p_sq_ring_, sq_ring_size_);
+      p_sq_ring_ = nullptr;
+    }
+    if (ring_fd_ >= 0) {
+      ::close(ring_fd_);
+      ring_fd_ = -1;
+    }
+    is_fixed_ = false;
+  }
+
+  /**
+   * Method for filling of submission queue entry, full submission queue is submitted first
+   */
+  bool prepare(const uint32_t _slot) {
+    const uint32_t kEntries = params_.sq_entries;
+    if (sq_tail_ - ringValue(p_sq_ring_, params_.sq_off.head).load(std::memory_order_acquire) >= kEntries &&
+        !enter(0)) {
+      return false;
+    }
+    const Operation & kOperation = slots_[_slot];
+    const uint32_t kIndex = sq_tail_ & ringValue(p_sq_ring_, params_.sq_off.ring_mask).load(std::memory_order_relaxed);
+    io_uring_sqe & sqe = p_sqes_[kIndex];
+    std::memset(&sqe, 0, sizeof(sqe));
+    if (is_fixed_) {
+      sqe.opcode = kOperation.is_read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+      sqe.buf_index = static_cast<uint16_t>(_slot);
+    } else {
+      sqe.opcode = kOperation.is_read ? IORING_OP_READ : IORING_OP_WRITE;
+    }
+    sqe.fd = kOperation.fd;
+    sqe.off = static_cast<uint64_t>(kOperation.offset);
+    sqe.addr = reinterpret_cast<uint64_t>(getSlotData(_slot));
+    sqe.len = static_cast<uint32_t>(kOperation.size);
+    sqe.user_data = _slot;
+    uint32_t * pArray = reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(p_sq_ring_) + params_.sq_off.array);
+    pArray[kIndex] = kIndex;
+    ++sq_tail_;
+    ++to_submit_;
+    ringValue(p_sq_ring_, params_.sq_off.tail).store(sq_tail_, std::memory_order_release);
+    return true;
+  }
+
+  bool enter(const uint32_t _minCompletions) {
+    bool result = true;
+    while (true) {
+      const unsigned kFlags = (_minCompletions > 0) ? IORING_ENTER_GETEVENTS : 0;
+      const long kSubmitted = ::syscall(__NR_io_uring_enter, ring_fd_, to_submit_, _minCompletions,
+                                        kFlags, nullptr, 0);
+      if (kSubmitted >= 0) {
+        to_submit_ -= static_cast<uint32_t>(kSubmitted);
+        break;
+      } else if (errno != EINTR) {
+        result = false;
+        break;
+      }
+    }
+    return result;
+  }
+
+  template <typename F>
+  size_t reapUring(F & _fn) {
+    size_t result = 0;
+    std::atomic<uint32_t> & head = ringValue(p_cq_ring_, params_.cq_off.head);
+    const uint32_t kTail = ringValue(p_cq_ring_, params_.cq_off.tail).load(std::memory_order_acquire);
+    const uint32_t kMask = ringValue(p_cq_ring_, params_.cq_off.ring_mask).load(std::memory_order_relaxed);
+    io_uring_cqe * pCqes = reinterpret_cast<io_uring_cqe *>(static_cast<uint8_t *>(p_cq_ring_) + params_.cq_off.cqes);
+    for (uint32_t position = head.load(std::memory_order_relaxed); position != kTail; ++position) {
+      const io_uring_cqe & kCqe = pCqes[position & kMask];
+      const uint32_t kSlot = static_cast<uint32_t>(kCqe.user_data);
+      const Operation & kOperation = slots_[kSlot];
+      _fn(Completion(kOperation.user_data, kCqe.res, kOperation.is_read, getSlotData(kSlot), options_.alignment));
+      releaseSlot(kSlot);
+      --inflight_;
+      ++result;
+      head.store(position + 1, std::memory_order_release);
+    }
+    return result;
+  }
+#else
+  void openUring() {
+  }
+
+  void closeUring() {
+  }
+
+  bool prepare(const uint32_t) {
+    return false;
+  }
+
+  bool enter(const uint32_t) {
+    return false;
+  }
+
+  template <typename F>
+  size_t reapUring(F &) {
+    return 0;
+  }
+#endif
+
+  const Options options_;
+  uint8_t * p_buffers_;
+  std::vector<Operation> slots_;
+  std::vector<uint32_t> free_slots_;
+  std::vector<uint32_t> queued_;
+  std::vector<uint32_t> completed_;
+  std::vector<iovec> iovecs_;
+  int ring_fd_;
+  bool is_fixed_;
+#ifdef BUFFERS_HAS_IO_URING
+  io_uring_params params_;
+#endif
+  void * p_sq_ring_;
+  size_t sq_ring_size_;
+  void * p_cq_ring_;
+  size_t cq_ring_size_;
+#ifdef BUFFERS_HAS_IO_URING
+  io_uring_sqe * p_sqes_;
+#else
+  void * p_sqes_;
+#endif
+  uint32_t sq_tail_;
+  uint32_t to_submit_;
+  size_t inflight_;
+};
+}
+
+#endif //BUFFERS_IORING_HPP
@@ -0,0 +1,542 @@
+/**
+ * @file Journal.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains append-only journal of packed records with sparse index
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_JOURNAL_HPP
+#define BUFFERS_JOURNAL_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include "MmapPackBuffer.hpp"
+#include "MmapUnpackBuffer.hpp"
+
+namespace buffers {
+/**
+ * Layout of journal file:
+ *     Header | Record | Record | ... | Checkpoint | Record | ... | Checkpoint | Footer
+ * Every record starts with RecordHeader followed by packed data.
+ * Checkpoint is a record with sparse index entries added since previous checkpoint,
+ * Footer is written on close and points to the last checkpoint
+ */
+struct JournalFormat {
+  static constexpr uint32_t kHeaderMagic = 0x4A425550;  // "PUBJ"
+  static constexpr uint32_t kFooterMagic = 0x46425550;  // "PUBF"
+  static constexpr uint16_t kVersion = 1;
+
+  enum RecordType : uint32_t {
+    kUncommitted = 0,
+    kRecord = 1,
+    kCheckpoint = 2,
+  };
+
+  struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t alignment;
+    uint32_t index_interval;
+    uint32_t reserved;
+  };
+
+  struct RecordHeader {
+    uint32_t size;
+    uint32_t type;
+    uint64_t sequence;
+  };
+
+  struct IndexEntry {
+    uint64_t sequence;
+    uint64_t offset;
+  };
+
+  struct Footer {
+    uint64_t checkpoint_offset;
+    uint32_t magic;
+    uint32_t reserved;
+  };
+
+  template <typename T>
+  static T read(uint8_t const * _pData) {
+    T result;
+    std::memcpy(&result, _pData, sizeof(T));
+    return result;
+  }
+};
+
+/**
+ * Writer of append-only journal.
+ * Records are packed directly to the memory-mapped file,
+ * sequence numbers should be strictly increasing
+ */
+class JournalWriter {
+ public:
+  /**
+   * Constructor which creates new journal file
+   * @param _path Path to the journal file
+   * @param _indexInterval Number of records between sparse index entries
+   * @param _checkpointInterval Number of index entries between checkpoints
+   * @param _alignment Alignment of packed records
+   */
+  JournalWriter(const std::string & _path,
+                const uint32_t _indexInterval = 64,
+                const uint32_t _checkpointInterval = 1024,
+                AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : buffer_(_path, MmapPackBuffer::kDefaultSize, _alignment)
+      , index_interval_{_indexInterval > 0 ? _indexInterval : 1}
+      , checkpoint_interval_{_checkpointInterval > 0 ? _checkpointInterval : 1}
+      , num_records_{0}
+      , last_sequence_{0}
+      , record_offset_{0}
+      , last_checkpoint_offset_{0} {
+    if (buffer_.isOpen()) {
+      JournalFormat::Header header{};
+      header.magic = JournalFormat::kHeaderMagic;
+      header.version = JournalFormat::kVersion;
+      header.alignment = static_cast<uint16_t>(_alignment);
+      header.index_interval = index_interval_;
+      buffer_.put(header);
+    }
+  }
+
+  JournalWriter(const JournalWriter&) = delete;
+  JournalWriter& operator=(const JournalWriter&) = delete;
+
+  ~JournalWriter() {
+    close();
+  }
+
+  /**
+   * Method for checking if journal file is opened
+   * @return Return true if journal is opened, false otherwise
+   */
+  bool isOpen() const {
+    return buffer_.isOpen();
+  }
+
+  /**
+   * Method for starting of new record, data of the record should be put to the returned buffer
+   * @param _sequence Sequence number of the record, should be more than previous one
+   * @return Pointer to the buffer for packing of record or nullptr if record could not be started
+   */
+  PackBuffer * beginRecord(const uint64_t _sequence) {
+    PackBuffer * result = nullptr;
+    if (isOpen() && record_offset_ == 0 &&
+        (num_records_ == 0 || _sequence > last_sequence_)) {
+      const size_t kOffset = buffer_.getDataSize();
+      JournalFormat::RecordHeader header{0, JournalFormat::kUncommitted, _sequence};
+      if (buffer_.put(header)) {
+        record_offset_ = kOffset;
+        result = &buffer_;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for committing of record started by beginRecord()
+   * @return Return true if record is committed, false otherwise.
+   *         Record larger than UINT32_MAX bytes does not fit to its header and is dropped
+   */
+  bool commitRecord() {
+    bool result = false;
+    if (record_offset_ != 0 &&
+        buffer_.getDataSize() - record_offset_ - sizeof(JournalFormat::RecordHeader) > UINT32_MAX) {
+      abortRecord();
+    } else if (record_offset_ != 0) {
+      const size_t kOffset = record_offset_;
+      const size_t kSize = buffer_.getDataSize() - kOffset - sizeof(JournalFormat::RecordHeader);
+      JournalFormat::RecordHeader header = JournalFormat::read<JournalFormat::RecordHeader>(
+          buffer_.getData() + kOffset);
+      header.size = static_cast<uint32_t>(kSize);
+      header.type = JournalFormat::kRecord;
+      result = buffer_.putAt(kOffset, header);
+      record_offset_ = 0;
+      if (num_records_ % index_interval_ == 0) {
+        pending_index_.push_back(JournalFormat::IndexEntry{header.sequence, kOffset});
+      }
+      ++num_records_;
+      last_sequence_ = header.sequence;
+      if (pending_index_.size() >= checkpoint_interval_) {
+        checkpoint();
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for dropping of record started by beginRecord()
+   */
+  void abortRecord() {
+    if (record_offset_ != 0) {
+      buffer_.reset(record_offset_);
+      record_offset_ = 0;
+    }
+  }
+
+  /**
+   * Method for appending record which consists of one value
+   * @tparam T Type of value
+   * @param _sequence Sequence number of the record, should be more than previous one
+   * @param _t Value for packing
+   * @return Return true if appending is succeed, false otherwise
+   */
+  template <typename T>
+  bool append(const uint64_t _sequence, const T & _t) {
+    bool result = false;
+    PackBuffer * pBuffer = beginRecord(_sequence);
+    if (pBuffer) {
+      if (pBuffer->put(_t)) {
+        result = commitRecord();
+      } else {
+        abortRecord();
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for writing checkpoint with sparse index entries collected since previous checkpoint
+   * @return Return true if checkpoint is written, false otherwise
+   */
+  bool checkpoint() {
+    bool result = false;
+    if (isOpen() && record_offset_ == 0) {
+      const size_t kOffset = buffer_.getDataSize();
+      JournalFormat::RecordHeader header{0, JournalFormat::kUncommitted, last_sequence_};
+      result = buffer_.put(header) &&
+               buffer_.put(static_cast<uint64_t>(last_checkpoint_offset_)) &&
+               buffer_.put(static_cast<uint64_t>(pending_index_.size()));
+      for (size_t i = 0; result && i < pending_index_.size(); ++i) {
+        result = buffer_.put(pending_index_[i]);
+      }
+      if (result) {
+        header.size = static_cast<uint32_t>(buffer_.getDataSize() - kOffset - sizeof(header));
+        header.type = JournalFormat::kCheckpoint;
+        buffer_.putAt(kOffset, header);
+        last_checkpoint_offset_ = kOffset;
+        pending_index_.clear();
+      } else {
+        buffer_.reset(kOffset);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for flushing journal to the file
+   * @param _async Schedule flushing without waiting for it
+   * @return Return true if flushing is succeed, false otherwise
+   */
+  bool sync(const bool _async = false) {
+    return buffer_.sync(_async);
+  }
+
+  /**
+   * Method for closing journal, final checkpoint and footer are written
+   */
+  void close() {
+    if (isOpen()) {
+      abortRecord();
+      if (!pending_index_.empty() || last_checkpoint_offset_ == 0) {
+        checkpoint();
+      }
+      if (last_checkpoint_offset_ != 0) {
+        JournalFormat::Footer footer{last_checkpoint_offset_, JournalFormat::kFooterMagic, 0};
+        buffer_.put(footer);
+      }
+      buffer_.close();
+    }
+  }
+
+  /**
+   * Method for getting number of committed records
+   * @return Number of committed records
+   */
+  uint64_t getRecordsCount() const {
+    return num_records_;
+  }
+
+  /**
+   * Method for getting sequence number of last committed record
+   * @return Sequence number of last committed record
+   */
+  uint64_t getLastSequence() const {
+    return last_sequence_;
+  }
+
+ private:
+  MmapPackBuffer buffer_;
+  const uint32_t index_interval_;
+  const uint32_t checkpoint_interval_;
+  uint64_t num_records_;
+  uint64_t last_sequence_;
+  size_t record_offset_;
+  size_t last_checkpoint_offset_;
+  std::vector<JournalFormat::IndexEntry> pending_index_;
+};
+
+/**
+ * Reader of append-only journal.
+ * Sparse index is loaded from checkpoints, if journal was not closed properly
+ * index is rebuilt by scanning of record headers
+ */
+class JournalReader {
+ public:
+  /**
+   * Forward iterator over committed records, checkpoints are skipped
+   */
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = UnpackBuffer;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = UnpackBuffer;
+
+    Iterator(const JournalReader & _reader, const size_t _offset)
+        : reader_(&_reader)
+        , offset_{_offset} {
+      skipCheckpoints();
+    }
+
+    /**
+     * Method for getting unpack buffer of current record, data is read directly from the mapping
+     * @return Unpack buffer of current record
+     */
+    UnpackBuffer operator*() const {
+      const JournalFormat::RecordHeader kHeader = header();
+      return UnpackBuffer(reader_->data() + offset_ + sizeof(kHeader), kHeader.size,
+                          reader_->alignment_);
+    }
+
+    /**
+     * Method for getting sequence number of current record
+     * @return Sequence number of current record
+     */
+    uint64_t sequence() const {
+      return header().sequence;
+    }
+
+    /**
+     * Method for getting offset of current record in journal file
+     * @return Offset of current record
+     */
+    size_t offset() const {
+      return offset_;
+    }
+
+    Iterator & operator++() {
+      offset_ = reader_->next(offset_);
+      skipCheckpoints();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator result = *this;
+      ++(*this);
+      return result;
+    }
+
+    bool operator==(const Iterator & _other) const {
+      return offset_ == _other.offset_;
+    }
+
+    bool operator!=(const Iterator & _other) const {
+      return offset_ != _other.offset_;
+    }
+
+   private:
+    JournalFormat::RecordHeader header() const {
+      return JournalFormat::read<JournalFormat::RecordHeader>(reader_->data() + offset_);
+    }
+
+    void skipCheckpoints() {
+      while (offset_ < reader_->end_offset_ &&
+             header().type == JournalFormat::kCheckpoint) {
+        offset_ = reader_->next(offset_);
+      }
+    }
+
+    const JournalReader * reader_;
+    size_t offset_;
+  };
+
+  /**
+   * Constructor which maps journal file and loads sparse index
+   * @param _path Path to the journal file
+   */
+  explicit JournalReader(const std::string & _path)
+      : buffer_(_path)
+      , alignment_{static_cast<AlignMemory>(sizeof(int))}
+      , begin_offset_{0}
+      , end_offset_{0} {
+    if (buffer_.getDataSize() >= sizeof(JournalFormat::Header)) {
+      const auto kHeader = JournalFormat::read<JournalFormat::Header>(data());
+      // Alignment is used as divisor, so journal with unknown alignment is not opened
+      if (kHeader.magic == JournalFormat::kHeaderMagic &&
+          kHeader.version == JournalFormat::kVersion && isValidAlignment(kHeader.alignment)) {
+        alignment_ = static_cast<AlignMemory>(kHeader.alignment);
+        begin_offset_ = sizeof(JournalFormat::Header);
+        if (!loadIndex()) {
+          rebuildIndex(kHeader.index_interval);
+        }
+      }
+    }
+  }
+
+  /**
+   * Method for checking if journal is valid
+   * @return Return true if journal is valid, false otherwise
+   */
+  bool isOpen() const {
+    return begin_offset_ != 0;
+  }
+
+  Iterator begin() const {
+    return Iterator(*this, begin_offset_);
+  }
+
+  Iterator end() const {
+    return Iterator(*this, end_offset_);
+  }
+
+  /**
+   * Method for searching of the first record with sequence number not less than given one.
+   * Sparse index is searched by binary search, then at most index interval records are scanned
+   * @param _sequence Sequence number to search
+   * @return Iterator to found record or end() if there is no such record
+   */
+  Iterator seek(const uint64_t _sequence) const {
+    auto entry = std::upper_bound(index_.begin(), index_.end(), _sequence,
+                                  [](const uint64_t _seq, const JournalFormat::IndexEntry & _entry) {
+                                    return _seq < _entry.sequence;
+                                  });
+    Iterator result(*this, (entry == index_.begin())
+                           ? begin_offset_
+                           : static_cast<size_t>((entry - 1)->offset));
+    const Iterator kEnd = end();
+    while (result != kEnd && result.sequence() < _sequence) {
+      ++result;
+    }
+    return result;
+  }
+
+  /**
+   * Method for getting sparse index of journal
+   * @return Sparse index sorted by sequence number
+   */
+  const std::vector<JournalFormat::IndexEntry> & getIndex() const {
+    return index_;
+  }
+
+ private:
+  uint8_t const * data() const {
+    return buffer_.getData();
+  }
+
+  /**
+   * Method for getting offset of the record which follows record at given offset
+   */
+  size_t next(const size_t _offset) const {
+    const auto kHeader = JournalFormat::read<JournalFormat::RecordHeader>(data() + _offset);
+    const size_t kNext = _offset + sizeof(kHeader) + getAlignedSize(kHeader.size, alignment_);
+    return std::min(kNext, end_offset_);
+  }
+
+  /**
+   * Method for validation of record header at given offset
+   */
+  bool isRecord(const size_t _offset, const size_t _end) const {
+    bool result = false;
+    if (_offset + sizeof(JournalFormat::RecordHeader) <= _end) {
+      const auto kHeader = JournalFormat::read<JournalFormat::RecordHeader>(data() + _offset);
+      result = (kHeader.type == JournalFormat::kRecord || kHeader.type == JournalFormat::kCheckpoint) &&
+               (_offset + sizeof(kHeader) + kHeader.size <= _end);
+    }
+    return result;
+  }
+
+  /**
+   * Method for loading sparse index from the chain of checkpoints
+   */
+  bool loadIndex() {
+    bool result = false;
+    const size_t kSize = buffer_.getDataSize();
+    if (kSize >= begin_offset_ + sizeof(JournalFormat::Footer)) {
+      const size_t kFooterOffset = kSize - sizeof(JournalFormat::Footer);
+      const auto kFooter = JournalFormat::read<JournalFormat::Footer>(data() + kFooterOffset);
+      if (kFooter.magic == JournalFormat::kFooterMagic) {
+        result = true;
+        std::vector<std::vector<JournalFormat::IndexEntry>> checkpoints;
+        size_t offset = static_cast<size_t>(kFooter.checkpoint_offset);
+        while (result && offset != 0) {
+          result = (offset >= begin_offset_) && isRecord(offset, kFooterOffset);
+          if (result) {
+            UnpackBuffer checkpoint = checkpointData(offset);
+            const size_t kOffset = offset;
+            offset = static_cast<size_t>(checkpoint.get<uint64_t>());
+            const auto kCount = checkpoint.get<uint64_t>();
+            // Checkpoints are chained backwards, so corrupted chain could not loop
+            result = (offset < kOffset) &&
+                     (kCount <= checkpoint.getBufferSize() / sizeof(JournalFormat::IndexEntry));
+            checkpoints.emplace_back();
+            for (uint64_t i = 0; result && i < kCount; ++i) {
+              checkpoints.back().push_back(checkpoint.get<JournalFormat::IndexEntry>());
+            }
+          }
+        }
+        if (result) {
+          for (auto chunk = checkpoints.rbegin(); chunk != checkpoints.rend(); ++chunk) {
+            index_.insert(index_.end(), chunk->begin(), chunk->end());
+          }
+          end_offset_ = kFooterOffset;
+        }
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for rebuilding sparse index by scanning of records, used if footer is absent
+   */
+  void rebuildIndex(const uint32_t _indexInterval) {
+    const size_t kSize = buffer_.getDataSize();
+    const uint32_t kInterval = _indexInterval > 0 ? _indexInterval : 1;
+    index_.clear();
+    end_offset_ = kSize;
+    uint64_t numRecords = 0;
+    size_t offset = begin_offset_;
+    while (isRecord(offset, kSize)) {
+      const auto kHeader = JournalFormat::read<JournalFormat::RecordHeader>(data() + offset);
+      if (kHeader.type == JournalFormat::kRecord) {
+        if (numRecords % kInterval == 0) {
+          index_.push_back(JournalFormat::IndexEntry{kHeader.sequence, offset});
+        }
+        ++numRecords;
+      }
+      offset = next(offset);
+    }
+    end_offset_ = offset;
+  }
+
+  UnpackBuffer checkpointData(const size_t _offset) const {
+    const auto kHeader = JournalFormat::read<JournalFormat::RecordHeader>(data() + _offset);
+    return UnpackBuffer(data() + _offset + sizeof(kHeader), kHeader.size, alignment_);
+  }
+
+  MmapUnpackBuffer buffer_;
+  AlignMemory alignment_;
+  size_t begin_offset_;
+  size_t end_offset_;
+  std::vector<JournalFormat::IndexEntry> index_;
+};
+}
+
+#endif //BUFFERS_JOURNAL_HPP
@@ -0,0 +1,154 @@
+/**
+ * @file MessageRegistry.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains compile-time registry of message types and constant time decode dispatch
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_MESSAGEREGISTRY_HPP
+#define BUFFERS_MESSAGEREGISTRY_HPP
+
+#include <stdint.h>
+#include <array>
+#include <type_traits>
+#include <utility>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+using MessageId = uint16_t;
+
+/**
+ * Trait with stable identifier of message type, should be specialized for every registered type:
+ *     template <>
+ *     struct MessageTypeId<MyMessage> {
+ *       static constexpr MessageId value = 1;
+ *     };
+ * Identifiers should be dense, jump table of dispatch has an entry for every identifier till maximal one
+ * @tparam T Type of message
+ */
+template <typename T>
+struct MessageTypeId;
+
+/**
+ * Helpers for checking of registered types at compile time
+ */
+template <typename... Types>
+struct MessageTypeList {
+  static constexpr MessageId kMaxId = 0;
+  static constexpr bool kUniqueIds = true;
+
+  template <typename T>
+  static constexpr bool contains() {
+    return false;
+  }
+
+  static constexpr size_t countId(const MessageId) {
+    return 0;
+  }
+};
+
+template <typename T, typename... Rest>
+struct MessageTypeList<T, Rest...> {
+  static constexpr MessageId kMaxId = (MessageTypeId<T>::value > MessageTypeList<Rest...>::kMaxId)
+                                      ? MessageTypeId<T>::value
+                                      : MessageTypeList<Rest...>::kMaxId;
+  static constexpr bool kUniqueIds = (MessageTypeList<Rest...>::countId(MessageTypeId<T>::value) == 0) &&
+                                     MessageTypeList<Rest...>::kUniqueIds;
+
+  template <typename U>
+  static constexpr bool contains() {
+    return std::is_same<T, U>::value || MessageTypeList<Rest...>::template contains<U>();
+  }
+
+  static constexpr size_t countId(const MessageId _id) {
+    return (MessageTypeId<T>::value == _id ? 1 : 0) + MessageTypeList<Rest...>::countId(_id);
+  }
+};
+
+/**
+ * Registry of message types. Message is packed as its identifier followed by the message itself,
+ * received buffer is dispatched to handler by identifier through jump table, so cost of dispatch
+ * does not depend on number of registered types.
+ * Messages are packed and unpacked with DelegatePackBuffer and DelegateUnpackBuffer
+ * @tparam Types Registered types of messages
+ */
+template <typename... Types>
+class MessageRegistry {
+  using TypeList = MessageTypeList<Types...>;
+  static_assert(TypeList::kUniqueIds, "Identifiers of registered message types are not unique !!");
+
+ public:
+  /**
+   * Method for getting identifier of registered type
+   * @tparam T Type of message
+   * @return Identifier of type
+   */
+  template <typename T>
+  static constexpr MessageId getId() {
+    return MessageTypeId<T>::value;
+  }
+
+  /**
+   * Method for packing of message with its identifier
+   * @tparam T Type of message, should be registered
+   * @param _buffer Buffer for packing
+   * @param _message Message for packing
+   * @return Return true if packing is succeed, false otherwise
+   */
+  template <typename T>
+  static bool put(PackBuffer & _buffer, const T & _message) {
+    static_assert(TypeList::template contains<T>(), "Type T is not registered !!");
+    const size_t kDataSize = _buffer.getDataSize();
+    const MessageId kId = MessageTypeId<T>::value;
+    bool result = _buffer.put(kId) && _buffer.put(_message);
+    if (!result) {
+      _buffer.reset(kDataSize);
+    }
+    return result;
+  }
+
+  /**
+   * Method for unpacking of message and calling of handler with it
+   * @tparam Handler Type of handler, should be callable with every registered type
+   * @param _buffer Buffer with message packed by put()
+   * @param _handler Handler of message
+   * @return Return true if message is dispatched, false if identifier is unknown
+   */
+  template <typename Handler>
+  static bool dispatch(UnpackBuffer & _buffer, Handler && _handler) {
+    using HandlerType = typename std::remove_reference<Handler>::type;
+    static const DispatchTable<HandlerType> kTable = makeTable<HandlerType>();
+    bool result = false;
+    if (_buffer.getBufferSize() >= sizeof(MessageId)) {
+      const MessageId kId = _buffer.get<MessageId>();
+      if (kId <= TypeList::kMaxId && kTable[kId] != nullptr) {
+        kTable[kId](_buffer, _handler);
+        result = true;
+      }
+    }
+    return result;
+  }
+
+ private:
+  template <typename Handler>
+  using DispatchTable = std::array<void (*)(UnpackBuffer &, Handler &), TypeList::kMaxId + 1>;
+
+  template <typename T, typename Handler>
+  static void invoke(UnpackBuffer & _buffer, Handler & _handler) {
+    _handler(_buffer.get<T>());
+  }
+
+  template <typename Handler>
+  static DispatchTable<Handler> makeTable() {
+    DispatchTable<Handler> table;
+    table.fill(nullptr);
+    const int kUnused[] = {0, (table[MessageTypeId<Types>::value] = &invoke<Types, Handler>, 0)...};
+    (void)kUnused;
+    return table;
+  }
+};
+}
+
+#endif //BUFFERS_MESSAGEREGISTRY_HPP
@@ -0,0 +1,128 @@
+/**
+ * @file MmapPackBuffer.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains library for creating memory-mapped file based Pack Buffer
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_MMAPPACKBUFFER_HPP
+#define BUFFERS_MMAPPACKBUFFER_HPP
+
+#include <stdint.h>
+#include <string>
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "PackBuffer.hpp"
+
+namespace buffers {
+/**
+ * Pack buffer class based on memory-mapped file.
+ * Mapping grows with ftruncate + mremap when put needs more room,
+ * on destruction file is truncated to the size of packed data
+ */
+class MmapPackBuffer
+    : public PackBuffer {
+ public:
+  static constexpr size_t kDefaultSize = 1 << 20;
+
+  /**
+   * Constructor which creates (or truncates) file and maps it for packing
+   * @param _path Path to the file
+   * @param _size Initial size of mapping, rounded up to the page size
+   * @param _alignment Alignment of packed data
+   */
+  MmapPackBuffer(const std::string & _path,
+                 const size_t _size = kDefaultSize,
+                 AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : PackBuffer(nullptr, 0, _alignment)
+      , fd_{::open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)}
+      , map_size_{0} {
+    if (fd_ < 0 || !expand(_size > 0 ? _size : 1)) {
+#ifdef __cpp_exceptions
+      const int kError = errno;
+      close();
+      throw std::system_error(kError, std::system_category(), "Could not map file " + _path);
+#else
+      close();
+#endif
+    }
+  }
+
+  MmapPackBuffer(const MmapPackBuffer&) = delete;
+  MmapPackBuffer& operator=(const MmapPackBuffer&) = delete;
+
+  ~MmapPackBuffer() {
+    close();
+  }
+
+  /**
+   * Method for checking if file was successfully mapped
+   * @return Return true if file is mapped, false otherwise
+   */
+  bool isOpen() const {
+    return fd_ >= 0;
+  }
+
+  /**
+   * Method for flushing packed data to the file
+   * @param _async Schedule flushing without waiting for it
+   * @return Return true if flushing is succeed, false otherwise
+   */
+  bool sync(const bool _async = false) {
+    bool result = false;
+    if (isOpen()) {
+      result = (::msync(p_buf_, map_size_, _async ? MS_ASYNC : MS_SYNC) == 0);
+    }
+    return result;
+  }
+
+  /**
+   * Method for unmapping file, file is truncated to the size of packed data
+   */
+  void close() {
+    if (map_size_ > 0) {
+      ::munmap(p_buf_, map_size_);
+      map_size_ = 0;
+    }
+    if (fd_ >= 0) {
+      while (::ftruncate(fd_, getDataSize()) != 0 && errno == EINTR) {
+      }
+      ::close(fd_);
+      fd_ = -1;
+    }
+    reset();
+    rebind(nullptr, 0);
+  }
+
+ protected:
+  bool expand(const size_t _size) override {
+    bool result = false;
+    if (fd_ >= 0) {
+      const size_t kPageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+      size_t newSize = std::max(map_size_ * 2, getDataSize() + _size);
+      newSize = (newSize + kPageSize - 1) / kPageSize * kPageSize;
+      if (::ftruncate(fd_, newSize) == 0) {
+        void * pMap = (map_size_ == 0)
+                      ? ::mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0)
+                      : ::mremap(p_buf_, map_size_, newSize, MREMAP_MAYMOVE);
+        if (pMap != MAP_FAILED) {
+          map_size_ = newSize;
+          rebind(static_cast<uint8_t *>(pMap), map_size_);
+          result = true;
+        }
+      }
+    }
+    return result;
+  }
+
+ private:
+  int fd_;
+  size_t map_size_;
+};
+}
+
+#endif //BUFFERS_MMAPPACKBUFFER_HPP
@@ -0,0 +1,113 @@
+/**
+ * @file MmapUnpackBuffer.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains library for creating memory-mapped file based Unpack Buffer
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_MMAPUNPACKBUFFER_HPP
+#define BUFFERS_MMAPUNPACKBUFFER_HPP
+
+#include <stdint.h>
+#include <string>
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+/**
+ * Unpack buffer class based on read-only memory-mapped file.
+ * Data is unpacked directly from the page cache without reading it to the heap
+ */
+class MmapUnpackBuffer
+    : public UnpackBuffer {
+ public:
+  /**
+   * Constructor which maps file for unpacking
+   * @param _path Path to the file
+   * @param _advice Access pattern hint for madvise, sequential by default
+   * @param _alignment Alignment of packed data
+   */
+  MmapUnpackBuffer(const std::string & _path,
+                   const int _advice = MADV_SEQUENTIAL,
+                   AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : UnpackBuffer(nullptr, 0, _alignment)
+      , fd_{::open(_path.c_str(), O_RDONLY | O_CLOEXEC)}
+      , map_size_{0} {
+    struct stat fileStat;
+    bool result = (fd_ >= 0 && ::fstat(fd_, &fileStat) == 0);
+    if (result && fileStat.st_size > 0) {
+      void * pMap = ::mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd_, 0);
+      result = (pMap != MAP_FAILED);
+      if (result) {
+        map_size_ = static_cast<size_t>(fileStat.st_size);
+        ::madvise(pMap, map_size_, _advice);
+        rebind(static_cast<uint8_t const *>(pMap), map_size_);
+      }
+    }
+    if (!result) {
+#ifdef __cpp_exceptions
+      const int kError = errno;
+      close();
+      throw std::system_error(kError, std::system_category(), "Could not map file " + _path);
+#else
+      close();
+#endif
+    }
+  }
+
+  MmapUnpackBuffer(const MmapUnpackBuffer&) = delete;
+  MmapUnpackBuffer& operator=(const MmapUnpackBuffer&) = delete;
+
+  ~MmapUnpackBuffer() {
+    close();
+  }
+
+  /**
+   * Method for checking if file was successfully mapped
+   * @return Return true if file is mapped, false otherwise
+   */
+  bool isOpen() const {
+    return fd_ >= 0;
+  }
+
+  /**
+   * Method for changing access pattern hint of the mapping
+   * @param _advice Hint for madvise, for example MADV_RANDOM or MADV_WILLNEED
+   * @return Return true if hint is applied, false otherwise
+   */
+  bool advise(const int _advice) {
+    bool result = false;
+    if (map_size_ > 0) {
+      result = (::madvise(const_cast<uint8_t *>(getData()), map_size_, _advice) == 0);
+    }
+    return result;
+  }
+
+  /**
+   * Method for unmapping file
+   */
+  void close() {
+    if (map_size_ > 0) {
+      ::munmap(const_cast<uint8_t *>(getData()), map_size_);
+      map_size_ = 0;
+    }
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+    rebind(nullptr, 0);
+  }
+
+ private:
+  int fd_;
+  size_t map_size_;
+};
+}
+
+#endif //BUFFERS_MMAPUNPACKBUFFER_HPP
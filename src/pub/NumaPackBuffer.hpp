@@ -0,0 +1,259 @@
+/**
+ * @file NumaPackBuffer.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains NUMA-aware allocation of memory for pack buffers
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_NUMAPACKBUFFER_HPP
+#define BUFFERS_NUMAPACKBUFFER_HPP
+
+#include <stdint.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <system_error>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include "PackBuffer.hpp"
+
+namespace buffers {
+/**
+ * Placement of memory of buffer
+ */
+struct NumaOptions {
+  // Memory is placed by default policy of the process, usually on node which touches it first
+  static constexpr int kAnyNode = -1;
+  // Memory is placed on node of calling thread
+  static constexpr int kLocalNode = -2;
+
+  NumaOptions()
+      : node{kAnyNode}
+      , prefault{false}
+      , huge_pages{false} {
+  }
+
+  explicit NumaOptions(const int _node, const bool _prefault = false, const bool _hugePages = false)
+      : node{_node}
+      , prefault{_prefault}
+      , huge_pages{_hugePages} {
+  }
+
+  // Preferred node of memory, it should be node of consumer of buffer
+  int node;
+  // Touch all pages on allocation, so the first put does not pay for page faults
+  bool prefault;
+  // Ask for transparent huge pages, only buffers of at least kHugePageSize are affected
+  bool huge_pages;
+};
+
+/**
+ * Allocation of anonymous memory with NUMA policy. On machine with one node placement is no-op
+ */
+struct NumaMemory {
+  static constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+  static constexpr int kMaxNodes = 1024;
+
+  /**
+   * Method for getting number of NUMA nodes
+   * @return Number of nodes, 1 if system does not expose NUMA topology
+   */
+  static int getNodesCount() {
+    static const int kCount = readNodesCount();
+    return kCount;
+  }
+
+  /**
+   * Method for getting node of CPU which runs calling thread
+   * @return Node of calling thread, 0 if it is unknown
+   */
+  static int getCurrentNode() {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (::syscall(__NR_getcpu, &cpu, &node, nullptr) != 0) {
+      node = 0;
+    }
+    return static_cast<int>(node);
+  }
+
+  /**
+   * Method for getting node where page of address is placed
+   * @param _pAddress Address in touched page
+   * @return Node of page or -1 if it is unknown
+   */
+  static int getNodeOfAddress(const void * _pAddress) {
+    int node = -1;
+    if (::syscall(__NR_get_mempolicy, &node, nullptr, 0, _pAddress, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+      node = -1;
+    }
+    return node;
+  }
+
+  /**
+   * Method for getting size of mapping which is used for memory of given size
+   */
+  static size_t getMappingSize(const size_t _size, const NumaOptions & _options) {
+    const size_t kPage = isHuge(_size, _options) ? kHugePageSize : static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return (_size + kPage - 1) / kPage * kPage;
+  }
+
+  /**
+   * Method for allocating of zeroed memory
+   * @param _size Size of memory
+   * @param _options Placement of memory
+   * @return Pointer to memory or nullptr on failure
+   */
+  static uint8_t * allocate(const size_t _size, const NumaOptions & _options) {
+    const size_t kSize = getMappingSize(_size > 0 ? _size : 1, _options);
+    uint8_t * result = isHuge(_size, _options) ? mapHuge(kSize) : map(kSize);
+    if (result) {
+      const int kNode = (_options.node == NumaOptions::kLocalNode) ? getCurrentNode() : _options.node;
+      // Placement is a hint, memory stays usable if policy could not be applied
+      if (kNode >= 0 && kNode < kMaxNodes && getNodesCount() > 1) {
+        unsigned long mask[kMaxNodes / (8 * sizeof(unsigned long))] = {};
+        mask[kNode / (8 * sizeof(unsigned long))] = 1UL << (kNode % (8 * sizeof(unsigned long)));
+        ::syscall(__NR_mbind, result, kSize, MPOL_PREFERRED, mask, kMaxNodes + 1, 0);
+      }
+      if (_options.prefault) {
+        prefault(result, kSize);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for releasing of memory allocated by allocate()
+   */
+  static void deallocate(uint8_t * _pMemory, const size_t _size, const NumaOptions & _options) {
+    if (_pMemory) {
+      ::munmap(_pMemory, getMappingSize(_size > 0 ? _size : 1, _options));
+    }
+  }
+
+ private:
+  static bool isHuge(const size_t _size, const NumaOptions & _options) {
+    return _options.huge_pages && _size >= kHugePageSize;
+  }
+
+  static uint8_t * map(const size_t _size) {
+    void * pMap = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return (pMap != MAP_FAILED) ? static_cast<uint8_t *>(pMap) : nullptr;
+  }
+
+  /**
+   * Method for mapping of memory aligned to huge page, otherwise kernel could not back it by huge pages
+   */
+  static uint8_t * mapHuge(const size_t _size) {
+    uint8_t * pMap = map(_size + kHugePageSize);
+    uint8_t * result = nullptr;
+    if (pMap) {
+      const uintptr_t kAddress = reinterpret_cast<uintptr_t>(pMap);
+      result = reinterpret_cast<uint8_t *>((kAddress + kHugePageSize - 1) / kHugePageSize * kHugePageSize);
+      if (result > pMap) {
+        ::munmap(pMap, static_cast<size_t>(result - pMap));
+      }
+      const size_t kTail = static_cast<size_t>(pMap + _size + kHugePageSize - (result + _size));
+      if (kTail > 0) {
+        ::munmap(result + _size, kTail);
+      }
+      ::madvise(result, _size, MADV_HUGEPAGE);
+    }
+    return result;
+  }
+
+  static void prefault(uint8_t * _pMemory, const size_t _size) {
+#ifdef MADV_POPULATE_WRITE
+    if (::madvise(_pMemory, _size, MADV_POPULATE_WRITE) == 0) {
+      return;
+    }
+#endif
+    const size_t kPage = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    for (size_t offset = 0; offset < _size; offset += kPage) {
+      *static_cast<volatile uint8_t *>(_pMemory + offset) = 0;
+    }
+  }
+
+  /**
+   * Method for reading of the highest online node, list looks like "0" or "0-1" or "0,2-3"
+   */
+  static int readNodesCount() {
+    int result = 1;
+    FILE * pFile = std::fopen("/sys/devices/system/node/online", "r");
+    if (pFile) {
+      char line[256] = {};
+      if (std::fgets(line, sizeof(line), pFile)) {
+        const char * pLast = line;
+        for (const char * pChar = line; *pChar != '\0'; ++pChar) {
+          if (*pChar == '-' || *pChar == ',') {
+            pLast = pChar + 1;
+          }
+        }
+        int maxNode = 0;
+        if (std::sscanf(pLast, "%d", &maxNode) == 1 && maxNode >= 0) {
+          result = maxNode + 1;
+        }
+      }
+      std::fclose(pFile);
+    }
+    return result;
+  }
+};
+
+/**
+ * Pack buffer with memory on chosen NUMA node, optionally pre-faulted and backed by huge pages
+ */
+class NumaPackBuffer
+    : public PackBuffer {
+ public:
+  /**
+   * Constructor of buffer
+   * @param _size Size of buffer
+   * @param _options Placement of memory, node should be node of consumer
+   * @param _alignment Alignment of packed data
+   */
+  explicit NumaPackBuffer(const size_t _size,
+                          const NumaOptions & _options = NumaOptions(),
+                          AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : PackBuffer(nullptr, 0, _alignment)
+      , options_(_options)
+      , size_{_size} {
+    uint8_t * pMemory = NumaMemory::allocate(_size, _options);
+    if (pMemory) {
+      rebind(pMemory, _size);
+    } else {
+#ifdef __cpp_exceptions
+      throw std::system_error(errno, std::system_category(), "Could not allocate NUMA buffer");
+#endif
+    }
+  }
+
+  NumaPackBuffer(const NumaPackBuffer&) = delete;
+  NumaPackBuffer& operator=(const NumaPackBuffer&) = delete;
+
+  ~NumaPackBuffer() {
+    NumaMemory::deallocate(p_buf_, size_, options_);
+  }
+
+  /**
+   * Method for checking if memory was successfully allocated
+   * @return Return true if buffer has memory, false otherwise
+   */
+  bool isOpen() const {
+    return p_buf_ != nullptr;
+  }
+
+  const NumaOptions & getOptions() const {
+    return options_;
+  }
+
+ private:
+  const NumaOptions options_;
+  const size_t size_;
+};
+}
+
+#endif //BUFFERS_NUMAPACKBUFFER_HPP
@@ -10,6 +10,7 @@
 #define BUFFERS_PACKBUFFER_HPP
 
 #include <stdint.h>
+#include <cstddef>
 #include <cstring>
 #include <string>
 #include <vector>
@@ -19,6 +20,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <algorithm>
+#include <limits>
 #include <type_traits>
 
 #include "AlignMemory.hpp"
@@ -77,6 +79,10 @@ namespace buffers {
         return (buf_size_ - msg_size_);
       }
 
+      AlignMemory alignment() const {
+        return alignment_;
+      }
+
      private:
       Context(uint8_t * _pMsg, size_t _size, AlignMemory _alignment)
           : buf_size_{_size}
@@ -91,7 +97,7 @@ namespace buffers {
         return kNumChunks * kAlignedMemChunk;
       }
 
-      const size_t buf_size_;
+      size_t buf_size_;
       uint8_t * p_msg_;
       size_t msg_size_;
       AlignMemory alignment_;
@@ -132,7 +138,7 @@ namespace buffers {
     virtual ~PackBuffer();
 
    public:
-    bool put(nullptr_t) = delete;
+    bool put(std::nullptr_t) = delete;
 
     template<typename T>
     bool put(const T & _t) {
@@ -140,14 +146,25 @@ namespace buffers {
                             typename std::remove_cv<T>::type
                           >::type;
       auto packer = DelegatePackBuffer<GeneralType>{};
+      const size_t kMsgSize = context_.msg_size_;
       bool result = packer.put(context_, _t);
+      if (!result) {
+        const size_t kHint = getTypeSizeHint<GeneralType>(_t, 0);
+        for (size_t retry = 0; !result && retryExpanded(kMsgSize, kHint, retry); ++retry) {
+          result = packer.put(context_, _t);
+        }
+      }
       return result;
     }
 
     template <typename T, size_t dataLen>
     bool put(const T (&_buffer)[dataLen]) {
       auto packer = DelegatePackBuffer<T>{};
+      const size_t kMsgSize = context_.msg_size_;
       bool result = packer.put(context_, _buffer);
+      for (size_t retry = 0; !result && retryExpanded(kMsgSize, sizeof(size_t) + sizeof(_buffer), retry); ++retry) {
+        result = packer.put(context_, _buffer);
+      }
       return result;
     }
 
@@ -157,7 +174,12 @@ namespace buffers {
     template<typename T>
     bool put(const T * _buffer, size_t dataLen) {
       auto packer = DelegatePackBuffer<T>{};
+      const size_t kMsgSize = context_.msg_size_;
       bool result = packer.put(context_, _buffer, dataLen);
+      for (size_t retry = 0;
+           !result && _buffer && retryExpanded(kMsgSize, sizeof(size_t) + sizeof(T) * dataLen, retry); ++retry) {
+        result = packer.put(context_, _buffer, dataLen);
+      }
       return result;
     }
 
@@ -181,6 +203,26 @@ namespace buffers {
       return DelegatePackBuffer<T>{}.getTypeSize(_t, dataLen);
     }
 
+    /**
+     * Method for overwriting trivial value that was already packed
+     * @tparam T Type of value, should be a trivial type
+     * @param _offset Offset of the value from the beginning of packed data
+     * @param _t Value to write
+     * @return Return true if value is inside of packed data, false otherwise
+     */
+    template<typename T>
+    bool putAt(const size_t _offset, const T & _t) {
+#if __cplusplus > 199711L
+      static_assert(std::is_trivial<T>::value, "Type T is not a trivial type !!");
+#endif
+      bool result = false;
+      if (_offset + sizeof(T) <= context_.msg_size_) {
+        std::memcpy(p_buf_ + _offset, &_t, sizeof(T));
+        result = true;
+      }
+      return result;
+    }
+
     /**
      * Method for reset packing data to the buffer
      */
@@ -188,6 +230,16 @@ namespace buffers {
       context_ -= context_.msg_size_;
     }
 
+    /**
+     * Method for reset packing data to the given size, used to drop partially packed data
+     * @param _dataSize Size of packed data to keep, should be taken from getDataSize()
+     */
+    void reset(const size_t _dataSize) {
+      if (_dataSize < context_.msg_size_) {
+        context_ -= (context_.msg_size_ - _dataSize);
+      }
+    }
+
     /**
      * Method implicit conversion buffer to the raw pointer
      * @return Raw pointer to the packed data
@@ -220,9 +272,79 @@ namespace buffers {
       return context_.buffer_size();
     }
 
+    /**
+     * Method for getting alignment of packed data
+     * @return Alignment which is used for every packed value
+     */
+    AlignMemory getAlignment() const {
+      return context_.alignment_;
+    }
+
    protected:
-    uint8_t * const p_buf_;
+    /**
+     * Method for expanding buffer if it is growable, called when put failed
+     * Growable buffer should move packed data to the new memory and call rebind()
+     * @param _size Minimal size of free space that is required after expanding
+     * @return Return true if buffer was expanded, false otherwise
+     */
+    virtual bool expand(const size_t /*_size*/) {
+      return false;
+    }
+
+    /**
+     * Method for binding packed data to the new memory after it was moved
+     * @param _pMsg Pointer to the new buffer which already holds packed data
+     * @param _size Size of the new buffer
+     */
+    void rebind(uint8_t * const _pMsg, const size_t _size) {
+      p_buf_ = _pMsg;
+      context_.p_msg_ = _pMsg + context_.msg_size_;
+      context_.buf_size_ = _size;
+    }
+
+    uint8_t * p_buf_;
     Context context_;
+
+   private:
+    /**
+     * Method for rollback of partially packed data and expanding of buffer
+     * @param _msgSize Size of packed data before failed put
+     * @param _hint Size of the value from DelegatePackBuffer or max of size_t if it is unknown
+     * @param _retry Number of already failed retries
+     * @return Return true if put should be retried, false otherwise
+     */
+    bool retryExpanded(const size_t _msgSize, const size_t _hint, const size_t _retry) {
+      context_ -= (context_.msg_size_ - _msgSize);
+      // If size is unknown buffer is just doubled once
+      size_t required = 0;
+      if (_retry == 0) {
+        required = (context_.buf_size_ > 0) ? context_.buf_size_ : 1;
+      }
+      if (_hint != std::numeric_limits<size_t>::max()) {
+        // Value takes its size and padding of at most alignment - 1 bytes per packed element,
+        // the first retry reserves padding only for a bounded number of elements
+        const size_t kPadding = static_cast<size_t>(context_.alignment_) - 1;
+        const size_t kPaddedElements = (_hint < 1024) ? _hint : 1024;
+        required = _hint + kPaddedElements * kPadding;
+        if (context_.buffer_size() >= required) {
+          // Value has more padded elements, buffer grows till the worst case of padding of every byte
+          const size_t kWorstCase = _hint * (kPadding + 1);
+          required = (2 * context_.buffer_size() < kWorstCase) ? 2 * context_.buffer_size() : kWorstCase;
+        }
+      }
+      return (context_.buffer_size() < required) && expand(required);
+    }
+
+    template <typename T>
+    static auto getTypeSizeHint(const T & _t, int)
+        -> decltype(DelegatePackBuffer<T>::getTypeSize(_t)) {
+      return DelegatePackBuffer<T>::getTypeSize(_t);
+    }
+
+    template <typename T>
+    static size_t getTypeSizeHint(const T &, long) {
+      return std::numeric_limits<size_t>::max();
+    }
   };
 
   inline
@@ -342,15 +464,20 @@ namespace buffers {
     }
 
     static size_t getTypeSize(const char *str) {
-      return (std::strlen(str) + 1);
+      return str ? (std::strlen(str) + 1) : 0;
     }
   };
 
   template <size_t dataLen>
   bool PackBuffer::put(const char (&_buffer)[dataLen]) {
     auto packer = DelegatePackBuffer<char *>{};
+    const size_t kMsgSize = context_.msg_size_;
     bool result = packer.put(context_,
                              static_cast<const char *>(_buffer));
+    for (size_t retry = 0; !result && retryExpanded(kMsgSize, dataLen, retry); ++retry) {
+      result = packer.put(context_,
+                          static_cast<const char *>(_buffer));
+    }
     return result;
   }
 
@@ -402,14 +529,30 @@ namespace buffers {
       if (_vec.size() > 0) {
         if (getTypeSize(_vec) <= _ctx.buffer_size()) {
           DelegatePackBuffer<decltype(_vec.size())>{}.put(_ctx, _vec.size());
-          std::copy(_vec.data(), _vec.data() + _vec.size(), (T*)(_ctx.buffer()));
-          _ctx += _vec.size() * sizeof(T);
-          result = true;
+          result = putElements(_ctx, _vec);
         }
       }
       return result;
     }
 
+    template <typename TBufferContext, typename TT>
+    static typename std::enable_if<(std::is_trivial<TT>::value), bool>::type
+    putElements(TBufferContext & _ctx, const std::vector<TT> & _vec) {
+      std::copy(_vec.data(), _vec.data() + _vec.size(), (TT*)(_ctx.buffer()));
+      _ctx += _vec.size() * sizeof(TT);
+      return true;
+    }
+
+    template <typename TBufferContext, typename TT>
+    static typename std::enable_if<!(std::is_trivial<TT>::value), bool>::type
+    putElements(TBufferContext & _ctx, const std::vector<TT> & _vec) {
+      bool result = true;
+      for (auto& ve : _vec) {
+        result = result && DelegatePackBuffer<TT>{}.put(_ctx, ve);
+      }
+      return result;
+    }
+
     template <typename TT>
     static typename std::enable_if<(std::is_trivial<TT>::value), size_t>::type
     getTypeSize(const std::vector<TT> & _vec) {
@@ -428,6 +571,56 @@ namespace buffers {
     }
   };
 
+  /**
+   * Specialization DelegatePackBuffer class for std::vector<bool>, every value takes one bit:
+   *     size | bits from the least significant one of the first byte | padding
+   */
+  template <>
+  class PackBuffer::DelegatePackBuffer<std::vector<bool>> {
+   public:
+    /**
+     * Method for packing std::vector<bool> in buffer, bits are collected in 64-bit words
+     * @param _vec std::vector<bool> for packing
+     * @return Return true if packing is succeed, false otherwise
+     */
+    template <typename TBufferContext>
+    static bool put(TBufferContext & _ctx, const std::vector<bool> & _vec) {
+      bool result = false;
+      if (getTypeSize(_vec) <= _ctx.buffer_size()) {
+        DelegatePackBuffer<decltype(_vec.size())>{}.put(_ctx, _vec.size());
+        uint8_t * pBits = _ctx.buffer();
+        uint64_t word = 0;
+        for (size_t i = 0; i < _vec.size(); ++i) {
+          word |= static_cast<uint64_t>(_vec[i]) << (i % 64);
+          if (i % 64 == 63) {
+            putWord(pBits, word, sizeof(word));
+            pBits += sizeof(word);
+            word = 0;
+          }
+        }
+        putWord(pBits, word, (_vec.size() % 64 + 7) / 8);
+        _ctx += getBytesCount(_vec.size());
+        result = true;
+      }
+      return result;
+    }
+
+    static size_t getTypeSize(const std::vector<bool> & _vec) {
+      return (sizeof(_vec.size()) + getBytesCount(_vec.size()));
+    }
+
+    static size_t getBytesCount(const size_t _size) {
+      return (_size + 7) / 8;
+    }
+
+   private:
+    static void putWord(uint8_t * _pBits, const uint64_t _word, const size_t _bytesCount) {
+      for (size_t i = 0; i < _bytesCount; ++i) {
+        _pBits[i] = static_cast<uint8_t>(_word >> (8 * i));
+      }
+    }
+  };
+
   /**
    * Specialization DelegatePackBuffer class for std::list
    * @tparam T Type of data under std::list
@@ -582,7 +775,7 @@ namespace buffers {
 
     template <typename KK, typename VV>
     static typename std::enable_if<(std::is_trivial<KK>::value && std::is_trivial<VV>::value), size_t>::type
-    getTypeSize(const std::unordered_map<KK, VV> & _mp) {
+    getTypeSize(const std::map<KK, VV> & _mp) {
       return (sizeof(_mp.size()) + (sizeof(KK) + sizeof(VV)) * _mp.size());
     }
 
@@ -0,0 +1,195 @@
+/**
+ * @file ParallelDecoder.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains parallel decoding of buffers with many independent messages
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_PARALLELDECODER_HPP
+#define BUFFERS_PARALLELDECODER_HPP
+
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "UnpackBuffer.hpp"
+#include "Frame.hpp"
+#include "ThreadPool.hpp"
+
+namespace buffers {
+/**
+ * Random access list of independent messages: frames or fixed-stride records
+ */
+class MessageList {
+ public:
+  /**
+   * Constructor of list of complete frames, frame offsets are indexed once
+   * @param _frames Reader of frames
+   */
+  explicit MessageList(const FrameReader & _frames)
+      : p_data_(nullptr)
+      , count_{0}
+      , stride_{0}
+      , alignment_{static_cast<AlignMemory>(sizeof(int))} {
+    for (auto it = _frames.begin(); it != _frames.end(); ++it) {
+      const UnpackBuffer kFrame = *it;
+      if (p_data_ == nullptr) {
+        p_data_ = kFrame.getData();
+        alignment_ = kFrame.getAlignment();
+      }
+      frames_.emplace_back(static_cast<size_t>(kFrame.getData() - p_data_), kFrame.getDataSize());
+    }
+    count_ = frames_.size();
+  }
+
+  /**
+   * Constructor of list of fixed-stride records
+   * @param _pData Pointer to the first record
+   * @param _count Number of records
+   * @param _stride Size of every record
+   * @param _alignment Alignment of packed data
+   */
+  MessageList(uint8_t const * _pData, const size_t _count, const size_t _stride,
+              AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : p_data_(_pData)
+      , count_{_count}
+      , stride_{_stride}
+      , alignment_{_alignment} {
+  }
+
+  size_t size() const {
+    return count_;
+  }
+
+  /**
+   * Method for getting of unpack buffer of message, every call creates independent cursor
+   * @param _index Index of message
+   * @return Unpack buffer limited by message
+   */
+  UnpackBuffer operator[](const size_t _index) const {
+    return (stride_ > 0)
+           ? UnpackBuffer(p_data_ + _index * stride_, stride_, alignment_)
+           : UnpackBuffer(p_data_ + frames_[_index].first, frames_[_index].second, alignment_);
+  }
+
+ private:
+  uint8_t const * p_data_;
+  size_t count_;
+  size_t stride_;
+  AlignMemory alignment_;
+  std::vector<std::pair<size_t, size_t>> frames_;
+};
+
+/**
+ * Decoder which splits messages to batches and decodes them on work-stealing thread pool
+ */
+class ParallelDecoder {
+ public:
+  enum class Order {
+    Any,
+    Input,
+  };
+
+  static constexpr size_t kDefaultBatchSize = 256;
+
+  /**
+   * Constructor of decoder
+   * @param _pool Thread pool for decoding
+   * @param _batchSize Number of messages decoded by one task
+   */
+  explicit ParallelDecoder(ThreadPool & _pool, const size_t _batchSize = kDefaultBatchSize)
+      : pool_(_pool)
+      , batch_size_{_batchSize > 0 ? _batchSize : 1} {
+  }
+
+  /**
+   * Method for visiting of every message concurrently
+   * @tparam F Type of function with signature void(size_t index, UnpackBuffer & buffer)
+   * @param _messages Messages to visit
+   * @param _fn Function called concurrently from different threads
+   */
+  template <typename F>
+  void forEach(const MessageList & _messages, F && _fn) {
+    pool_.parallelFor(getBatchesCount(_messages), [&](const size_t _batch) {
+      const size_t kEnd = getBatchEnd(_messages, _batch);
+      for (size_t i = _batch * batch_size_; i < kEnd; ++i) {
+        UnpackBuffer buffer = _messages[i];
+        _fn(i, buffer);
+      }
+    });
+  }
+
+  /**
+   * Method for decoding of every message to value of type T and handing it to callback
+   * @tparam T Type of decoded value
+   * @tparam F Type of function with signature void(size_t index, T && value)
+   * @param _messages Messages to decode
+   * @param _fn Function which receives values. For Order::Any it is called concurrently,
+   *            for Order::Input it is called by one thread at a time in order of messages
+   * @param _order Order of calls of function
+   */
+  template <typename T, typename F>
+  void decode(const MessageList & _messages, F && _fn, const Order _order = Order::Any) {
+    if (_order == Order::Any) {
+      forEach(_messages, [&_fn](const size_t _index, UnpackBuffer & _buffer) {
+        _fn(_index, _buffer.get<T>());
+      });
+    } else {
+      const size_t kBatchesCount = getBatchesCount(_messages);
+      std::vector<std::unique_ptr<std::vector<T>>> batches(kBatchesCount);
+      std::mutex mutex;
+      size_t nextBatch = 0;
+      pool_.parallelFor(kBatchesCount, [&](const size_t _batch) {
+        const size_t kBegin = _batch * batch_size_;
+        const size_t kEnd = getBatchEnd(_messages, _batch);
+        std::unique_ptr<std::vector<T>> values(new std::vector<T>());
+        values->reserve(kEnd - kBegin);
+        for (size_t i = kBegin; i < kEnd; ++i) {
+          values->push_back(_messages[i].template get<T>());
+        }
+        // Batch which is next in order delivers itself and all ready batches after it
+        std::lock_guard<std::mutex> lock(mutex);
+        batches[_batch] = std::move(values);
+        while (nextBatch < kBatchesCount && batches[nextBatch]) {
+          size_t index = nextBatch * batch_size_;
+          for (auto & value : *batches[nextBatch]) {
+            _fn(index++, std::move(value));
+          }
+          batches[nextBatch].reset();
+          ++nextBatch;
+        }
+      });
+    }
+  }
+
+  /**
+   * Method for decoding of every message to pre-sized output slots
+   * @tparam T Type of decoded value
+   * @param _messages Messages to decode
+   * @param _slots Pointer to at least _messages.size() values, slot i receives message i
+   */
+  template <typename T>
+  void decode(const MessageList & _messages, T * _slots) {
+    forEach(_messages, [_slots](const size_t _index, UnpackBuffer & _buffer) {
+      _slots[_index] = _buffer.get<T>();
+    });
+  }
+
+ private:
+  size_t getBatchesCount(const MessageList & _messages) const {
+    return (_messages.size() + batch_size_ - 1) / batch_size_;
+  }
+
+  size_t getBatchEnd(const MessageList & _messages, const size_t _batch) const {
+    const size_t kEnd = (_batch + 1) * batch_size_;
+    return (kEnd < _messages.size()) ? kEnd : _messages.size();
+  }
+
+  ThreadPool & pool_;
+  const size_t batch_size_;
+};
+}
+
+#endif //BUFFERS_PARALLELDECODER_HPP
@@ -0,0 +1,230 @@
+/**
+ * @file ParallelPack.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains packing of large containers across thread pool
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_PARALLELPACK_HPP
+#define BUFFERS_PARALLELPACK_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "ThreadPool.hpp"
+
+namespace buffers {
+/**
+ * Wrapper of container which should be packed across thread pool.
+ * Output is byte-identical to the serial packing of container:
+ *     buffer.put(buffers::parallel(container, pool))
+ */
+template <typename C>
+class ParallelContainer {
+ public:
+  static constexpr size_t kDefaultChunkSize = 1 << 14;
+
+  ParallelContainer(const C & _container, ThreadPool & _pool, const size_t _chunkSize)
+      : container(_container)
+      , pool(_pool)
+      , chunk_size{_chunkSize > 0 ? _chunkSize : 1} {
+  }
+
+  const C & container;
+  ThreadPool & pool;
+  const size_t chunk_size;
+};
+
+/**
+ * Function for wrapping of container for parallel packing
+ * @param _container Container for packing, should not be changed till packing is finished
+ * @param _pool Thread pool for packing
+ * @param _chunkSize Number of elements packed by one task
+ */
+template <typename C>
+ParallelContainer<C> parallel(const C & _container, ThreadPool & _pool,
+                              const size_t _chunkSize = ParallelContainer<C>::kDefaultChunkSize) {
+  return ParallelContainer<C>(_container, _pool, _chunkSize);
+}
+
+/**
+ * Specialization DelegatePackBuffer class for container packed across thread pool.
+ * Packed sizes of chunks of elements are computed in parallel, prefix sum of them gives output
+ * offsets and every chunk is packed concurrently directly to its place in the final buffer.
+ * Every packed value is aligned, so chunk packed separately has the same bytes as in serial output.
+ * Packed size of user type is taken from its getTypeSize() rounded up to alignment, if it does not
+ * match the real packed size elements are packed serially
+ * @tparam C Type of container
+ */
+template <typename C>
+class PackBuffer::DelegatePackBuffer<ParallelContainer<C>> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const ParallelContainer<C> & _parallel) {
+    bool result = false;
+    if (_parallel.container.size() > 0) {
+      result = putElements(_ctx, _parallel, _parallel.container);
+    }
+    return result;
+  }
+
+  static size_t getTypeSize(const ParallelContainer<C> & _parallel) {
+    return DelegatePackBuffer<C>{}.getTypeSize(_parallel.container);
+  }
+
+ private:
+  using SizeType = decltype(std::declval<C>().size());
+
+  /**
+   * Method for packing of vector of trivial types, the only container packed as one raw block
+   */
+  template <typename TBufferContext, typename T>
+  static typename std::enable_if<(std::is_trivial<T>::value), bool>::type
+  putElements(TBufferContext & _ctx, const ParallelContainer<C> & _parallel, const std::vector<T> & _vec) {
+    bool result = false;
+    const size_t kBytes = _vec.size() * sizeof(T);
+    const size_t kCountSize = getAlignedSize(sizeof(SizeType), _ctx.alignment());
+    if (kCountSize + getAlignedSize(kBytes, _ctx.alignment()) <= _ctx.buffer_size()) {
+      DelegatePackBuffer<SizeType>{}.put(_ctx, _vec.size());
+      const uint8_t * pSource = reinterpret_cast<const uint8_t *>(_vec.data());
+      uint8_t * const pDestination = _ctx.buffer();
+      const size_t kChunkBytes = _parallel.chunk_size * sizeof(T);
+      _parallel.pool.parallelFor((kBytes + kChunkBytes - 1) / kChunkBytes, [&](const size_t _index) {
+        const size_t kOffset = _index * kChunkBytes;
+        std::memcpy(pDestination + kOffset, pSource + kOffset,
+                    (kBytes - kOffset < kChunkBytes) ? (kBytes - kOffset) : kChunkBytes);
+      });
+      _ctx += kBytes;
+      result = true;
+    }
+    return result;
+  }
+
+  template <typename TBufferContext, typename CC>
+  static bool putElements(TBufferContext & _ctx, const ParallelContainer<C> & _parallel, const CC & _container) {
+    using Iterator = typename C::const_iterator;
+    std::vector<Iterator> chunks;
+    size_t index = 0;
+    for (Iterator it = _container.begin(); it != _container.end(); ++it, ++index) {
+      if (index % _parallel.chunk_size == 0) {
+        chunks.push_back(it);
+      }
+    }
+    chunks.push_back(_container.end());
+
+    const size_t kChunksCount = chunks.size() - 1;
+    std::vector<size_t> offsets(kChunksCount + 1, 0);
+    _parallel.pool.parallelFor(kChunksCount, [&](const size_t _index) {
+      size_t size = 0;
+      for (Iterator it = chunks[_index]; it != chunks[_index + 1]; ++it) {
+        size += getPackedSize(*it, _ctx.alignment());
+      }
+      offsets[_index + 1] = size;
+    });
+    for (size_t i = 0; i < kChunksCount; ++i) {
+      offsets[i + 1] += offsets[i];
+    }
+
+    bool result = false;
+    const size_t kCountSize = getAlignedSize(sizeof(SizeType), _ctx.alignment());
+    if (kCountSize + offsets[kChunksCount] <= _ctx.buffer_size()) {
+      DelegatePackBuffer<SizeType>{}.put(_ctx, _container.size());
+      uint8_t * const pDestination = _ctx.buffer();
+      std::vector<uint8_t> failed(kChunksCount, 0);
+      _parallel.pool.parallelFor(kChunksCount, [&](const size_t _index) {
+        PackBuffer::Context chunk(pDestination + offsets[_index],
+                                  offsets[_index + 1] - offsets[_index],
+                                  _ctx.alignment());
+        for (Iterator it = chunks[_index]; it != chunks[_index + 1] && failed[_index] == 0; ++it) {
+          failed[_index] = putElement(chunk, *it) ? 0 : 1;
+        }
+        if (chunk.buffer_size() != 0) {
+          failed[_index] = 1;
+        }
+      });
+      result = true;
+      for (size_t i = 0; i < kChunksCount; ++i) {
+        result = result && (failed[i] == 0);
+      }
+      if (result) {
+        _ctx += offsets[kChunksCount];
+      } else {
+        // Padding should stay zero as in serial output, so bytes of failed attempt are cleared
+        std::memset(pDestination, 0, offsets[kChunksCount]);
+        result = putSerially(_ctx, _container);
+        if (!result) {
+          _ctx -= kCountSize;
+        }
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for packing of elements one by one, used if packed size of element is not known exactly
+   */
+  template <typename TBufferContext, typename CC>
+  static bool putSerially(TBufferContext & _ctx, const CC & _container) {
+    const size_t kAvailable = _ctx.buffer_size();
+    bool result = true;
+    for (auto it = _container.begin(); result && it != _container.end(); ++it) {
+      result = putElement(_ctx, *it);
+    }
+    if (!result) {
+      _ctx -= kAvailable - _ctx.buffer_size();
+    }
+    return result;
+  }
+
+  template <typename TBufferContext, typename T>
+  static bool putElement(TBufferContext & _ctx, const T & _t) {
+    return DelegatePackBuffer<T>{}.put(_ctx, _t);
+  }
+
+  /**
+   * Method for packing of element of map, key and value are packed one by one as in serial packing
+   */
+  template <typename TBufferContext, typename K, typename V>
+  static bool putElement(TBufferContext & _ctx, const std::pair<const K, V> & _pr) {
+    return DelegatePackBuffer<K>{}.put(_ctx, _pr.first) && DelegatePackBuffer<V>{}.put(_ctx, _pr.second);
+  }
+
+  template <typename T>
+  static size_t getPackedSize(const T & _t, const AlignMemory _alignment) {
+    return getAlignedSize(DelegatePackBuffer<T>{}.getTypeSize(_t), _alignment);
+  }
+
+  template <typename K, typename V>
+  static size_t getPackedSize(const std::pair<const K, V> & _pr, const AlignMemory _alignment) {
+    return getPackedSize(_pr.first, _alignment) + getPackedSize(_pr.second, _alignment);
+  }
+
+  /**
+   * Method for getting of packed size of nested vector, every element is aligned separately
+   */
+  template <typename T>
+  static size_t getPackedSize(const std::vector<T> & _vec, const AlignMemory _alignment) {
+    size_t result = getAlignedSize(sizeof(_vec.size()), _alignment);
+    if (std::is_trivial<T>::value) {
+      result += getAlignedSize(_vec.size() * sizeof(T), _alignment);
+    } else {
+      for (auto& ve : _vec) {
+        result += getPackedSize(ve, _alignment);
+      }
+    }
+    return result;
+  }
+
+  static size_t getPackedSize(const std::vector<bool> & _vec, const AlignMemory _alignment) {
+    return getAlignedSize(sizeof(_vec.size()), _alignment) +
+           getAlignedSize(DelegatePackBuffer<std::vector<bool>>::getBytesCount(_vec.size()), _alignment);
+  }
+};
+}
+
+#endif //BUFFERS_PARALLELPACK_HPP
@@ -0,0 +1,315 @@
+/**
+ * @file PresenceBitmap.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains presence bitmap encoding of structs with sparse non-default fields
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_PRESENCEBITMAP_HPP
+#define BUFFERS_PRESENCEBITMAP_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "StructFields.hpp"
+
+namespace buffers {
+/**
+ * Wrapper of struct registered with StructFields which is packed with presence bitmap
+ * @tparam T Type of struct
+ */
+template <typename T>
+class PresenceStruct : public T {
+ public:
+  PresenceStruct()
+      : T() {
+  }
+
+  PresenceStruct(const T & _value)
+      : T(_value) {
+  }
+
+  PresenceStruct(T && _value)
+      : T(std::move(_value)) {
+  }
+};
+
+/**
+ * Wrapper for packing of existing struct with presence bitmap without copying:
+ *     buffer.put(buffers::presence(wide));
+ * Packed data is unpacked as PresenceStruct
+ */
+template <typename T>
+struct PresenceView {
+  explicit PresenceView(const T & _value)
+      : value(_value) {
+  }
+
+  const T & value;
+};
+
+template <typename T>
+PresenceView<T> presence(const T & _value) {
+  return PresenceView<T>(_value);
+}
+
+/**
+ * Encoding of struct where only fields different from default constructed struct are packed:
+ *     bitmap of uint32_t words, bit i % 32 of word i / 32 is set for present field i | present fields
+ * Fields which are registered structs are encoded with their own bitmap against default value of the field.
+ * Decoding walks set bits of bitmap and every bit selects typed unpacker of its field from table
+ * built once per struct, so absent fields cost nothing
+ */
+struct PresenceFormat {
+  using Word = uint32_t;
+
+  static constexpr size_t kWordBits = 32;
+
+  template <typename TBufferContext, typename T>
+  static bool put(TBufferContext & _ctx, const T & _value) {
+    return putStruct(_ctx, _value, getDefault<T>());
+  }
+
+  template <typename TBufferContext, typename T>
+  static T get(TBufferContext & _ctx) {
+    T result = T();
+    apply(_ctx, result);
+    return result;
+  }
+
+ private:
+  template <typename T>
+  struct CountVisitor {
+    template <typename M>
+    void operator()(M T::*) {
+      ++count;
+    }
+
+    size_t count;
+  };
+
+  template <typename TBufferContext, typename T>
+  using FieldGetter = std::function<bool(TBufferContext &, T &)>;
+
+  template <typename TBufferContext, typename T>
+  struct GetterVisitor {
+    template <typename M>
+    void operator()(M T::* _member) {
+      getters.push_back([_member](TBufferContext & _ctx, T & _value) {
+        return getValue(_ctx, _value.*_member);
+      });
+    }
+
+    std::vector<FieldGetter<TBufferContext, T>> & getters;
+  };
+
+  template <typename TBufferContext, typename T>
+  struct PutVisitor {
+    template <typename M>
+    void operator()(M T::* _member) {
+      if (result && !isEqual(value.*_member, defaults.*_member)) {
+        uint8_t * const pWord = pWords + index / kWordBits * sizeof(Word);
+        Word word;
+        std::memcpy(&word, pWord, sizeof(word));
+        word |= Word{1} << (index % kWordBits);
+        std::memcpy(pWord, &word, sizeof(word));
+        result = putValue(ctx, value.*_member, defaults.*_member);
+      }
+      ++index;
+    }
+
+    TBufferContext & ctx;
+    const T & value;
+    const T & defaults;
+    uint8_t * pWords;
+    size_t index;
+    bool result;
+  };
+
+  template <typename T>
+  struct EqualVisitor {
+    template <typename M>
+    void operator()(M T::* _member) {
+      result = result && isEqual(value.*_member, other.*_member);
+    }
+
+    const T & value;
+    const T & other;
+    bool result;
+  };
+
+  template <typename T>
+  static const T & getDefault() {
+    static const T kDefault = T();
+    return kDefault;
+  }
+
+  template <typename T>
+  static size_t getFieldsCount() {
+    static const size_t kFieldsCount = countFields<T>();
+    return kFieldsCount;
+  }
+
+  template <typename T>
+  static size_t countFields() {
+    CountVisitor<T> visitor{0};
+    StructFields<T>::visit(visitor);
+    return visitor.count;
+  }
+
+  /**
+   * Method for getting of unpackers of fields by field index
+   */
+  template <typename TBufferContext, typename T>
+  static const std::vector<FieldGetter<TBufferContext, T>> & getGetters() {
+    static const std::vector<FieldGetter<TBufferContext, T>> kGetters = makeGetters<TBufferContext, T>();
+    return kGetters;
+  }
+
+  template <typename TBufferContext, typename T>
+  static std::vector<FieldGetter<TBufferContext, T>> makeGetters() {
+    std::vector<FieldGetter<TBufferContext, T>> result;
+    GetterVisitor<TBufferContext, T> visitor{result};
+    StructFields<T>::visit(visitor);
+    return result;
+  }
+
+  template <typename T>
+  static size_t getWordsCount() {
+    return (getFieldsCount<T>() + kWordBits - 1) / kWordBits;
+  }
+
+  static Word getWord(uint8_t const * _pWords, const size_t _index) {
+    Word word;
+    std::memcpy(&word, _pWords + _index / kWordBits * sizeof(Word), sizeof(word));
+    return word;
+  }
+
+  template <typename TBufferContext, typename T>
+  static bool putStruct(TBufferContext & _ctx, const T & _value, const T & _defaults) {
+    const size_t kWordsSize = getWordsCount<T>() * sizeof(Word);
+    bool result = kWordsSize <= _ctx.buffer_size();
+    if (result) {
+      uint8_t * const pWords = _ctx.buffer();
+      std::memset(pWords, 0, kWordsSize);
+      _ctx += kWordsSize;
+      PutVisitor<TBufferContext, T> visitor{_ctx, _value, _defaults, pWords, 0, true};
+      StructFields<T>::visit(visitor);
+      result = visitor.result;
+    }
+    return result;
+  }
+
+  template <typename TBufferContext, typename M>
+  static typename std::enable_if<HasStructFields<M>::value, bool>::type
+  putValue(TBufferContext & _ctx, const M & _value, const M & _defaults) {
+    return putStruct(_ctx, _value, _defaults);
+  }
+
+  template <typename TBufferContext, typename M>
+  static typename std::enable_if<!HasStructFields<M>::value, bool>::type
+  putValue(TBufferContext & _ctx, const M & _value, const M &) {
+    return PackBuffer::DelegatePackBuffer<M>{}.put(_ctx, _value);
+  }
+
+  /**
+   * Method for unpacking of present fields over fields of existing value
+   * @return Return true if bitmap has only known fields, false otherwise
+   */
+  template <typename TBufferContext, typename T>
+  static bool apply(TBufferContext & _ctx, T & _value) {
+    const size_t kFieldsCount = getFieldsCount<T>();
+    const size_t kWordsCount = getWordsCount<T>();
+    uint8_t const * const pWords = _ctx.buffer();
+    _ctx += kWordsCount * sizeof(Word);
+    // Bits after the last field of the last word belong to unknown fields
+    bool result = (kFieldsCount % kWordBits == 0) ||
+                  (getWord(pWords, kFieldsCount) >> (kFieldsCount % kWordBits)) == 0;
+    const auto & kGetters = getGetters<TBufferContext, T>();
+    for (size_t i = 0; result && i < kWordsCount; ++i) {
+      Word word = getWord(pWords, i * kWordBits);
+      while (result && word != 0) {
+        const size_t kIndex = i * kWordBits + static_cast<size_t>(__builtin_ctz(word));
+        result = kGetters[kIndex](_ctx, _value);
+        word &= word - 1;
+      }
+    }
+    if (!result) {
+#ifdef __cpp_exceptions
+      throw std::out_of_range("Presence bitmap has unknown field !!");
+#endif
+    }
+    return result;
+  }
+
+  template <typename TBufferContext, typename M>
+  static typename std::enable_if<HasStructFields<M>::value, bool>::type
+  getValue(TBufferContext & _ctx, M & _value) {
+    return apply(_ctx, _value);
+  }
+
+  template <typename TBufferContext, typename M>
+  static typename std::enable_if<!HasStructFields<M>::value, bool>::type
+  getValue(TBufferContext & _ctx, M & _value) {
+    _value = UnpackBuffer::DelegateUnpackBuffer<M>{}.get(_ctx);
+    return true;
+  }
+
+  template <typename M>
+  static typename std::enable_if<HasStructFields<M>::value, bool>::type
+  isEqual(const M & _value, const M & _other) {
+    EqualVisitor<M> visitor{_value, _other, true};
+    StructFields<M>::visit(visitor);
+    return visitor.result;
+  }
+
+  // Trivially copyable values are compared bitwise, so -0.0 is not replaced with default 0.0
+  template <typename M>
+  static typename std::enable_if<!HasStructFields<M>::value && std::is_trivially_copyable<M>::value, bool>::type
+  isEqual(const M & _value, const M & _other) {
+    return std::memcmp(&_value, &_other, sizeof(M)) == 0;
+  }
+
+  template <typename M>
+  static typename std::enable_if<!HasStructFields<M>::value && !std::is_trivially_copyable<M>::value, bool>::type
+  isEqual(const M & _value, const M & _other) {
+    return _value == _other;
+  }
+};
+
+template <typename T>
+class PackBuffer::DelegatePackBuffer<PresenceStruct<T>> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const PresenceStruct<T> & _value) {
+    return PresenceFormat::put(_ctx, static_cast<const T &>(_value));
+  }
+};
+
+template <typename T>
+class PackBuffer::DelegatePackBuffer<PresenceView<T>> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const PresenceView<T> & _view) {
+    return PresenceFormat::put(_ctx, _view.value);
+  }
+};
+
+template <typename T>
+class UnpackBuffer::DelegateUnpackBuffer<PresenceStruct<T>> {
+ public:
+  template <typename TBufferContext>
+  static PresenceStruct<T> get(TBufferContext & _ctx) {
+    return PresenceStruct<T>(PresenceFormat::get<TBufferContext, T>(_ctx));
+  }
+};
+}
+
+#endif //BUFFERS_PRESENCEBITMAP_HPP
@@ -0,0 +1,148 @@
+/**
+ * @file RecordWriter.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains writer which packs one record directly to the reserved space of shared storage
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_RECORDWRITER_HPP
+#define BUFFERS_RECORDWRITER_HPP
+
+#include <stdint.h>
+#include "PackBuffer.hpp"
+
+namespace buffers {
+/**
+ * Layout of records in storage shared by many writers.
+ * Every record starts with 64-bit header which is zero till commit:
+ *     record size (high 32 bits) | payload size or skip marker (low 32 bits)
+ */
+struct RecordFormat {
+  static constexpr size_t kHeaderSize = sizeof(uint64_t);
+  static constexpr size_t kSkipMarker = 0xFFFFFFFF;
+  static constexpr size_t kNoRecord = static_cast<size_t>(-1);
+  static constexpr size_t kMaxPaddedFields = 1024;
+
+  static size_t getRecordSize(const size_t _payloadSize) {
+    return (kHeaderSize + _payloadSize + kHeaderSize - 1) / kHeaderSize * kHeaderSize;
+  }
+};
+
+/**
+ * Buffer of one writer, packs one record directly to the storage.
+ * Storage should provide for RecordWriter:
+ *     AlignMemory getAlignment() const;
+ *     uint8_t * data() const;
+ *     size_t reserve(size_t _recordSize);  // offset of record or RecordFormat::kNoRecord
+ *     void publish(size_t _offset, size_t _recordSize, size_t _payloadSize);
+ * Every writer thread should use its own RecordWriter
+ * @tparam TStorage Type of storage
+ */
+template <typename TStorage>
+class RecordWriter : public PackBuffer {
+ public:
+  explicit RecordWriter(TStorage & _storage)
+      : PackBuffer(nullptr, 0, _storage.getAlignment())
+      , storage_(_storage)
+      , record_offset_{RecordFormat::kNoRecord}
+      , record_size_{0} {
+  }
+
+  RecordWriter(const RecordWriter&) = delete;
+  RecordWriter& operator=(const RecordWriter&) = delete;
+
+  /**
+   * Destructor, reserved but not committed record is skipped by readers
+   */
+  ~RecordWriter() {
+    abort();
+  }
+
+  /**
+   * Method for reservation of space for one record
+   * @param _size Maximal size of packed record, unused rest is published as skipped record
+   * @return Return true if space is reserved, false if storage is full
+   */
+  bool begin(const size_t _size) {
+    bool result = false;
+    if (record_offset_ == RecordFormat::kNoRecord) {
+      record_size_ = RecordFormat::getRecordSize(_size);
+      record_offset_ = storage_.reserve(record_size_);
+      if (record_offset_ != RecordFormat::kNoRecord) {
+        reset();
+        rebind(storage_.data() + record_offset_ + RecordFormat::kHeaderSize,
+               record_size_ - RecordFormat::kHeaderSize);
+        result = true;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for publishing of packed record, after it record is visible for readers
+   * @return Return true if record is published, false otherwise
+   */
+  bool commit() {
+    bool result = false;
+    if (record_offset_ != RecordFormat::kNoRecord) {
+      const size_t kUsed = RecordFormat::getRecordSize(getDataSize());
+      if (record_size_ - kUsed >= RecordFormat::kHeaderSize) {
+        // Unused rest of reservation is published first, reader reaches it only after record
+        storage_.publish(record_offset_ + kUsed, record_size_ - kUsed, RecordFormat::kSkipMarker);
+        storage_.publish(record_offset_, kUsed, getDataSize());
+      } else {
+        storage_.publish(record_offset_, record_size_, getDataSize());
+      }
+      record_offset_ = RecordFormat::kNoRecord;
+      result = true;
+    }
+    return result;
+  }
+
+  /**
+   * Method for dropping of reserved record, its space is published as skipped record
+   */
+  void abort() {
+    if (record_offset_ != RecordFormat::kNoRecord) {
+      storage_.publish(record_offset_, record_size_, RecordFormat::kSkipMarker);
+      record_offset_ = RecordFormat::kNoRecord;
+    }
+  }
+
+  /**
+   * Method for packing of one value as record.
+   * Space is reserved for size of value with padding of two fields first, if it is not enough
+   * record is dropped and space is reserved with padding for bounded number of fields
+   * @tparam T Type of value, should provide getTypeSize()
+   * @param _storage Storage for record
+   * @param _t Value for packing
+   * @return Return true if value is published, false if storage is full or value does not fit
+   */
+  template <typename T>
+  static bool push(TStorage & _storage, const T & _t) {
+    const size_t kSize = PackBuffer::getTypeSize(_t);
+    const size_t kPadding = static_cast<size_t>(_storage.getAlignment()) - 1;
+    const size_t kPaddedFields = (kSize < RecordFormat::kMaxPaddedFields) ? kSize : RecordFormat::kMaxPaddedFields;
+    const size_t kFirstSize = kSize + 2 * kPadding;
+    const size_t kPaddedSize = kSize + kPaddedFields * kPadding;
+    RecordWriter writer(_storage);
+    bool result = writer.begin(kFirstSize) && writer.put(_t);
+    if (!result && kPaddedSize > kFirstSize) {
+      writer.abort();
+      result = writer.begin(kPaddedSize) && writer.put(_t);
+    }
+    if (result) {
+      writer.commit();
+    }
+    return result;
+  }
+
+ private:
+  TStorage & storage_;
+  size_t record_offset_;
+  size_t record_size_;
+};
+}
+
+#endif //BUFFERS_RECORDWRITER_HPP
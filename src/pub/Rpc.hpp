@@ -0,0 +1,674 @@
+/**
+ * @file Rpc.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains lightweight request/response RPC over Unix domain sockets
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_RPC_HPP
+#define BUFFERS_RPC_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "Frame.hpp"
+#include "FrozenMessage.hpp"
+#include "CoalescingSender.hpp"
+#include "MessageRegistry.hpp"
+
+namespace buffers {
+enum class RpcStatus : uint16_t {
+  Ok = 0,
+  UnknownMethod = 1,
+  BadRequest = 2,
+  InternalError = 3,
+  Disconnected = 4,
+};
+
+/**
+ * Layout of RPC message, every message is a frame:
+ *     Header | packed request or response (only for RpcStatus::Ok)
+ * Method of request is MessageTypeId of request type, correlation id matches response to request,
+ * so many requests could be pipelined on one connection
+ */
+struct RpcFormat {
+  struct Header {
+    uint64_t correlation_id;
+    MessageId method;
+    uint16_t status;
+    uint32_t reserved;
+  };
+
+  static constexpr size_t kDefaultBufferSize = 64 * 1024;
+
+  /**
+   * Method for creating of UNIX domain stream socket address
+   * @param _path Path of socket
+   * @param _address Address to fill
+   * @return Return true if path fits to the address, false otherwise
+   */
+  static bool makeAddress(const std::string & _path, sockaddr_un & _address) {
+    std::memset(&_address, 0, sizeof(_address));
+    _address.sun_family = AF_UNIX;
+    bool result = (_path.size() < sizeof(_address.sun_path));
+    if (result) {
+      std::memcpy(_address.sun_path, _path.c_str(), _path.size() + 1);
+    } else {
+      errno = ENAMETOOLONG;
+    }
+    return result;
+  }
+
+  /**
+   * Options of sender, responses and requests are flushed explicitly after every batch
+   */
+  static CoalescingSender::Options getSenderOptions() {
+    CoalescingSender::Options options;
+    options.max_messages = 1024;
+    options.max_bytes = 256 * 1024;
+    options.max_delay = std::chrono::seconds{3600};
+    return options;
+  }
+};
+
+/**
+ * Buffer of received bytes of one connection, complete frames are processed in place
+ */
+class RpcInput {
+ public:
+  explicit RpcInput(const size_t _size)
+      : data_(_size > 0 ? _size : 1)
+      , size_{0} {
+  }
+
+  /**
+   * Method for reading of all available data from non-blocking socket
+   * @return Return false if connection is closed or failed, true otherwise
+   */
+  bool read(const int _fd) {
+    while (true) {
+      if (size_ == data_.size()) {
+        data_.resize(data_.size() * 2);
+      }
+      const ssize_t kRead = ::recv(_fd, data_.data() + size_, data_.size() - size_, 0);
+      if (kRead > 0) {
+        size_ += static_cast<size_t>(kRead);
+      } else if (kRead < 0 && errno == EINTR) {
+        continue;
+      } else {
+        return kRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+      }
+    }
+  }
+
+  /**
+   * Method for visiting of complete frames, processed frames are dropped from buffer
+   * @tparam F Type of function with signature void(UnpackBuffer & frame)
+   */
+  template <typename F>
+  void consume(AlignMemory _alignment, F && _fn) {
+    FrameReader reader(data_.data(), size_, _alignment);
+    for (auto frame : reader) {
+      _fn(frame);
+    }
+    const size_t kComplete = reader.getCompleteSize();
+    if (kComplete > 0) {
+      std::memmove(data_.data(), data_.data() + kComplete, size_ - kComplete);
+      size_ -= kComplete;
+    }
+  }
+
+ private:
+  std::vector<uint8_t> data_;
+  size_t size_;
+};
+
+/**
+ * RPC server with epoll loop. Requests of one read are processed in order and all their
+ * responses are written with one batched write
+ */
+class RpcServer {
+ public:
+  /**
+   * Constructor which binds and listens UNIX domain socket, existing socket file is replaced
+   * @param _path Path of socket
+   * @param _bufferSize Size of pooled response buffers, it limits size of response
+   * @param _alignment Alignment of packed data
+   */
+  explicit RpcServer(const std::string & _path,
+                     const size_t _bufferSize = RpcFormat::kDefaultBufferSize,
+                     AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : path_(_path)
+      , alignment_{_alignment}
+      , pool_(_bufferSize, _alignment)
+      , listen_fd_{-1}
+      , epoll_fd_{::epoll_create1(EPOLL_CLOEXEC)}
+      , wake_fd_{::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)}
+      , is_stopped_{false} {
+    if (!open()) {
+#ifdef __cpp_exceptions
+      const int kError = errno;
+      close();
+      throw std::system_error(kError, std::system_category(), "Could not listen on " + _path);
+#else
+      close();
+#endif
+    }
+  }
+
+  RpcServer(const RpcServer&) = delete;
+  RpcServer& operator=(const RpcServer&) = delete;
+
+  ~RpcServer() {
+    close();
+  }
+
+  bool isOpen() const {
+    return listen_fd_ >= 0;
+  }
+
+  /**
+   * Method for registering of handler of requests of type Request
+   * @tparam Request Type of request, method is MessageTypeId<Request>
+   * @tparam Response Type of response
+   * @tparam F Type of function with signature Response(Request && request)
+   * @param _fn Handler of request, called from thread of event loop
+   */
+  template <typename Request, typename Response, typename F>
+  void handle(F _fn) {
+    static_assert(std::is_same<typename std::decay<decltype(_fn(std::declval<Request>()))>::type, Response>::value,
+                  "Handler should return Response !!");
+    const MessageId kMethod = MessageTypeId<Request>::value;
+    if (handlers_.size() <= kMethod) {
+      handlers_.resize(kMethod + 1);
+    }
+    handlers_[kMethod] = [_fn](UnpackBuffer & _request, PackBuffer & _response) {
+      return _response.put(_fn(_request.get<Request>()));
+    };
+  }
+
+  /**
+   * Method for processing of ready events
+   * @param _timeoutMs Maximal time of waiting for events, -1 waits infinitely
+   * @return Return false if event loop failed, true otherwise
+   */
+  bool poll(const int _timeoutMs) {
+    epoll_event events[kMaxEvents];
+    const int kCount = ::epoll_wait(epoll_fd_, events, kMaxEvents, _timeoutMs);
+    if (kCount < 0) {
+      return errno == EINTR;
+    }
+    for (int i = 0; i < kCount; ++i) {
+      const int kFd = events[i].data.fd;
+      if (kFd == listen_fd_) {
+        accept();
+      } else if (kFd == wake_fd_) {
+        uint64_t value;
+        while (::read(wake_fd_, &value, sizeof(value)) > 0) {
+        }
+      } else {
+        process(kFd, events[i].events);
+      }
+    }
+    return true;
+  }
+
+  /**
+   * Method for running of event loop till stop() is called
+   */
+  void run() {
+    while (!is_stopped_.load(std::memory_order_acquire) && poll(-1)) {
+    }
+    is_stopped_.store(false, std::memory_order_relaxed);
+  }
+
+  /**
+   * Method for stopping of run(), could be called from any thread
+   */
+  void stop() {
+    is_stopped_.store(true, std::memory_order_release);
+    const uint64_t kValue = 1;
+    ssize_t written = ::write(wake_fd_, &kValue, sizeof(kValue));
+    (void)written;
+  }
+
+  size_t getConnectionsCount() const {
+    return connections_.size();
+  }
+
+ private:
+  static constexpr int kMaxEvents = 64;
+
+  struct Connection {
+    Connection(const int _fd, const size_t _bufferSize)
+        : fd{_fd}
+        , input(_bufferSize)
+        , sender(_fd, RpcFormat::getSenderOptions())
+        , events{EPOLLIN | EPOLLRDHUP}
+        , is_closing{false} {
+    }
+
+    int fd;
+    RpcInput input;
+    CoalescingSender sender;
+    uint32_t events;
+    // Input is finished or failed, connection is closed after queued responses are written
+    bool is_closing;
+  };
+
+  bool open() {
+    sockaddr_un address;
+    if (epoll_fd_ < 0 || wake_fd_ < 0 || !RpcFormat::makeAddress(path_, address)) {
+      return false;
+    }
+    ::unlink(path_.c_str());
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    bool result = (listen_fd_ >= 0) &&
+                  (::bind(listen_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0) &&
+                  (::listen(listen_fd_, SOMAXCONN) == 0) &&
+                  addToEpoll(listen_fd_, EPOLLIN) &&
+                  addToEpoll(wake_fd_, EPOLLIN);
+    return result;
+  }
+
+  void close() {
+    for (auto & connection : connections_) {
+      ::close(connection.first);
+    }
+    connections_.clear();
+    if (listen_fd_ >= 0) {
+      ::close(listen_fd_);
+      ::unlink(path_.c_str());
+      listen_fd_ = -1;
+    }
+    if (epoll_fd_ >= 0) {
+      ::close(epoll_fd_);
+      epoll_fd_ = -1;
+    }
+    if (wake_fd_ >= 0) {
+      ::close(wake_fd_);
+      wake_fd_ = -1;
+    }
+  }
+
+  bool addToEpoll(const int _fd, const uint32_t _events) {
+    epoll_event event{};
+    event.events = _events;
+    event.data.fd = _fd;
+    return ::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, _fd, &event) == 0;
+  }
+
+  void accept() {
+    while (true) {
+      const int kFd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+      if (kFd < 0) {
+        break;
+      }
+      if (addToEpoll(kFd, EPOLLIN | EPOLLRDHUP)) {
+        connections_[kFd].reset(new Connection(kFd, pool_.getBufferSize()));
+      } else {
+        ::close(kFd);
+      }
+    }
+  }
+
+  void process(const int _fd, const uint32_t _events) {
+    auto found = connections_.find(_fd);
+    if (found == connections_.end()) {
+      return;
+    }
+    Connection & connection = *found->second;
+    if (!connection.is_closing && (_events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+      const bool kIsReadable = connection.input.read(_fd);
+      bool isResponded = true;
+      connection.input.consume(alignment_, [this, &connection, &isResponded](UnpackBuffer & _frame) {
+        isResponded = isResponded && respond(connection, _frame);
+      });
+      connection.is_closing = !kIsReadable || !isResponded;
+    }
+    // Responses to requests received before end of input are written before closing
+    bool isAlive = flush(connection);
+    if (isAlive && connection.is_closing) {
+      isAlive = (connection.events & EPOLLOUT) != 0;
+    }
+    if (!isAlive) {
+      ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, _fd, nullptr);
+      ::close(_fd);
+      connections_.erase(found);
+    }
+  }
+
+  /**
+   * Method for writing of queued responses, if socket is full writing continues on EPOLLOUT.
+   * Closing connection waits only for EPOLLOUT, because end of input is always readable
+   * @return Return false if connection failed, true otherwise
+   */
+  bool flush(Connection & _connection) {
+    bool result = _connection.sender.flush();
+    const bool kIsWriting = !result && (errno == EAGAIN || errno == EWOULDBLOCK);
+    result = result || kIsWriting;
+    const uint32_t kEvents = (_connection.is_closing ? 0u : static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP)) |
+                             (kIsWriting ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    if (result && kEvents != _connection.events) {
+      epoll_event event{};
+      event.events = kEvents;
+      event.data.fd = _connection.fd;
+      ::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, _connection.fd, &event);
+      _connection.events = kEvents;
+    }
+    return result;
+  }
+
+  /**
+   * Method for processing of one request and queueing of its response
+   * @return Return false if response could not be queued and connection should be closed, true otherwise
+   */
+  bool respond(Connection & _connection, UnpackBuffer & _frame) {
+    if (_frame.getBufferSize() < sizeof(RpcFormat::Header)) {
+      return true;
+    }
+    RpcFormat::Header header = _frame.get<RpcFormat::Header>();
+    PooledPackBuffer response(pool_);
+    const size_t kMethod = header.method;
+    RpcStatus status = RpcStatus::UnknownMethod;
+    if (kMethod < handlers_.size() && handlers_[kMethod]) {
+      header.status = static_cast<uint16_t>(RpcStatus::Ok);
+      response.put(header);
+#ifdef __cpp_exceptions
+      try {
+        status = handlers_[kMethod](_frame, response) ? RpcStatus::Ok : RpcStatus::InternalError;
+      } catch (const std::out_of_range &) {
+        status = RpcStatus::BadRequest;
+      } catch (...) {
+        status = RpcStatus::InternalError;
+      }
+#else
+      status = handlers_[kMethod](_frame, response) ? RpcStatus::Ok : RpcStatus::InternalError;
+#endif
+    }
+    if (status != RpcStatus::Ok) {
+      header.status = static_cast<uint16_t>(status);
+      response.reset();
+      response.put(header);
+    }
+    // If pool could not provide buffer even for error response, client would wait for it forever,
+    // so connection is closed and client completes pending requests with RpcStatus::Disconnected
+    FrozenMessage message = response.freeze();
+    const bool kResult = static_cast<bool>(message);
+    if (kResult) {
+      _connection.sender.send(std::move(message));
+    }
+    return kResult;
+  }
+
+  const std::string path_;
+  const AlignMemory alignment_;
+  PackBufferPool pool_;
+  int listen_fd_;
+  int epoll_fd_;
+  int wake_fd_;
+  std::atomic<bool> is_stopped_;
+  std::vector<std::function<bool(UnpackBuffer &, PackBuffer &)>> handlers_;
+  std::unordered_map<int, std::unique_ptr<Connection>> connections_;
+};
+
+/**
+ * RPC client, requests could be pipelined: send() queues request, flush() writes all queued
+ * requests with one batched write and poll() delivers responses to callbacks.
+ * Client is not thread-safe, every thread should use its own client
+ */
+class RpcClient {
+ public:
+  using Callback = std::function<void(RpcStatus, UnpackBuffer *)>;
+
+  /**
+   * Constructor which connects to server
+   * @param _path Path of server socket
+   * @param _bufferSize Size of pooled request buffers, it limits size of request
+   * @param _alignment Alignment of packed data
+   */
+  explicit RpcClient(const std::string & _path,
+                     const size_t _bufferSize = RpcFormat::kDefaultBufferSize,
+                     AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : alignment_{_alignment}
+      , pool_(_bufferSize, _alignment)
+      , fd_{-1}
+      , input_(_bufferSize)
+      , next_correlation_id_{1} {
+    if (!open(_path)) {
+#ifdef __cpp_exceptions
+      const int kError = errno;
+      close();
+      throw std::system_error(kError, std::system_category(), "Could not connect to " + _path);
+#else
+      close();
+#endif
+    }
+  }
+
+  RpcClient(const RpcClient&) = delete;
+  RpcClient& operator=(const RpcClient&) = delete;
+
+  ~RpcClient() {
+    close();
+  }
+
+  bool isOpen() const {
+    return fd_ >= 0;
+  }
+
+  int getFd() const {
+    return fd_;
+  }
+
+  /**
+   * Method for queueing of request, it is written by flush() or when sender thresholds are reached
+   * @tparam Request Type of request, method is MessageTypeId<Request>
+   * @param _request Request
+   * @param _callback Function called from poll() with status and response buffer (nullptr on error)
+   * @return Correlation id of request or 0 if request could not be packed
+   */
+  template <typename Request>
+  uint64_t send(const Request & _request, Callback _callback) {
+    uint64_t result = 0;
+    if (isOpen()) {
+      RpcFormat::Header header{};
+      header.correlation_id = next_correlation_id_;
+      header.method = MessageTypeId<Request>::value;
+      PooledPackBuffer buffer(pool_);
+      if (buffer.put(header) && buffer.put(_request)) {
+        pending_.emplace(header.correlation_id, std::move(_callback));
+        result = next_correlation_id_++;
+        if (!sender_->send(buffer.freeze()) && errno != EAGAIN && errno != EWOULDBLOCK) {
+          disconnect();
+        }
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for queueing of request with typed response
+   * @tparam Response Type of response
+   * @tparam Request Type of request
+   * @tparam F Type of function with signature void(RpcStatus status, Response && response)
+   */
+  template <typename Response, typename Request, typename F>
+  uint64_t send(const Request & _request, F _fn) {
+    return send(_request, Callback([_fn](const RpcStatus _status, UnpackBuffer * _response) {
+      _fn(_status, _response ? _response->get<Response>() : Response());
+    }));
+  }
+
+  /**
+   * Method for writing of all queued requests
+   * @return Return false if connection failed, true otherwise
+   */
+  bool flush() {
+    bool result = isOpen() && (sender_->flush() || errno == EAGAIN || errno == EWOULDBLOCK);
+    if (isOpen() && !result) {
+      disconnect();
+    }
+    return result;
+  }
+
+  /**
+   * Method for waiting and delivering of responses
+   * @param _timeoutMs Maximal time of waiting, -1 waits infinitely
+   * @return Number of delivered responses
+   */
+  size_t poll(const int _timeoutMs) {
+    size_t result = 0;
+    wait(_timeoutMs, result);
+    return result;
+  }
+
+  /**
+   * Method for synchronous call
+   * @tparam Response Type of response
+   * @tparam Request Type of request
+   * @param _request Request
+   * @param _response Received response
+   * @param _timeoutMs Maximal time of waiting for every socket event, -1 waits infinitely
+   * @return Status of call, RpcStatus::Disconnected also on timeout
+   */
+  template <typename Response, typename Request>
+  RpcStatus call(const Request & _request, Response & _response, const int _timeoutMs = -1) {
+    RpcStatus result = RpcStatus::Disconnected;
+    bool isDone = false;
+    const uint64_t kId = send(_request, Callback([&](const RpcStatus _status, UnpackBuffer * _buffer) {
+      result = _status;
+      if (_buffer) {
+        _response = _buffer->get<Response>();
+      }
+      isDone = true;
+    }));
+    if (kId != 0 && flush()) {
+      size_t delivered = 0;
+      while (!isDone && wait(_timeoutMs, delivered)) {
+      }
+    }
+    pending_.erase(kId);
+    return result;
+  }
+
+  size_t getPendingCount() const {
+    return pending_.size();
+  }
+
+ private:
+  bool open(const std::string & _path) {
+    sockaddr_un address;
+    if (!RpcFormat::makeAddress(_path, address)) {
+      return false;
+    }
+    fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    bool result = (fd_ >= 0) &&
+                  (::connect(fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0) &&
+                  (::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) | O_NONBLOCK) == 0);
+    if (result) {
+      sender_.reset(new CoalescingSender(fd_, RpcFormat::getSenderOptions()));
+    }
+    return result;
+  }
+
+  void close() {
+    sender_.reset();
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  /**
+   * Method for waiting of socket events and delivering of received responses
+   * @param _timeoutMs Maximal time of waiting, -1 waits infinitely
+   * @param _delivered Number of delivered responses is added to it
+   * @return Return false on timeout or if connection is closed, true otherwise
+   */
+  bool wait(const int _timeoutMs, size_t & _delivered) {
+    bool result = false;
+    if (isOpen()) {
+      pollfd descriptor{fd_, POLLIN, 0};
+      if (sender_->getPendingCount() > 0) {
+        descriptor.events |= POLLOUT;
+      }
+      const int kCount = ::poll(&descriptor, 1, _timeoutMs);
+      result = (kCount > 0) || (kCount < 0 && errno == EINTR);
+      if (kCount > 0 && (descriptor.revents & POLLOUT)) {
+        flush();
+      }
+      if (kCount > 0 && isOpen() && (descriptor.revents & (POLLIN | POLLHUP | POLLERR))) {
+        const bool kIsAlive = input_.read(fd_);
+        input_.consume(alignment_, [this, &_delivered](UnpackBuffer & _frame) {
+          _delivered += deliver(_frame);
+        });
+        if (!kIsAlive) {
+          disconnect();
+        }
+      }
+      result = result && isOpen();
+    }
+    return result;
+  }
+
+  /**
+   * Method for closing of connection, all pending requests are completed with RpcStatus::Disconnected
+   */
+  void disconnect() {
+    close();
+    std::unordered_map<uint64_t, Callback> pending;
+    pending.swap(pending_);
+    for (auto & request : pending) {
+      request.second(RpcStatus::Disconnected, nullptr);
+    }
+  }
+
+  size_t deliver(UnpackBuffer & _frame) {
+    size_t result = 0;
+    if (_frame.getBufferSize() >= sizeof(RpcFormat::Header)) {
+      const RpcFormat::Header kHeader = _frame.get<RpcFormat::Header>();
+      auto found = pending_.find(kHeader.correlation_id);
+      if (found != pending_.end()) {
+        Callback callback = std::move(found->second);
+        pending_.erase(found);
+        const RpcStatus kStatus = static_cast<RpcStatus>(kHeader.status);
+        callback(kStatus, kStatus == RpcStatus::Ok ? &_frame : nullptr);
+        result = 1;
+      }
+    }
+    return result;
+  }
+
+  const AlignMemory alignment_;
+  PackBufferPool pool_;
+  int fd_;
+  std::unique_ptr<CoalescingSender> sender_;
+  RpcInput input_;
+  uint64_t next_correlation_id_;
+  std::unordered_map<uint64_t, Callback> pending_;
+};
+}
+
+#endif //BUFFERS_RPC_HPP
@@ -0,0 +1,416 @@
+/**
+ * @file SharedMemoryQueue.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains cross-process multi-producer/single-consumer queue of packed messages
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_SHAREDMEMORYQUEUE_HPP
+#define BUFFERS_SHAREDMEMORYQUEUE_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "RecordWriter.hpp"
+
+namespace buffers {
+/**
+ * Multi-producer/single-consumer queue which lives in POSIX shared memory.
+ * Producers from any process claim space with atomic reservation and pack directly to it,
+ * consumer unpacks records in place and sleeps on futex when queue is empty.
+ * Every record starts with 64-bit header which is zero till commit:
+ *     record size (high 32 bits) | payload size or padding marker (low 32 bits)
+ * Consumer zeroes consumed records, so headers of the next lap start uncommitted.
+ * If producer dies between reservation and commit, consumer stalls on its record
+ */
+class SharedMemoryQueue {
+ public:
+  enum class OpenMode {
+    Create,
+    Open,
+  };
+
+  static constexpr size_t kDefaultCapacity = 1 << 20;
+
+  /**
+   * Buffer of producer, packs one record directly to the shared memory.
+   * Every producer thread should use its own Writer
+   */
+  using Writer = RecordWriter<SharedMemoryQueue>;
+
+  /**
+   * Constructor which creates or opens shared memory queue
+   * @param _name Name of shared memory object, for example "/my_queue"
+   * @param _mode Create new queue (consumer) or open existing one (producer)
+   * @param _capacity Capacity in bytes for created queue, rounded up to the power of two
+   * @param _alignment Alignment of packed data for created queue
+   */
+  SharedMemoryQueue(const std::string & _name,
+                    const OpenMode _mode,
+                    const size_t _capacity = kDefaultCapacity,
+                    AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : control_{nullptr}
+      , data_{nullptr}
+      , map_size_{0}
+      , capacity_{0}
+      , mask_{0}
+      , alignment_{_alignment}
+      , read_offset_{kNoRecord} {
+    const bool kResult = (_mode == OpenMode::Create) ? create(_name, _capacity) : open(_name);
+    if (kResult) {
+      reader_.reset(new QueueUnpackBuffer(nullptr, 0, alignment_));
+    } else {
+#ifdef __cpp_exceptions
+      const int kError = errno;
+      close();
+      throw std::system_error(kError, std::system_category(), "Could not map shared memory " + _name);
+#else
+      close();
+#endif
+    }
+  }
+
+  SharedMemoryQueue(const SharedMemoryQueue&) = delete;
+  SharedMemoryQueue& operator=(const SharedMemoryQueue&) = delete;
+
+  ~SharedMemoryQueue() {
+    close();
+  }
+
+  /**
+   * Method for removing of shared memory object name, mapped queues stay valid
+   * @param _name Name of shared memory object
+   * @return Return true if name is removed, false otherwise
+   */
+  static bool remove(const std::string & _name) {
+    return ::shm_unlink(_name.c_str()) == 0;
+  }
+
+  bool isOpen() const {
+    return control_ != nullptr;
+  }
+
+  size_t getCapacity() const {
+    return capacity_;
+  }
+
+  AlignMemory getAlignment() const {
+    return alignment_;
+  }
+
+  /**
+   * Method for packing of one value as record, could be called by any producer.
+   * Type T should provide getTypeSize(), otherwise use Writer with known size
+   * @tparam T Type of value
+   * @param _t Value for packing
+   * @return Return true if value is published, false if queue is full
+   */
+  template <typename T>
+  bool tryPush(const T & _t) {
+    return Writer::push(*this, _t);
+  }
+
+  /**
+   * Method for getting of the next record, called only by consumer
+   * @return Pointer to the buffer for unpacking of record or nullptr if queue is empty
+   */
+  UnpackBuffer * beginRead() {
+    UnpackBuffer * result = nullptr;
+    if (read_offset_ != kNoRecord) {
+      result = reader_.get();
+    }
+    if (result == nullptr && isOpen()) {
+      const size_t kOffset = skipPadding();
+      const uint64_t kHeader = header(kOffset).load(std::memory_order_acquire);
+      if (kHeader != 0) {
+        read_offset_ = kOffset;
+        reader_->bind(data() + kOffset + kHeaderSize, static_cast<uint32_t>(kHeader));
+        result = reader_.get();
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for releasing of record returned by beginRead(), called only by consumer
+   */
+  void commitRead() {
+    if (read_offset_ != kNoRecord) {
+      const uint64_t kHeader = header(read_offset_).load(std::memory_order_relaxed);
+      release(read_offset_, static_cast<size_t>(kHeader >> 32));
+      read_offset_ = kNoRecord;
+      skipPadding();
+    }
+  }
+
+  /**
+   * Method for unpacking of one value from the next record, called only by consumer
+   * @tparam T Type of value
+   * @param _t Unpacked value
+   * @return Return true if value is unpacked, false if queue is empty
+   */
+  template <typename T>
+  bool tryPop(T & _t) {
+    bool result = false;
+    UnpackBuffer * pBuffer = beginRead();
+    if (pBuffer) {
+      _t = pBuffer->get<T>();
+      commitRead();
+      result = true;
+    }
+    return result;
+  }
+
+  /**
+   * Method for sleeping till record is published, called only by consumer
+   * @param _timeout Maximal time of sleeping
+   * @return Return true if record is available, false on timeout
+   */
+  bool wait(const std::chrono::nanoseconds _timeout) {
+    bool result = isReadable();
+    if (!result && isOpen()) {
+      const uint32_t kSequence = control_->wake_sequence.load(std::memory_order_acquire);
+      control_->waiting.store(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      result = isReadable();
+      if (!result) {
+        timespec timeout;
+        timeout.tv_sec = static_cast<time_t>(_timeout.count() / 1000000000);
+        timeout.tv_nsec = static_cast<long>(_timeout.count() % 1000000000);
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&control_->wake_sequence),
+                  FUTEX_WAIT, kSequence, &timeout, nullptr, 0);
+        result = isReadable();
+      }
+      control_->waiting.store(0, std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+ private:
+  friend Writer;
+
+  static constexpr uint32_t kMagic = 0x51425550;  // "PUBQ"
+  static constexpr size_t kCacheLineSize = 64;
+  static constexpr size_t kHeaderSize = RecordFormat::kHeaderSize;
+  static constexpr size_t kPaddingMarker = RecordFormat::kSkipMarker;
+  static constexpr size_t kNoRecord = RecordFormat::kNoRecord;
+
+  /**
+   * Control block at the beginning of shared memory, hot fields are on separate cache lines
+   */
+  struct Control {
+    uint32_t magic;
+    uint32_t alignment;
+    uint64_t capacity;
+    char padding0[kCacheLineSize - 2 * sizeof(uint64_t)];
+    std::atomic<uint64_t> reserved;
+    char padding1[kCacheLineSize - sizeof(uint64_t)];
+    std::atomic<uint64_t> head;
+    char padding2[kCacheLineSize - sizeof(uint64_t)];
+    std::atomic<uint32_t> wake_sequence;
+    std::atomic<uint32_t> waiting;
+    char padding3[kCacheLineSize - 2 * sizeof(uint32_t)];
+  };
+
+  class QueueUnpackBuffer : public UnpackBuffer {
+   public:
+    QueueUnpackBuffer(uint8_t const * const _pMsg, const size_t _size, AlignMemory _alignment)
+        : UnpackBuffer(_pMsg, _size, _alignment) {
+    }
+
+    void bind(uint8_t const * const _pMsg, const size_t _size) {
+      rebind(_pMsg, _size);
+    }
+  };
+
+  uint8_t * data() const {
+    return data_;
+  }
+
+  std::atomic<uint64_t> & header(const size_t _offset) const {
+    return *reinterpret_cast<std::atomic<uint64_t> *>(data_ + _offset);
+  }
+
+  bool create(const std::string & _name, const size_t _capacity) {
+    size_t capacity = kCacheLineSize;
+    while (capacity < _capacity) {
+      capacity <<= 1;
+    }
+    const int kFd = ::shm_open(_name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    bool result = (kFd >= 0) &&
+                  (::ftruncate(kFd, sizeof(Control) + capacity) == 0) &&
+                  map(kFd, sizeof(Control) + capacity);
+    if (kFd >= 0) {
+      ::close(kFd);
+    }
+    if (result) {
+      control_->alignment = static_cast<uint32_t>(alignment_);
+      control_->capacity = capacity;
+      control_->reserved.store(0, std::memory_order_relaxed);
+      control_->head.store(0, std::memory_order_relaxed);
+      control_->wake_sequence.store(0, std::memory_order_relaxed);
+      control_->waiting.store(0, std::memory_order_relaxed);
+      control_->magic = kMagic;
+      std::atomic_thread_fence(std::memory_order_release);
+      setCapacity(capacity);
+    }
+    return result;
+  }
+
+  bool open(const std::string & _name) {
+    const int kFd = ::shm_open(_name.c_str(), O_RDWR, 0600);
+    struct stat fileStat;
+    bool result = (kFd >= 0) &&
+                  (::fstat(kFd, &fileStat) == 0) &&
+                  (static_cast<size_t>(fileStat.st_size) > sizeof(Control)) &&
+                  map(kFd, static_cast<size_t>(fileStat.st_size));
+    if (kFd >= 0) {
+      ::close(kFd);
+    }
+    if (result) {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      // Alignment is used as divisor, so queue created with unknown alignment is not opened
+      result = (control_->magic == kMagic) &&
+               (sizeof(Control) + control_->capacity <= map_size_) &&
+               isValidAlignment(control_->alignment);
+      if (result) {
+        alignment_ = static_cast<AlignMemory>(control_->alignment);
+        setCapacity(static_cast<size_t>(control_->capacity));
+      } else {
+        errno = EINVAL;
+      }
+    }
+    return result;
+  }
+
+  bool map(const int _fd, const size_t _size) {
+    void * pMap = ::mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    bool result = (pMap != MAP_FAILED);
+    if (result) {
+      map_size_ = _size;
+      control_ = static_cast<Control *>(pMap);
+      data_ = static_cast<uint8_t *>(pMap) + sizeof(Control);
+    }
+    return result;
+  }
+
+  void setCapacity(const size_t _capacity) {
+    capacity_ = _capacity;
+    mask_ = _capacity - 1;
+  }
+
+  void close() {
+    if (control_) {
+      ::munmap(control_, map_size_);
+      control_ = nullptr;
+      data_ = nullptr;
+      map_size_ = 0;
+    }
+  }
+
+  /**
+   * Method for atomic reservation of record, record which does not fit till the end
+   * of queue is placed at the beginning and the rest of queue is published as padding
+   * @return Offset of reserved record or kNoRecord if queue is full
+   */
+  size_t reserve(const size_t _recordSize) {
+    size_t result = kNoRecord;
+    if (isOpen() && _recordSize <= capacity_) {
+      uint64_t position = control_->reserved.load(std::memory_order_relaxed);
+      size_t tillEnd;
+      bool isReserved = false;
+      do {
+        const size_t kOffset = position & mask_;
+        tillEnd = capacity_ - kOffset;
+        const size_t kRequired = (tillEnd < _recordSize) ? (tillEnd + _recordSize) : _recordSize;
+        if (position + kRequired - control_->head.load(std::memory_order_acquire) > capacity_) {
+          break;
+        }
+        isReserved = control_->reserved.compare_exchange_weak(position, position + kRequired,
+                                                             std::memory_order_relaxed);
+      } while (!isReserved);
+      if (isReserved) {
+        result = position & mask_;
+        if (tillEnd < _recordSize) {
+          publish(result, tillEnd, kPaddingMarker);
+          result = 0;
+        }
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for publishing of record header and waking up of consumer if it sleeps
+   */
+  void publish(const size_t _offset, const size_t _recordSize, const size_t _payloadSize) {
+    const uint64_t kHeader = (static_cast<uint64_t>(_recordSize) << 32) | static_cast<uint32_t>(_payloadSize);
+    header(_offset).store(kHeader, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (control_->waiting.load(std::memory_order_relaxed) != 0) {
+      control_->wake_sequence.fetch_add(1, std::memory_order_release);
+      ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&control_->wake_sequence),
+                FUTEX_WAKE, 1, nullptr, nullptr, 0);
+    }
+  }
+
+  /**
+   * Method for zeroing of consumed record and moving of head after it
+   */
+  void release(const size_t _offset, const size_t _recordSize) {
+    std::memset(data() + _offset + kHeaderSize, 0, _recordSize - kHeaderSize);
+    header(_offset).store(0, std::memory_order_relaxed);
+    control_->head.fetch_add(_recordSize, std::memory_order_release);
+  }
+
+  /**
+   * Method for releasing of published padding records at head, so producers get their space back
+   * @return Offset of head after padding
+   */
+  size_t skipPadding() {
+    size_t offset = control_->head.load(std::memory_order_relaxed) & mask_;
+    uint64_t recordHeader = header(offset).load(std::memory_order_acquire);
+    while (recordHeader != 0 && static_cast<uint32_t>(recordHeader) == kPaddingMarker) {
+      release(offset, static_cast<size_t>(recordHeader >> 32));
+      offset = control_->head.load(std::memory_order_relaxed) & mask_;
+      recordHeader = header(offset).load(std::memory_order_acquire);
+    }
+    return offset;
+  }
+
+  bool isReadable() const {
+    bool result = false;
+    if (isOpen()) {
+      const size_t kOffset = control_->head.load(std::memory_order_relaxed) & mask_;
+      result = (header(kOffset).load(std::memory_order_acquire) != 0) || (read_offset_ != kNoRecord);
+    }
+    return result;
+  }
+
+  Control * control_;
+  uint8_t * data_;
+  size_t map_size_;
+  size_t capacity_;
+  size_t mask_;
+  AlignMemory alignment_;
+  size_t read_offset_;
+  std::unique_ptr<QueueUnpackBuffer> reader_;
+};
+}
+
+#endif //BUFFERS_SHAREDMEMORYQUEUE_HPP
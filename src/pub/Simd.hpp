@@ -0,0 +1,24 @@
+/**
+ * @file Simd.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains detection of SIMD intrinsics used by encoding kernels
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_SIMD_HPP
+#define BUFFERS_SIMD_HPP
+
+// Kernels are compiled with target attributes and selected at runtime with __builtin_cpu_supports,
+// so intrinsics are available without -m flags only for GCC and Clang
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BUFFERS_HAS_X86_SIMD 1
+#endif
+
+// 64-bit pdep/pext
+#if defined(BUFFERS_HAS_X86_SIMD) && defined(__x86_64__)
+#define BUFFERS_HAS_BMI2 1
+#endif
+
+#endif //BUFFERS_SIMD_HPP
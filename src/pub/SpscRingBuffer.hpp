@@ -0,0 +1,303 @@
+/**
+ * @file SpscRingBuffer.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains lock-free single-producer/single-consumer ring buffer of packed messages
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_SPSCRINGBUFFER_HPP
+#define BUFFERS_SPSCRINGBUFFER_HPP
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "Frame.hpp"
+
+namespace buffers {
+/**
+ * Lock-free ring buffer for one producer thread and one consumer thread.
+ * Messages are packed directly into ring memory and unpacked from it without copying.
+ * Every record is a frame aligned to 8 bytes, record which does not fit till the end of ring
+ * is preceded by wrap marker and placed at the beginning
+ */
+class SpscRingBuffer {
+ public:
+  static constexpr size_t kCacheLineSize = 64;
+
+  /**
+   * Constructor of ring buffer
+   * @param _capacity Capacity in bytes, rounded up to the power of two
+   * @param _alignment Alignment of packed data
+   */
+  explicit SpscRingBuffer(const size_t _capacity,
+                          AlignMemory _alignment = static_cast<AlignMemory>(sizeof(int)))
+      : capacity_{roundUpToPowerOfTwo(_capacity < kMinCapacity ? kMinCapacity : _capacity)}
+      , mask_{capacity_ - 1}
+      , header_size_{FrameFormat::getHeaderSize(_alignment)}
+      , storage_(new uint64_t[capacity_ / sizeof(uint64_t)])
+      , padding0_()
+      , head_{0}
+      , cached_tail_{0}
+      , reader_(_alignment)
+      , padding1_()
+      , tail_{0}
+      , cached_head_{0}
+      , write_offset_{kNoRecord}
+      , writer_(_alignment)
+      , padding2_() {
+  }
+
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  /**
+   * Method for starting of writing, called only by producer
+   * @param _size Size of message if it is known, otherwise 0 and all contiguous free space is used
+   * @return Pointer to the buffer for packing of message or nullptr if ring is full
+   */
+  PackBuffer * beginWrite(const size_t _size = 0) {
+    PackBuffer * result = nullptr;
+    if (write_offset_ == kNoRecord) {
+      const size_t kRequired = (_size > 0) ? getRecordSize(_size) : (header_size_ + sizeof(uint64_t));
+      size_t available = getContiguousSpace((_size > 0) ? kRequired : getSpaceTillEnd());
+      if (available < kRequired && (tail_.load(std::memory_order_relaxed) & mask_) != 0 && wrap()) {
+        available = getContiguousSpace((_size > 0) ? kRequired : getSpaceTillEnd());
+      }
+      if (available >= kRequired) {
+        write_offset_ = tail_.load(std::memory_order_relaxed) & mask_;
+        writer_.bind(data() + write_offset_ + header_size_, available - header_size_);
+        result = &writer_;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for publishing of message packed after beginWrite(), called only by producer
+   * @return Return true if message is published, false otherwise
+   */
+  bool commitWrite() {
+    bool result = false;
+    if (write_offset_ != kNoRecord) {
+      const size_t kSize = writer_.getDataSize();
+      FrameFormat::writeHeader(data() + write_offset_, kSize, writer_.getAlignment());
+      tail_.store(tail_.load(std::memory_order_relaxed) + getRecordSize(kSize),
+                  std::memory_order_release);
+      write_offset_ = kNoRecord;
+      result = true;
+    }
+    return result;
+  }
+
+  /**
+   * Method for dropping of message started by beginWrite(), called only by producer
+   */
+  void abortWrite() {
+    write_offset_ = kNoRecord;
+  }
+
+  /**
+   * Method for packing of one value as message, called only by producer.
+   * If value does not fit till the end of ring, it is packed again after wrap
+   * @tparam T Type of value
+   * @param _t Value for packing
+   * @return Return true if value is published, false if there is no space
+   */
+  template <typename T>
+  bool tryPush(const T & _t) {
+    bool result = false;
+    PackBuffer * pBuffer = beginWrite();
+    if (pBuffer) {
+      result = pBuffer->put(_t);
+      if (!result) {
+        abortWrite();
+        if ((tail_.load(std::memory_order_relaxed) & mask_) != 0 && wrap()) {
+          pBuffer = beginWrite();
+          result = pBuffer && pBuffer->put(_t);
+          if (!result) {
+            abortWrite();
+          }
+        }
+      }
+      if (result) {
+        commitWrite();
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for getting of the next message, called only by consumer
+   * @return Pointer to the buffer for unpacking of message or nullptr if ring is empty
+   */
+  UnpackBuffer * beginRead() {
+    UnpackBuffer * result = nullptr;
+    size_t head = head_.load(std::memory_order_relaxed);
+    while (result == nullptr && isReadable(head)) {
+      uint8_t const * pRecord = data() + (head & mask_);
+      const size_t kSize = FrameFormat::readHeader(pRecord);
+      if (kSize == kWrapMarker) {
+        head += capacity_ - (head & mask_);
+        head_.store(head, std::memory_order_release);
+      } else {
+        reader_.bind(pRecord + header_size_, kSize);
+        result = &reader_;
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Method for releasing of message returned by beginRead(), called only by consumer
+   */
+  void commitRead() {
+    const size_t kHead = head_.load(std::memory_order_relaxed);
+    if (isReadable(kHead)) {
+      const size_t kSize = FrameFormat::readHeader(data() + (kHead & mask_));
+      head_.store(kHead + getRecordSize(kSize), std::memory_order_release);
+    }
+  }
+
+  /**
+   * Method for unpacking of one value from the next message, called only by consumer
+   * @tparam T Type of value
+   * @param _t Unpacked value
+   * @return Return true if value is unpacked, false if ring is empty
+   */
+  template <typename T>
+  bool tryPop(T & _t) {
+    bool result = false;
+    UnpackBuffer * pBuffer = beginRead();
+    if (pBuffer) {
+      _t = pBuffer->get<T>();
+      commitRead();
+      result = true;
+    }
+    return result;
+  }
+
+  size_t getCapacity() const {
+    return capacity_;
+  }
+
+  /**
+   * Method for checking if ring is empty, result is approximate if called concurrently
+   * @return Return true if ring is empty, false otherwise
+   */
+  bool empty() const {
+    return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+  }
+
+ private:
+  static constexpr size_t kMinCapacity = 64;
+  static constexpr size_t kRecordAlignment = sizeof(uint64_t);
+  static constexpr size_t kWrapMarker = 0xFFFFFFFF;
+  static constexpr size_t kNoRecord = static_cast<size_t>(-1);
+
+  class RingPackBuffer : public PackBuffer {
+   public:
+    explicit RingPackBuffer(AlignMemory _alignment)
+        : PackBuffer(nullptr, 0, _alignment) {
+    }
+
+    void bind(uint8_t * const _pMsg, const size_t _size) {
+      reset();
+      rebind(_pMsg, _size);
+    }
+  };
+
+  class RingUnpackBuffer : public UnpackBuffer {
+   public:
+    explicit RingUnpackBuffer(AlignMemory _alignment)
+        : UnpackBuffer(nullptr, 0, _alignment) {
+    }
+
+    void bind(uint8_t const * const _pMsg, const size_t _size) {
+      rebind(_pMsg, _size);
+    }
+  };
+
+  static size_t roundUpToPowerOfTwo(const size_t _size) {
+    size_t result = 1;
+    while (result < _size) {
+      result <<= 1;
+    }
+    return result;
+  }
+
+  uint8_t * data() const {
+    return reinterpret_cast<uint8_t *>(storage_.get());
+  }
+
+  size_t getRecordSize(const size_t _payloadSize) const {
+    return (header_size_ + _payloadSize + kRecordAlignment - 1) / kRecordAlignment * kRecordAlignment;
+  }
+
+  size_t getSpaceTillEnd() const {
+    return capacity_ - (tail_.load(std::memory_order_relaxed) & mask_);
+  }
+
+  /**
+   * Method for getting of free space from tail till the end of ring or till head.
+   * Cached head is refreshed only if it does not give enough space, so message of unknown size
+   * should require all space till the end, otherwise stale head could shrink the space forever
+   */
+  size_t getContiguousSpace(const size_t _required) {
+    const size_t kTail = tail_.load(std::memory_order_relaxed);
+    size_t free = capacity_ - (kTail - cached_head_);
+    if (free < _required) {
+      cached_head_ = head_.load(std::memory_order_acquire);
+      free = capacity_ - (kTail - cached_head_);
+    }
+    const size_t kTillEnd = getSpaceTillEnd();
+    return (free < kTillEnd) ? free : kTillEnd;
+  }
+
+  /**
+   * Method for publishing of wrap marker, so the next record starts at the beginning of ring
+   */
+  bool wrap() {
+    const size_t kTail = tail_.load(std::memory_order_relaxed);
+    const size_t kTillEnd = getSpaceTillEnd();
+    bool result = (getContiguousSpace(kTillEnd) == kTillEnd);
+    if (result) {
+      const uint32_t kMarker = static_cast<uint32_t>(kWrapMarker);
+      std::memcpy(data() + (kTail & mask_), &kMarker, sizeof(kMarker));
+      tail_.store(kTail + kTillEnd, std::memory_order_release);
+    }
+    return result;
+  }
+
+  bool isReadable(const size_t _head) {
+    if (_head == cached_tail_) {
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    return _head != cached_tail_;
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  const size_t header_size_;
+  std::unique_ptr<uint64_t[]> storage_;
+
+  // Padding keeps consumer and producer indices on separate cache lines
+  // without over-aligned allocation, which is not supported by new before C++17
+  char padding0_[kCacheLineSize];
+  std::atomic<size_t> head_;
+  size_t cached_tail_;
+  RingUnpackBuffer reader_;
+
+  char padding1_[kCacheLineSize];
+  std::atomic<size_t> tail_;
+  size_t cached_head_;
+  size_t write_offset_;
+  RingPackBuffer writer_;
+
+  char padding2_[kCacheLineSize];
+};
+}
+
+#endif //BUFFERS_SPSCRINGBUFFER_HPP
@@ -0,0 +1,459 @@
+/**
+ * @file StreamVByte.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains StreamVByte compression of integer vectors with SIMD kernels
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_STREAMVBYTE_HPP
+#define BUFFERS_STREAMVBYTE_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+#include "EncodedVector.hpp"
+#include "Simd.hpp"
+
+namespace buffers {
+/**
+ * StreamVByte encoding: control bytes with 2-bit length codes of four values are stored
+ * separately from data bytes, so SIMD kernels decode four values with one shuffle.
+ * 32-bit values take 1, 2, 3 or 4 bytes, 64-bit values take 1, 2, 4 or 8 bytes (scalar only).
+ * Signed values are zigzag encoded, so small negative values stay short
+ */
+class StreamVByte {
+ public:
+  enum class Kernel {
+    Scalar,
+    Sse41,
+    Avx2,
+  };
+
+  /**
+   * Method for checking whether CPU supports kernel
+   */
+  static bool isSupported(const Kernel _kernel) {
+#ifdef BUFFERS_HAS_X86_SIMD
+    switch (_kernel) {
+      case Kernel::Avx2: return __builtin_cpu_supports("avx2");
+      case Kernel::Sse41: return __builtin_cpu_supports("sse4.1");
+      default: return true;
+    }
+#else
+    return _kernel == Kernel::Scalar;
+#endif
+  }
+
+  /**
+   * Method for getting the fastest kernel supported by CPU, it is detected once
+   */
+  static Kernel getBestKernel() {
+    static const Kernel kKernel = isSupported(Kernel::Avx2) ? Kernel::Avx2
+                                  : isSupported(Kernel::Sse41) ? Kernel::Sse41
+                                  : Kernel::Scalar;
+    return kKernel;
+  }
+
+  static size_t getControlSize(const size_t _count) {
+    return (_count + 3) / 4;
+  }
+
+  /**
+   * Method for encoding of values
+   * @param _pIn Values
+   * @param _count Number of values
+   * @param _pControl Destination of getControlSize(_count) control bytes
+   * @param _pData Destination of data bytes
+   * @param _pDataEnd End of memory available for data bytes
+   * @param _kernel Kernel for 32-bit values
+   * @return End of data bytes or nullptr if they do not fit
+   */
+  template <typename T>
+  static uint8_t * encode(const T * _pIn, const size_t _count, uint8_t * _pControl,
+                          uint8_t * _pData, uint8_t * const _pDataEnd,
+                          const Kernel _kernel = getBestKernel()) {
+    static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "StreamVByte supports only 32-bit and 64-bit integers !!");
+    std::memset(_pControl, 0, getControlSize(_count));
+    return encodeValues(_pIn, _count, _pControl, _pData, _pDataEnd, _kernel);
+  }
+
+  /**
+   * Method for decoding of values
+   * @param _pControl Control bytes
+   * @param _pData Data bytes
+   * @param _pDataEnd End of data bytes
+   * @param _count Number of values
+   * @param _pOut Destination of values
+   * @param _kernel Kernel for 32-bit values
+   * @return End of consumed data bytes or nullptr if data is truncated
+   */
+  template <typename T>
+  static uint8_t const * decode(uint8_t const * _pControl, uint8_t const * _pData,
+                                uint8_t const * const _pDataEnd, const size_t _count, T * _pOut,
+                                const Kernel _kernel = getBestKernel()) {
+    static_assert(std::is_integral<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "StreamVByte supports only 32-bit and 64-bit integers !!");
+    return decodeValues(_pControl, _pData, _pDataEnd, _count, _pOut, _kernel);
+  }
+
+ private:
+  struct Tables {
+    Tables() {
+      for (unsigned control = 0; control < 256; ++control) {
+        unsigned offset = 0;
+        std::memset(decode_shuffle[control], 0xFF, 16);
+        std::memset(encode_shuffle[control], 0xFF, 16);
+        for (unsigned lane = 0; lane < 4; ++lane) {
+          const unsigned kLength = ((control >> (2 * lane)) & 3) + 1;
+          for (unsigned k = 0; k < kLength; ++k) {
+            decode_shuffle[control][4 * lane + k] = static_cast<uint8_t>(offset + k);
+            encode_shuffle[control][offset + k] = static_cast<uint8_t>(4 * lane + k);
+          }
+          offset += kLength;
+        }
+        lengths[control] = static_cast<uint8_t>(offset);
+      }
+    }
+
+    uint8_t decode_shuffle[256][16];
+    uint8_t encode_shuffle[256][16];
+    uint8_t lengths[256];
+  };
+
+  static const Tables & getTables() {
+    static const Tables kTables;
+    return kTables;
+  }
+
+  template <typename T>
+  static typename std::enable_if<std::is_signed<T>::value, typename std::make_unsigned<T>::type>::type
+  toUnsigned(const T _value) {
+    using U = typename std::make_unsigned<T>::type;
+    return static_cast<U>(static_cast<U>(_value) << 1) ^ static_cast<U>(_value >> (8 * sizeof(T) - 1));
+  }
+
+  template <typename T>
+  static typename std::enable_if<!std::is_signed<T>::value, T>::type toUnsigned(const T _value) {
+    return _value;
+  }
+
+  template <typename T, typename U>
+  static typename std::enable_if<std::is_signed<T>::value, T>::type fromUnsigned(const U _value) {
+    return static_cast<T>((_value >> 1) ^ (~(_value & 1) + 1));
+  }
+
+  template <typename T, typename U>
+  static typename std::enable_if<!std::is_signed<T>::value, T>::type fromUnsigned(const U _value) {
+    return static_cast<T>(_value);
+  }
+
+  template <typename U>
+  static unsigned getCode(const U _value) {
+    return (sizeof(U) == 4)
+           ? (_value > 0xFF) + (_value > 0xFFFF) + (_value > 0xFFFFFF)
+           : (_value > 0xFF) + (_value > 0xFFFF) + (_value > 0xFFFFFFFFu);
+  }
+
+  static unsigned getLength(const unsigned _code, const size_t _valueSize) {
+    return (_valueSize == 4) ? (_code + 1) : (1u << _code);
+  }
+
+  /**
+   * Scalar encoding of values from _index, it is also the tail of SIMD kernels
+   */
+  template <typename T>
+  static uint8_t * encodeScalar(const T * _pIn, size_t _index, const size_t _count, uint8_t * _pControl,
+                                uint8_t * _pData, uint8_t * const _pDataEnd) {
+    for (; _index < _count; ++_index) {
+      const auto kValue = toUnsigned(_pIn[_index]);
+      const unsigned kCode = getCode(kValue);
+      const unsigned kLength = getLength(kCode, sizeof(T));
+      if (static_cast<size_t>(_pDataEnd - _pData) < kLength) {
+        return nullptr;
+      }
+      for (unsigned k = 0; k < kLength; ++k) {
+        *_pData++ = static_cast<uint8_t>(kValue >> (8 * k));
+      }
+      _pControl[_index / 4] |= static_cast<uint8_t>(kCode << (2 * (_index % 4)));
+    }
+    return _pData;
+  }
+
+  template <typename T>
+  static uint8_t const * decodeScalar(uint8_t const * _pControl, uint8_t const * _pData,
+                                      uint8_t const * const _pDataEnd, size_t _index, const size_t _count,
+                                      T * _pOut) {
+    using U = typename std::make_unsigned<T>::type;
+    for (; _index < _count; ++_index) {
+      const unsigned kCode = (_pControl[_index / 4] >> (2 * (_index % 4))) & 3;
+      const unsigned kLength = getLength(kCode, sizeof(T));
+      if (static_cast<size_t>(_pDataEnd - _pData) < kLength) {
+        return nullptr;
+      }
+      U value = 0;
+      for (unsigned k = 0; k < kLength; ++k) {
+        value |= static_cast<U>(static_cast<U>(*_pData++) << (8 * k));
+      }
+      _pOut[_index] = fromUnsigned<T>(value);
+    }
+    return _pData;
+  }
+
+  template <typename T>
+  static typename std::enable_if<(sizeof(T) == 8), uint8_t *>::type
+  encodeValues(const T * _pIn, const size_t _count, uint8_t * _pControl,
+               uint8_t * _pData, uint8_t * const _pDataEnd, const Kernel) {
+    return encodeScalar(_pIn, 0, _count, _pControl, _pData, _pDataEnd);
+  }
+
+  template <typename T>
+  static typename std::enable_if<(sizeof(T) == 8), uint8_t const *>::type
+  decodeValues(uint8_t const * _pControl, uint8_t const * _pData, uint8_t const * const _pDataEnd,
+               const size_t _count, T * _pOut, const Kernel) {
+    return decodeScalar(_pControl, _pData, _pDataEnd, 0, _count, _pOut);
+  }
+
+  template <typename T>
+  static typename std::enable_if<(sizeof(T) == 4), uint8_t *>::type
+  encodeValues(const T * _pIn, const size_t _count, uint8_t * _pControl,
+               uint8_t * _pData, uint8_t * const _pDataEnd, const Kernel _kernel) {
+    const bool kZigzag = std::is_signed<T>::value;
+    const uint32_t * pIn = reinterpret_cast<const uint32_t *>(_pIn);
+    size_t index = 0;
+#ifdef BUFFERS_HAS_X86_SIMD
+    if (_kernel == Kernel::Avx2) {
+      _pData = encodeAvx2(pIn, _count, index, _pControl, _pData, _pDataEnd, kZigzag);
+    } else if (_kernel == Kernel::Sse41) {
+      _pData = encodeSse41(pIn, _count, index, _pControl, _pData, _pDataEnd, kZigzag);
+    }
+#else
+    (void)_kernel;
+    (void)kZigzag;
+    (void)pIn;
+#endif
+    return encodeScalar(_pIn, index, _count, _pControl, _pData, _pDataEnd);
+  }
+
+  template <typename T>
+  static typename std::enable_if<(sizeof(T) == 4), uint8_t const *>::type
+  decodeValues(uint8_t const * _pControl, uint8_t const * _pData, uint8_t const * const _pDataEnd,
+               const size_t _count, T * _pOut, const Kernel _kernel) {
+    const bool kZigzag = std::is_signed<T>::value;
+    uint32_t * pOut = reinterpret_cast<uint32_t *>(_pOut);
+    size_t index = 0;
+#ifdef BUFFERS_HAS_X86_SIMD
+    if (_kernel == Kernel::Avx2) {
+      _pData = decodeAvx2(_pControl, _pData, _pDataEnd, _count, index, pOut, kZigzag);
+    } else if (_kernel == Kernel::Sse41) {
+      _pData = decodeSse41(_pControl, _pData, _pDataEnd, _count, index, pOut, kZigzag);
+    }
+#else
+    (void)_kernel;
+    (void)kZigzag;
+    (void)pOut;
+#endif
+    return decodeScalar(_pControl, _pData, _pDataEnd, index, _count, _pOut);
+  }
+
+#ifdef BUFFERS_HAS_X86_SIMD
+  /**
+   * Method for getting length codes of four values in 32-bit lanes: 3 + (value <= 0xFF) + ... where
+   * comparison result is -1, unsigned comparison is done with min
+   */
+  __attribute__((target("sse4.1")))
+  static unsigned getControlSse41(const __m128i _values) {
+    const __m128i kLe1 = _mm_cmpeq_epi32(_mm_min_epu32(_values, _mm_set1_epi32(0xFF)), _values);
+    const __m128i kLe2 = _mm_cmpeq_epi32(_mm_min_epu32(_values, _mm_set1_epi32(0xFFFF)), _values);
+    const __m128i kLe3 = _mm_cmpeq_epi32(_mm_min_epu32(_values, _mm_set1_epi32(0xFFFFFF)), _values);
+    __m128i codes = _mm_add_epi32(_mm_set1_epi32(3), _mm_add_epi32(kLe1, _mm_add_epi32(kLe2, kLe3)));
+    codes = _mm_mullo_epi32(codes, _mm_setr_epi32(1, 4, 16, 64));
+    codes = _mm_hadd_epi32(codes, codes);
+    codes = _mm_hadd_epi32(codes, codes);
+    return static_cast<unsigned>(_mm_cvtsi128_si32(codes));
+  }
+
+  __attribute__((target("sse4.1")))
+  static uint8_t * encodeSse41(const uint32_t * _pIn, const size_t _count, size_t & _index,
+                               uint8_t * _pControl, uint8_t * _pData, uint8_t * const _pDataEnd,
+                               const bool _zigzag) {
+    const Tables & kTables = getTables();
+    for (; _index + 4 <= _count && _pDataEnd - _pData >= 16; _index += 4) {
+      __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_pIn + _index));
+      if (_zigzag) {
+        values = _mm_xor_si128(_mm_slli_epi32(values, 1), _mm_srai_epi32(values, 31));
+      }
+      const unsigned kControl = getControlSse41(values);
+      const __m128i kShuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kTables.encode_shuffle[kControl]));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(_pData), _mm_shuffle_epi8(values, kShuffle));
+      _pControl[_index / 4] = static_cast<uint8_t>(kControl);
+      _pData += kTables.lengths[kControl];
+    }
+    return _pData;
+  }
+
+  __attribute__((target("sse4.1")))
+  static uint8_t const * decodeSse41(uint8_t const * _pControl, uint8_t const * _pData,
+                                     uint8_t const * const _pDataEnd, const size_t _count, size_t & _index,
+                                     uint32_t * _pOut, const bool _zigzag) {
+    const Tables & kTables = getTables();
+    for (; _index + 4 <= _count && _pDataEnd - _pData >= 16; _index += 4) {
+      const uint8_t kControl = _pControl[_index / 4];
+      const __m128i kShuffle = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kTables.decode_shuffle[kControl]));
+      __m128i values = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(_pData)), kShuffle);
+      if (_zigzag) {
+        values = _mm_xor_si128(_mm_srli_epi32(values, 1),
+                               _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(values, _mm_set1_epi32(1))));
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(_pOut + _index), values);
+      _pData += kTables.lengths[kControl];
+    }
+    return _pData;
+  }
+
+  /**
+   * AVX2 kernels process two control bytes at once, every 128-bit lane is one group of four values
+   */
+  __attribute__((target("avx2")))
+  static uint8_t * encodeAvx2(const uint32_t * _pIn, const size_t _count, size_t & _index,
+                              uint8_t * _pControl, uint8_t * _pData, uint8_t * const _pDataEnd,
+                              const bool _zigzag) {
+    const Tables & kTables = getTables();
+    for (; _index + 8 <= _count && _pDataEnd - _pData >= 32; _index += 8) {
+      __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_pIn + _index));
+      if (_zigzag) {
+        values = _mm256_xor_si256(_mm256_slli_epi32(values, 1), _mm256_srai_epi32(values, 31));
+      }
+      const __m256i kLe1 = _mm256_cmpeq_epi32(_mm256_min_epu32(values, _mm256_set1_epi32(0xFF)), values);
+      const __m256i kLe2 = _mm256_cmpeq_epi32(_mm256_min_epu32(values, _mm256_set1_epi32(0xFFFF)), values);
+      const __m256i kLe3 = _mm256_cmpeq_epi32(_mm256_min_epu32(values, _mm256_set1_epi32(0xFFFFFF)), values);
+      __m256i codes = _mm256_add_epi32(_mm256_set1_epi32(3), _mm256_add_epi32(kLe1, _mm256_add_epi32(kLe2, kLe3)));
+      codes = _mm256_mullo_epi32(codes, _mm256_setr_epi32(1, 4, 16, 64, 1, 4, 16, 64));
+      codes = _mm256_hadd_epi32(codes, codes);
+      codes = _mm256_hadd_epi32(codes, codes);
+      const unsigned kControl0 = static_cast<unsigned>(_mm256_extract_epi32(codes, 0));
+      const unsigned kControl1 = static_cast<unsigned>(_mm256_extract_epi32(codes, 4));
+      const __m128i kShuffle0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kTables.encode_shuffle[kControl0]));
+      const __m128i kShuffle1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kTables.encode_shuffle[kControl1]));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(_pData),
+                       _mm_shuffle_epi8(_mm256_castsi256_si128(values), kShuffle0));
+      _pData += kTables.lengths[kControl0];
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(_pData),
+                       _mm_shuffle_epi8(_mm256_extracti128_si256(values, 1), kShuffle1));
+      _pData += kTables.lengths[kControl1];
+      _pControl[_index / 4] = static_cast<uint8_t>(kControl0);
+      _pControl[_index / 4 + 1] = static_cast<uint8_t>(kControl1);
+    }
+    return _pData;
+  }
+
+  __attribute__((target("avx2")))
+  static uint8_t const * decodeAvx2(uint8_t const * _pControl, uint8_t const * _pData,
+                                    uint8_t const * const _pDataEnd, const size_t _count, size_t & _index,
+                                    uint32_t * _pOut, const bool _zigzag) {
+    const Tables & kTables = getTables();
+    for (; _index + 8 <= _count && _pDataEnd - _pData >= 32; _index += 8) {
+      const uint8_t kControl0 = _pControl[_index / 4];
+      const uint8_t kControl1 = _pControl[_index / 4 + 1];
+      const __m128i kLow = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_pData));
+      const __m128i kHigh = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_pData + kTables.lengths[kControl0]));
+      const __m256i kData = _mm256_inserti128_si256(_mm256_castsi128_si256(kLow), kHigh, 1);
+      const __m256i kShuffle = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(kTables.decode_shuffle[kControl0]))),
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(kTables.decode_shuffle[kControl1])), 1);
+      __m256i values = _mm256_shuffle_epi8(kData, kShuffle);
+      if (_zigzag) {
+        values = _mm256_xor_si256(_mm256_srli_epi32(values, 1),
+                                  _mm256_sub_epi32(_mm256_setzero_si256(),
+                                                   _mm256_and_si256(values, _mm256_set1_epi32(1))));
+      }
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(_pOut + _index), values);
+      _pData += kTables.lengths[kControl0] + kTables.lengths[kControl1];
+    }
+    return _pData;
+  }
+#endif
+};
+
+/**
+ * Encoding of integer array with StreamVByte, layout:
+ *     count | size of encoded bytes | control bytes | data bytes | padding
+ */
+struct StreamVByteFormat {
+  using SizeType = size_t;
+
+  template <typename TBufferContext, typename T>
+  static bool put(TBufferContext & _ctx, const std::vector<T> & _vector) {
+    bool result = false;
+    const size_t kHeaderSize = 2 * getAlignedSize(sizeof(SizeType), _ctx.alignment());
+    const size_t kControlSize = StreamVByte::getControlSize(_vector.size());
+    if (kHeaderSize + kControlSize <= _ctx.buffer_size()) {
+      uint8_t * const pControl = _ctx.buffer() + kHeaderSize;
+      uint8_t * const pDataEnd = StreamVByte::encode(_vector.data(), _vector.size(), pControl,
+                                                     pControl + kControlSize, _ctx.buffer() + _ctx.buffer_size());
+      const size_t kEncodedSize = pDataEnd ? static_cast<size_t>(pDataEnd - pControl) : 0;
+      if (pDataEnd && kHeaderSize + getAlignedSize(kEncodedSize, _ctx.alignment()) <= _ctx.buffer_size()) {
+        PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, _vector.size());
+        PackBuffer::DelegatePackBuffer<SizeType>{}.put(_ctx, kEncodedSize);
+        _ctx += kEncodedSize;
+        result = true;
+      }
+    }
+    return result;
+  }
+
+  template <typename T>
+  static size_t getTypeSize(const std::vector<T> & _vector) {
+    return 2 * sizeof(SizeType) + StreamVByte::getControlSize(_vector.size()) + sizeof(T) * _vector.size();
+  }
+
+  template <typename TBufferContext, typename T>
+  static void get(TBufferContext & _ctx, std::vector<T> & _result) {
+    const SizeType kCount = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    const SizeType kEncodedSize = UnpackBuffer::DelegateUnpackBuffer<SizeType>{}.get(_ctx);
+    const size_t kControlSize = StreamVByte::getControlSize(kCount);
+    uint8_t const * pDataEnd = nullptr;
+    if (kEncodedSize <= _ctx.buffer_size() && kControlSize <= kEncodedSize) {
+      uint8_t const * const pControl = _ctx.buffer();
+      _result.resize(kCount);
+      pDataEnd = StreamVByte::decode(pControl, pControl + kControlSize, pControl + kEncodedSize,
+                                     kCount, _result.data());
+    }
+    if (pDataEnd == nullptr) {
+#ifdef __cpp_exceptions
+      throw std::out_of_range("StreamVByte data is out of buffer !!");
+#else
+      _result.clear();
+#endif
+    }
+    _ctx += (pDataEnd != nullptr) ? kEncodedSize : 0;
+  }
+};
+
+/**
+ * std::vector of 32-bit or 64-bit integers which is packed with StreamVByte
+ */
+template <typename T>
+using StreamVByteVector = EncodedVector<T, StreamVByteFormat>;
+
+template <typename T>
+using StreamVByteView = EncodedView<T, StreamVByteFormat>;
+
+/**
+ * Method for packing of existing vector with StreamVByte without copying:
+ *     buffer.put(buffers::streamVByte(histogram));
+ * Packed data is unpacked as StreamVByteVector
+ */
+template <typename T>
+StreamVByteView<T> streamVByte(const std::vector<T> & _vector) {
+  return StreamVByteView<T>(_vector);
+}
+}
+
+#endif //BUFFERS_STREAMVBYTE_HPP
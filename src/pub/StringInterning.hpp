@@ -0,0 +1,321 @@
+/**
+ * @file StringInterning.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains session-level string interning encoder and decoder
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_STRINGINTERNING_HPP
+#define BUFFERS_STRINGINTERNING_HPP
+
+#include <stdint.h>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AlignMemory.hpp"
+#include "PackBuffer.hpp"
+#include "UnpackBuffer.hpp"
+
+namespace buffers {
+/**
+ * Every interned string is packed as uint32_t reference. Reference kNewString is followed by
+ * null-terminated string which takes the next slot of dictionary, reference kLiteral is followed
+ * by string which is not interned, other references are slot + 1 of already sent string.
+ * Slots are reused in round-robin order, so encoder and decoder evict the same strings
+ * as long as messages are decoded in the order they were packed
+ */
+struct InternFormat {
+  using Reference = uint32_t;
+
+  static constexpr Reference kNewString = 0;
+  static constexpr Reference kLiteral = 0xFFFFFFFF;
+  static constexpr size_t kDefaultCapacity = 4096;
+  static constexpr size_t kDefaultMaxStringSize = 256;
+};
+
+class InternEncoder;
+
+/**
+ * Wrapper for packing of string through session dictionary:
+ *     buffer.put(encoder.intern(symbol));
+ * Packed data is unpacked with InternDecoder::get
+ */
+struct InternedString {
+  InternedString(InternEncoder & _encoder, const std::string & _string)
+      : encoder(_encoder)
+      , string(_string) {
+  }
+
+  InternEncoder & encoder;
+  const std::string & string;
+};
+
+/**
+ * Encoder side of session dictionary, it is not thread-safe and should be used for one
+ * ordered session. Every message packed with it should be delivered, otherwise call reset()
+ * on both sides.
+ * Interned string put inside of other value (struct, container or tuple) should be packed
+ * in transaction, so strings added by failed put of that value are removed from dictionary:
+ *     encoder.pack(buffer, value);
+ * or
+ *     encoder.mark();
+ *     buffer.put(value) ? encoder.commit() : encoder.rollback();
+ */
+class InternEncoder {
+ public:
+  /**
+   * Constructor of encoder
+   * @param _capacity Number of dictionary slots, it should be the same for decoder
+   * @param _maxStringSize Longer strings are sent as literals and are not interned
+   */
+  explicit InternEncoder(const size_t _capacity = InternFormat::kDefaultCapacity,
+                         const size_t _maxStringSize = InternFormat::kDefaultMaxStringSize)
+      : capacity_{_capacity}
+      , max_string_size_{_maxStringSize}
+      , next_slot_{0}
+      , is_marked_{false} {
+    indexes_.reserve(_capacity);
+    keys_.reserve(_capacity);
+  }
+
+  InternEncoder(const InternEncoder &) = delete;
+  InternEncoder & operator=(const InternEncoder &) = delete;
+
+  InternedString intern(const std::string & _string) {
+    return InternedString(*this, _string);
+  }
+
+  /**
+   * Method for starting of transaction, strings added after it are removed by rollback()
+   */
+  void mark() {
+    pending_.clear();
+    is_marked_ = true;
+  }
+
+  /**
+   * Method for keeping of strings added in transaction, should be called when value is packed
+   */
+  void commit() {
+    pending_.clear();
+    is_marked_ = false;
+  }
+
+  /**
+   * Method for removing of strings added in transaction, should be called when put of value failed
+   */
+  void rollback() {
+    rollbackFrom(0);
+    is_marked_ = false;
+  }
+
+  /**
+   * Method for packing of value with interned strings inside of it in transaction
+   * @return Return true if packing is succeed, false otherwise
+   */
+  template <typename T>
+  bool pack(PackBuffer & _buffer, const T & _value) {
+    mark();
+    const bool kResult = _buffer.put(_value);
+    if (kResult) {
+      commit();
+    } else {
+      rollback();
+    }
+    return kResult;
+  }
+
+  /**
+   * Method for packing of string, dictionary is changed only if string is packed.
+   * In transaction strings added at offset _offset or after it are removed first, because
+   * enclosing put was rolled back and is retried
+   * @param _offset Offset of string from the beginning of packed data
+   * @return Return true if packing is succeed, false otherwise
+   */
+  template <typename TBufferContext>
+  bool put(TBufferContext & _ctx, const std::string & _string, const size_t _offset) {
+    using Reference = InternFormat::Reference;
+    bool result = false;
+    if (is_marked_) {
+      rollbackFrom(_offset);
+    }
+    auto iter = indexes_.find(_string);
+    if (iter != indexes_.end()) {
+      result = PackBuffer::DelegatePackBuffer<Reference>{}.put(_ctx, static_cast<Reference>(iter->second + 1));
+    } else {
+      const bool kIsInterned = capacity_ > 0 && _string.size() <= max_string_size_;
+      if (getAlignedSize(sizeof(Reference), _ctx.alignment()) + _string.size() + 1 <= _ctx.buffer_size()) {
+        Reference reference = InternFormat::kLiteral;
+        if (kIsInterned) {
+          reference = InternFormat::kNewString;
+        }
+        PackBuffer::DelegatePackBuffer<Reference>{}.put(_ctx, reference);
+        PackBuffer::DelegatePackBuffer<std::string>{}.put(_ctx, _string);
+        if (kIsInterned) {
+          add(_string, _offset);
+        }
+        result = true;
+      }
+    }
+    return result;
+  }
+
+  static size_t getTypeSize(const std::string & _string) {
+    return sizeof(InternFormat::Reference) + _string.size() + 1;
+  }
+
+  /**
+   * Method for clearing of dictionary, decoder should be reset at the same point of session
+   */
+  void reset() {
+    indexes_.clear();
+    keys_.clear();
+    next_slot_ = 0;
+    pending_.clear();
+  }
+
+  size_t getCapacity() const {
+    return capacity_;
+  }
+
+  size_t getSize() const {
+    return keys_.size();
+  }
+
+ private:
+  /**
+   * String added in transaction, evicted string is kept to restore the slot on rollback
+   */
+  struct Pending {
+    size_t offset;
+    size_t slot;
+    bool has_evicted;
+    std::string evicted;
+  };
+
+  void add(const std::string & _string, const size_t _offset) {
+    const size_t kSlot = next_slot_;
+    const bool kHasEvicted = keys_.size() == capacity_;
+    if (is_marked_) {
+      pending_.push_back(Pending{_offset, kSlot, kHasEvicted, kHasEvicted ? *keys_[kSlot] : std::string()});
+    }
+    if (kHasEvicted) {
+      indexes_.erase(indexes_.find(*keys_[kSlot]));
+    } else {
+      keys_.push_back(nullptr);
+    }
+    keys_[kSlot] = &indexes_.emplace(_string, static_cast<uint32_t>(kSlot)).first->first;
+    next_slot_ = (kSlot + 1) % capacity_;
+  }
+
+  /**
+   * Method for removing of strings added in transaction at offset _offset or after it, latest first
+   */
+  void rollbackFrom(const size_t _offset) {
+    while (!pending_.empty() && pending_.back().offset >= _offset) {
+      Pending & pending = pending_.back();
+      indexes_.erase(indexes_.find(*keys_[pending.slot]));
+      if (pending.has_evicted) {
+        keys_[pending.slot] = &indexes_.emplace(std::move(pending.evicted),
+                                                static_cast<uint32_t>(pending.slot)).first->first;
+      } else {
+        keys_.pop_back();
+      }
+      next_slot_ = pending.slot;
+      pending_.pop_back();
+    }
+  }
+
+  const size_t capacity_;
+  const size_t max_string_size_;
+  size_t next_slot_;
+  std::unordered_map<std::string, uint32_t> indexes_;
+  // Keys of indexes_ by slot, references to keys of unordered_map are stable
+  std::vector<const std::string *> keys_;
+  bool is_marked_;
+  std::vector<Pending> pending_;
+};
+
+/**
+ * Decoder side of session dictionary, strings are shared between all messages which reference them,
+ * so repeated strings are not allocated again
+ */
+class InternDecoder {
+ public:
+  /**
+   * Constructor of decoder
+   * @param _capacity Number of dictionary slots, it should be the same as for encoder
+   */
+  explicit InternDecoder(const size_t _capacity = InternFormat::kDefaultCapacity)
+      : strings_(_capacity)
+      , next_slot_{0} {
+  }
+
+  InternDecoder(const InternDecoder &) = delete;
+  InternDecoder & operator=(const InternDecoder &) = delete;
+
+  /**
+   * Method for unpacking of string packed with InternEncoder
+   * @return Shared string or nullptr if reference is unknown or data is out of buffer
+   */
+  std::shared_ptr<const std::string> get(UnpackBuffer & _buffer) {
+    using Reference = InternFormat::Reference;
+    std::shared_ptr<const std::string> result;
+    const Reference kReference = _buffer.get<Reference>();
+    if (kReference == InternFormat::kNewString || kReference == InternFormat::kLiteral) {
+      const bool kIsInterned = kReference == InternFormat::kNewString;
+      uint8_t const * pString = _buffer.getData() + (_buffer.getDataSize() - _buffer.getBufferSize());
+      if ((!kIsInterned || !strings_.empty()) &&
+          std::memchr(pString, 0, _buffer.getBufferSize()) != nullptr) {
+        result = std::make_shared<const std::string>(_buffer.get<const char *>());
+        if (kIsInterned) {
+          strings_[next_slot_] = result;
+          next_slot_ = (next_slot_ + 1) % strings_.size();
+        }
+      }
+    } else if (kReference - 1 < strings_.size()) {
+      result = strings_[kReference - 1];
+    }
+    if (!result) {
+#ifdef __cpp_exceptions
+      throw std::out_of_range("Interned string reference is unknown or out of buffer !!");
+#endif
+    }
+    return result;
+  }
+
+  void reset() {
+    for (auto & string : strings_) {
+      string.reset();
+    }
+    next_slot_ = 0;
+  }
+
+  size_t getCapacity() const {
+    return strings_.size();
+  }
+
+ private:
+  std::vector<std::shared_ptr<const std::string>> strings_;
+  size_t next_slot_;
+};
+
+template <>
+class PackBuffer::DelegatePackBuffer<InternedString> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const InternedString & _interned) {
+    return _interned.encoder.put(_ctx, _interned.string, _ctx.msg_size_);
+  }
+
+  static size_t getTypeSize(const InternedString & _interned) {
+    return InternEncoder::getTypeSize(_interned.string);
+  }
+};
+}
+
+#endif //BUFFERS_STRINGINTERNING_HPP
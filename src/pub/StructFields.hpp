@@ -0,0 +1,56 @@
+/**
+ * @file StructFields.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains registration of struct fields for field-wise encodings
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_STRUCTFIELDS_HPP
+#define BUFFERS_STRUCTFIELDS_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace buffers {
+/**
+ * Trait with fields of struct which is encoded field-wise, should be specialized for every such struct:
+ *     template <>
+ *     struct StructFields<Quote> {
+ *       template <typename TVisitor>
+ *       static void visit(TVisitor & _visitor) {
+ *         _visitor(&Quote::bid);
+ *         _visitor(&Quote::ask);
+ *       }
+ *     };
+ * Visitor is called with pointer to every field in the same order, so order of fields is
+ * a part of format and new fields should be appended
+ * @tparam T Type of struct
+ */
+template <typename T>
+struct StructFields {
+};
+
+/**
+ * Helper for checking whether StructFields is specialized for type
+ */
+template <typename T>
+class HasStructFields {
+  struct Probe {
+    template <typename M>
+    void operator()(const M &) {
+    }
+  };
+
+  template <typename U>
+  static auto check(int) -> decltype(StructFields<U>::visit(std::declval<Probe &>()), std::true_type());
+
+  template <typename U>
+  static std::false_type check(long);
+
+ public:
+  static constexpr bool value = decltype(check<T>(0))::value;
+};
+}
+
+#endif //BUFFERS_STRUCTFIELDS_HPP
@@ -0,0 +1,269 @@
+/**
+ * @file ThreadPool.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains work-stealing thread pool used for parallel packing and unpacking
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_THREADPOOL_HPP
+#define BUFFERS_THREADPOOL_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace buffers {
+/**
+ * Fixed size pool of worker threads with work stealing.
+ * Every worker has its own queue of tasks, tasks posted from worker go to its queue,
+ * idle worker steals the oldest task from queues of other workers
+ */
+class ThreadPool {
+ public:
+  /**
+   * Constructor of thread pool
+   * @param _threadsCount Number of worker threads, caller of parallelFor() works as well
+   */
+  explicit ThreadPool(const size_t _threadsCount = getDefaultThreadsCount())
+      : queues_(_threadsCount)
+      , pending_{0}
+      , next_queue_{0}
+      , is_stopped_{false} {
+    for (size_t i = 0; i < _threadsCount; ++i) {
+      queues_[i].reset(new WorkerQueue());
+    }
+    for (size_t i = 0; i < _threadsCount; ++i) {
+      workers_.emplace_back(&ThreadPool::run, this, i);
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * Destructor, waits till all posted tasks are finished
+   */
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      is_stopped_ = true;
+    }
+    condition_.notify_all();
+    for (auto & worker : workers_) {
+      worker.join();
+    }
+  }
+
+  static size_t getDefaultThreadsCount() {
+    const size_t kHardwareThreads = std::thread::hardware_concurrency();
+    return (kHardwareThreads > 1) ? (kHardwareThreads - 1) : 0;
+  }
+
+  size_t getThreadsCount() const {
+    return workers_.size();
+  }
+
+  /**
+   * Method for posting of task to the pool.
+   * Task posted from worker of this pool goes to its own queue, otherwise queues are used round-robin
+   * @param _task Task to be executed by one of worker threads
+   */
+  void post(std::function<void()> _task) {
+    if (queues_.empty()) {
+      _task();
+      return;
+    }
+    size_t index = getWorkerIndex();
+    if (index >= queues_.size()) {
+      index = next_queue_++ % queues_.size();
+    }
+    {
+      std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+      queues_[index]->tasks.push_back(std::move(_task));
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++pending_;
+    }
+    condition_.notify_one();
+  }
+
+  /**
+   * Method for calling of function for every index in parallel, blocks till all calls are finished.
+   * Indices are split between caller and workers, participant which finished its range
+   * steals half of the rest of range of another participant, so uneven work is balanced
+   * @tparam F Type of function with signature void(size_t)
+   * @param _count Number of indices, should be less than 2^32
+   * @param _fn Function to call
+   */
+  template <typename F>
+  void parallelFor(const size_t _count, F && _fn) {
+    if (_count == 0) {
+      return;
+    }
+    const size_t kHelpers = (workers_.size() < _count - 1) ? workers_.size() : (_count - 1);
+    auto loop = std::make_shared<ParallelLoop>(_count, kHelpers + 1);
+    std::function<void(size_t)> fn = std::forward<F>(_fn);
+    loop->fn = &fn;
+    for (size_t i = 0; i < kHelpers; ++i) {
+      post([loop, i] { loop->process(i + 1); });
+    }
+    loop->process(0);
+    std::unique_lock<std::mutex> lock(loop->mutex);
+    loop->condition.wait(lock, [&loop] { return loop->done == loop->count; });
+  }
+
+ private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  /**
+   * State of one parallelFor() call, shared with helper tasks which could start after it is finished.
+   * Range of every participant is packed to one atomic as begin (high 32 bits) and end (low 32 bits)
+   */
+  struct ParallelLoop {
+    ParallelLoop(const size_t _count, const size_t _participants)
+        : count{_count}
+        , ranges(_participants)
+        , done{0}
+        , fn{nullptr} {
+      for (size_t i = 0; i < _participants; ++i) {
+        ranges[i].store(makeRange(_count * i / _participants, _count * (i + 1) / _participants));
+      }
+    }
+
+    static uint64_t makeRange(const uint64_t _begin, const uint64_t _end) {
+      return (_begin << 32) | _end;
+    }
+
+    void process(const size_t _participant) {
+      std::atomic<uint64_t> & own = ranges[_participant];
+      size_t processed = 0;
+      while (true) {
+        uint64_t range = own.load();
+        uint64_t begin = range >> 32;
+        const uint64_t kEnd = range & 0xFFFFFFFF;
+        if (begin < kEnd) {
+          if (own.compare_exchange_weak(range, makeRange(begin + 1, kEnd))) {
+            (*fn)(static_cast<size_t>(begin));
+            ++processed;
+          }
+        } else if (!steal(_participant)) {
+          break;
+        }
+      }
+      if (processed > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        done += processed;
+        if (done == count) {
+          condition.notify_all();
+        }
+      }
+    }
+
+    /**
+     * Method for stealing of the second half of range of another participant to own range
+     * @return Return true if something is stolen, false if all ranges are empty
+     */
+    bool steal(const size_t _participant) {
+      for (size_t i = 1; i < ranges.size(); ++i) {
+        std::atomic<uint64_t> & victim = ranges[(_participant + i) % ranges.size()];
+        uint64_t range = victim.load();
+        while ((range >> 32) < (range & 0xFFFFFFFF)) {
+          const uint64_t kBegin = range >> 32;
+          const uint64_t kEnd = range & 0xFFFFFFFF;
+          const uint64_t kMiddle = kBegin + (kEnd - kBegin) / 2;
+          if (victim.compare_exchange_weak(range, makeRange(kBegin, kMiddle))) {
+            ranges[_participant].store(makeRange(kMiddle, kEnd));
+            return true;
+          }
+        }
+      }
+      return false;
+    }
+
+    const size_t count;
+    std::vector<std::atomic<uint64_t>> ranges;
+    size_t done;
+    std::function<void(size_t)> * fn;
+    std::mutex mutex;
+    std::condition_variable condition;
+  };
+
+  static size_t & currentWorkerIndex() {
+    static thread_local size_t index = static_cast<size_t>(-1);
+    return index;
+  }
+
+  /**
+   * Method for getting index of worker which calls it
+   * @return Index of worker or size of pool if it is called not from worker of this pool
+   */
+  size_t getWorkerIndex() const {
+    const size_t kIndex = currentWorkerIndex();
+    return (kIndex < workers_.size() && workers_[kIndex].get_id() == std::this_thread::get_id())
+           ? kIndex : workers_.size();
+  }
+
+  /**
+   * Method for taking of task, newest task from own queue or the oldest one from queue of other worker
+   */
+  bool takeTask(const size_t _index, std::function<void()> & _task) {
+    for (size_t i = 0; i < queues_.size(); ++i) {
+      WorkerQueue & queue = *queues_[(_index + i) % queues_.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (!queue.tasks.empty()) {
+        if (i == 0) {
+          _task = std::move(queue.tasks.back());
+          queue.tasks.pop_back();
+        } else {
+          _task = std::move(queue.tasks.front());
+          queue.tasks.pop_front();
+        }
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void run(const size_t _index) {
+    currentWorkerIndex() = _index;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return is_stopped_ || pending_ > 0; });
+        if (pending_ == 0) {
+          break;
+        }
+        --pending_;
+      }
+      // Every pending counter corresponds to the task in one of queues, so the loop is short
+      std::function<void()> task;
+      while (!takeTask(_index, task)) {
+        std::this_thread::yield();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  size_t pending_;
+  std::atomic<size_t> next_queue_;
+  bool is_stopped_;
+  std::vector<std::thread> workers_;
+};
+}
+
+#endif //BUFFERS_THREADPOOL_HPP
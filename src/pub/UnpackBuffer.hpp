@@ -88,7 +88,7 @@ namespace buffers {
         return kNumChunks * kAlignedMemChunk;
       }
 
-      const size_t buf_size_;
+      size_t buf_size_;
       uint8_t const * p_msg_;
       size_t msg_size_;
       AlignMemory alignment_;
@@ -140,6 +140,19 @@ namespace buffers {
         , context_(p_buf_, sizeof(T) * dataLen, _alignment) {
     }
 
+    /**
+     * Copy constructor, new buffer continues unpacking from the same position
+     * @param _other Buffer to copy
+     */
+    UnpackBuffer(const UnpackBuffer & _other)
+        : p_buf_(_other.p_buf_)
+        , context_(_other.p_buf_, _other.context_.buf_size_, _other.context_.alignment_) {
+      context_.p_msg_ = _other.context_.p_msg_;
+      context_.msg_size_ = _other.context_.msg_size_;
+    }
+
+    UnpackBuffer& operator=(const UnpackBuffer&) = delete;
+
     /**
      * Template getting type T from the buffer
      * @tparam T Type for getting from buffer
@@ -163,8 +176,52 @@ namespace buffers {
       context_ -= context_.msg_size_;
     }
 
-   private:
-    const uint8_t * const p_buf_;
+    /**
+     * Method for getting raw pointer to unpacked buffer
+     * @return Raw pointer to the packed data
+     */
+    uint8_t const * getData() const {
+      return p_buf_;
+    }
+
+    /**
+     * Method for getting size of raw pointer to unpacked buffer
+     * @return Size of raw pointer to unpacked buffer
+     */
+    size_t getDataSize() const {
+      return context_.buf_size_;
+    }
+
+    /**
+     * Method for getting size of data that is left to unpack
+     * @return Size of data that is left to unpack
+     */
+    size_t getBufferSize() const {
+      return context_.buffer_size();
+    }
+
+    /**
+     * Method for getting alignment of packed data
+     * @return Alignment which is used for every packed value
+     */
+    AlignMemory getAlignment() const {
+      return context_.alignment_;
+    }
+
+   protected:
+    /**
+     * Method for binding buffer to the new memory, unpacking starts from the beginning
+     * @param _pMsg Pointer to the raw buffer
+     * @param _size Size of raw buffer
+     */
+    void rebind(uint8_t const * const _pMsg, const size_t _size) {
+      p_buf_ = _pMsg;
+      context_.p_msg_ = _pMsg;
+      context_.buf_size_ = _size;
+      context_.msg_size_ = 0;
+    }
+
+    uint8_t const * p_buf_;
     Context context_;
   };
 
@@ -214,6 +271,48 @@ namespace buffers {
     }
   };
 
+  /**
+   * Specialization for std::vector<bool> packed with one bit per value
+   */
+  template<>
+  class UnpackBuffer::DelegateUnpackBuffer<std::vector<bool>> {
+   public:
+    template <typename TBufferContext>
+    static std::vector<bool> get(TBufferContext & _ctx) {
+      std::vector<bool> result;
+      auto size = DelegateUnpackBuffer< typename std::vector<bool>::size_type >{}.get(_ctx);
+      // Size is checked before rounding up, so corrupted size near max of size_t could not wrap
+      const bool kIsValid = size <= 8 * _ctx.buffer_size();
+      const size_t kBytesCount = kIsValid ? (size + 7) / 8 : 0;
+      if (kIsValid) {
+        uint8_t const * pBits = _ctx.buffer();
+        result.resize(size);
+        uint64_t word = 0;
+        for (size_t i = 0; i < size; ++i) {
+          if (i % 64 == 0) {
+            word = getWord(pBits + i / 8, (kBytesCount - i / 8 < sizeof(word)) ? (kBytesCount - i / 8) : sizeof(word));
+          }
+          result[i] = ((word >> (i % 64)) & 1) != 0;
+        }
+        _ctx += kBytesCount;
+      } else {
+      #ifdef __cpp_exceptions
+        throw std::out_of_range("Acquire more memory than is available !!");
+      #endif
+      }
+      return result;
+    }
+
+   private:
+    static uint64_t getWord(uint8_t const * _pBits, const size_t _bytesCount) {
+      uint64_t word = 0;
+      for (size_t i = 0; i < _bytesCount; ++i) {
+        word |= static_cast<uint64_t>(_pBits[i]) << (8 * i);
+      }
+      return word;
+    }
+  };
+
   template<typename T>
   class UnpackBuffer::DelegateUnpackBuffer<std::list<T>> {
    public:
@@ -0,0 +1,106 @@
+/**
+ * @file Varint.hpp
+ * @author Denis Kotov
+ * @date 19 Oct 2026
+ * @brief Contains variable-length encoding of integers
+ * @copyright MIT License. Open source: https://github.com/redradist/PUB.git
+ */
+
+#ifndef BUFFERS_VARINT_HPP
+#define BUFFERS_VARINT_HPP
+
+#include <stdint.h>
+#include <cstddef>
+#include <type_traits>
+
+namespace buffers {
+/**
+ * LEB128 encoding: 7 bits of value per byte, high bit of byte is set if more bytes follow.
+ * Signed values are mapped to unsigned by zigzag, so small negative values stay short
+ */
+struct Varint {
+  static constexpr size_t kMaxSize = 10;
+
+  /**
+   * Method for getting size of encoded value
+   */
+  static size_t getSize(uint64_t _value) {
+    size_t result = 1;
+    while (_value >= 0x80) {
+      _value >>= 7;
+      ++result;
+    }
+    return result;
+  }
+
+  /**
+   * Method for encoding of value, destination should have at least getSize(_value) bytes
+   * @return Pointer after encoded value
+   */
+  static uint8_t * encode(uint64_t _value, uint8_t * _pDst) {
+    while (_value >= 0x80) {
+      *_pDst++ = static_cast<uint8_t>(_value | 0x80);
+      _value >>= 7;
+    }
+    *_pDst++ = static_cast<uint8_t>(_value);
+    return _pDst;
+  }
+
+  /**
+   * Method for decoding of value
+   * @param _pSrc Pointer to encoded value
+   * @param _pEnd End of available data
+   * @param _value Decoded value
+   * @return Pointer after encoded value or nullptr if value is truncated or too long
+   */
+  static uint8_t const * decode(uint8_t const * _pSrc, uint8_t const * _pEnd, uint64_t & _value) {
+    uint64_t value = 0;
+    for (unsigned shift = 0; _pSrc < _pEnd && shift < 64; shift += 7) {
+      const uint8_t kByte = *_pSrc++;
+      value |= static_cast<uint64_t>(kByte & 0x7F) << shift;
+      if ((kByte & 0x80) == 0) {
+        _value = value;
+        return _pSrc;
+      }
+    }
+    return nullptr;
+  }
+
+  static uint64_t zigzag(const int64_t _value) {
+    return (static_cast<uint64_t>(_value) << 1) ^ static_cast<uint64_t>(_value >> 63);
+  }
+
+  static int64_t unzigzag(const uint64_t _value) {
+    return static_cast<int64_t>(_value >> 1) ^ -static_cast<int64_t>(_value & 1);
+  }
+
+  /**
+   * Method for mapping of integer of any width and sign to unsigned value for encoding
+   */
+  template <typename T>
+  static typename std::enable_if<std::is_signed<T>::value, uint64_t>::type
+  toUnsigned(const T _value) {
+    return zigzag(static_cast<int64_t>(_value));
+  }
+
+  template <typename T>
+  static typename std::enable_if<!std::is_signed<T>::value, uint64_t>::type
+  toUnsigned(const T _value) {
+    return static_cast<uint64_t>(_value);
+  }
+
+  template <typename T>
+  static typename std::enable_if<std::is_signed<T>::value, T>::type
+  fromUnsigned(const uint64_t _value) {
+    return static_cast<T>(unzigzag(_value));
+  }
+
+  template <typename T>
+  static typename std::enable_if<!std::is_signed<T>::value, T>::type
+  fromUnsigned(const uint64_t _value) {
+    return static_cast<T>(_value);
+  }
+};
+}
+
+#endif //BUFFERS_VARINT_HPP
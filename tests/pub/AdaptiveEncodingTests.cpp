@@ -0,0 +1,107 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/AdaptiveEncoding.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::AdaptiveVector;
+using buffers::ArrayEncoding;
+
+namespace {
+struct Slot {
+  uint32_t id;
+  uint16_t flags;
+  uint16_t port;
+};
+}
+
+struct AdaptiveEncodingTest : testing::Test
+{
+  HeapPackBuffer buffer{1 << 20};
+
+  /**
+   * Method for getting encoding of the first packed array from its tag
+   */
+  ArrayEncoding getEncoding() const {
+    return static_cast<ArrayEncoding>(buffer.getData()[0]);
+  }
+};
+
+TEST_F(AdaptiveEncodingTest, RunLengthTest) {
+  AdaptiveVector<uint16_t> statuses;
+  for (int i = 0; i < 10000; ++i) {
+    statuses.push_back((i / 1000) % 2 == 0 ? 200 : 503);
+  }
+  ASSERT_EQ(buffer.put(statuses), true);
+  ASSERT_EQ(getEncoding() == ArrayEncoding::RunLength, true);
+  ASSERT_LT(buffer.getDataSize(), 100);
+  ASSERT_EQ(buffer.put(7), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<AdaptiveVector<uint16_t>>(), statuses);
+  ASSERT_EQ(unpack.get<int>(), 7);
+}
+
+TEST_F(AdaptiveEncodingTest, DictionaryTest) {
+  const std::string kSymbols[] = {"AAPL", "MSFT", "GOOG", "AMZN", "NVDA"};
+  std::mt19937 random(11);
+  AdaptiveVector<std::string> symbols;
+  std::vector<Slot> slots;
+  for (int i = 0; i < 5000; ++i) {
+    symbols.push_back(kSymbols[random() % 5]);
+    slots.push_back(Slot{static_cast<uint32_t>(random() % 3), 0, 8080});
+  }
+  ASSERT_EQ(buffer.put(symbols), true);
+  ASSERT_EQ(getEncoding() == ArrayEncoding::Dictionary, true);
+  // Three bits per symbol instead of five bytes
+  ASSERT_LT(buffer.getDataSize(), 5000 * 3 / 8 + 100);
+  ASSERT_EQ(buffer.put(buffers::adaptive(slots)), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<AdaptiveVector<std::string>>(), symbols);
+  const AdaptiveVector<Slot> kSlots = unpack.get<AdaptiveVector<Slot>>();
+  ASSERT_EQ(kSlots.size(), slots.size());
+  ASSERT_EQ(std::memcmp(kSlots.data(), slots.data(), slots.size() * sizeof(Slot)), 0);
+}
+
+TEST_F(AdaptiveEncodingTest, RawTest) {
+  std::mt19937 random(13);
+  AdaptiveVector<uint32_t> values;
+  for (int i = 0; i < 3000; ++i) {
+    values.push_back(static_cast<uint32_t>(random()));
+  }
+  const AdaptiveVector<std::string> kEmpty;
+  const AdaptiveVector<std::string> kNames{"a", "", "bc", "", "def"};
+  ASSERT_EQ(buffer.put(values), true);
+  ASSERT_EQ(getEncoding() == ArrayEncoding::Raw, true);
+  ASSERT_EQ(buffer.put(kEmpty), true);
+  ASSERT_EQ(buffer.put(kNames), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<AdaptiveVector<uint32_t>>(), values);
+  ASSERT_EQ(unpack.get<AdaptiveVector<std::string>>().empty(), true);
+  ASSERT_EQ(unpack.get<AdaptiveVector<std::string>>(), kNames);
+}
+
+TEST_F(AdaptiveEncodingTest, OverflowAndCorruptionTest) {
+  const std::vector<uint64_t> kZeros(1000, 0);
+  uint8_t storage[16];
+  buffers::PackBuffer small(storage, sizeof(storage));
+  ASSERT_EQ(small.put(buffers::adaptive(kZeros)), false);
+  ASSERT_EQ(small.getDataSize(), 0);
+
+  std::vector<uint8_t> levels(64);
+  for (size_t i = 0; i < levels.size(); ++i) {
+    levels[i] = static_cast<uint8_t>(i % 3);
+  }
+  ASSERT_EQ(buffer.put(buffers::adaptive(levels)), true);
+  ASSERT_EQ(getEncoding() == ArrayEncoding::Dictionary, true);
+  // Index 3 is out of dictionary with three values
+  std::vector<uint8_t> corrupted(buffer.getData(), buffer.getData() + buffer.getDataSize());
+  corrupted[corrupted.size() - 4] = 0xFF;
+  UnpackBuffer unpack(corrupted.data(), corrupted.size());
+  ASSERT_THROW(unpack.get<AdaptiveVector<uint8_t>>(), std::out_of_range);
+}
@@ -0,0 +1,137 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/AsyncSocket.hpp"
+
+#if defined(__cpp_impl_coroutine) && (__cplusplus >= 202002L)
+
+#include <memory>
+#include "pub/HeapPackBuffer.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::EpollExecutor;
+using buffers::AsyncSocket;
+using buffers::Task;
+
+struct AsyncPoint {
+  int x = 0;
+  int y = 0;
+};
+
+namespace buffers {
+template <>
+class PackBuffer::DelegatePackBuffer<AsyncPoint> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const AsyncPoint & _point) {
+    return DelegatePackBuffer<int>::put(_ctx, _point.x) &&
+           DelegatePackBuffer<int>::put(_ctx, _point.y);
+  }
+};
+
+template <>
+class UnpackBuffer::DelegateUnpackBuffer<AsyncPoint> {
+ public:
+  template <typename TBufferContext>
+  static AsyncPoint get(TBufferContext & _ctx) {
+    AsyncPoint result;
+    result.x = DelegateUnpackBuffer<int>::get(_ctx);
+    result.y = DelegateUnpackBuffer<int>::get(_ctx);
+    return result;
+  }
+};
+}
+
+struct AsyncSocketTest : testing::Test
+{
+  EpollExecutor executor;
+  std::vector<std::unique_ptr<AsyncSocket>> sockets;
+
+  std::pair<AsyncSocket *, AsyncSocket *> openPair() {
+    int fds[2];
+    EXPECT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    sockets.emplace_back(new AsyncSocket(executor, fds[0]));
+    sockets.emplace_back(new AsyncSocket(executor, fds[1]));
+    return {sockets[sockets.size() - 2].get(), sockets.back().get()};
+  }
+};
+
+static Task<void> sendPoints(AsyncSocket & _socket, const int _count) {
+  for (int i = 0; i < _count; ++i) {
+    HeapPackBuffer buffer(16);
+    buffer.put(AsyncPoint{i, -i});
+    const bool kSent = co_await buffers::asyncSend(_socket, buffer);
+    EXPECT_EQ(kSent, true);
+  }
+  ::shutdown(_socket.getFd(), SHUT_WR);
+}
+
+static Task<void> receivePoints(AsyncSocket & _socket, int & _received) {
+  while (auto point = co_await buffers::asyncReceive<AsyncPoint>(_socket)) {
+    EXPECT_EQ(point->x, _received);
+    EXPECT_EQ(point->y, -_received);
+    ++_received;
+  }
+}
+
+TEST_F(AsyncSocketTest, SendReceiveTest)
+{
+  auto sockets = openPair();
+  int received = 0;
+  executor.spawn(receivePoints(*sockets.second, received));
+  executor.spawn(sendPoints(*sockets.first, 10000));
+  executor.run();
+  ASSERT_EQ(received, 10000);
+  ASSERT_EQ(executor.getTasksCount(), 0);
+}
+
+TEST_F(AsyncSocketTest, LargeMessageTest)
+{
+  auto sockets = openPair();
+  const std::string kLarge(1 << 20, 'p');
+  std::optional<std::string> received;
+  executor.spawn([](AsyncSocket & _socket, const std::string & _str) -> Task<void> {
+    HeapPackBuffer buffer(_str.size() + 16);
+    buffer.put(_str);
+    co_await buffers::asyncSend(_socket, buffer);
+  }(*sockets.first, kLarge));
+  executor.spawn([](AsyncSocket & _socket, std::optional<std::string> & _result) -> Task<void> {
+    _result = co_await buffers::asyncReceive<std::string>(_socket);
+  }(*sockets.second, received));
+  executor.run();
+  ASSERT_EQ(received.has_value(), true);
+  ASSERT_EQ(*received, kLarge);
+}
+
+TEST_F(AsyncSocketTest, ManyConnectionsTest)
+{
+  const int kConnections = 200;
+  std::vector<int> received(kConnections, 0);
+  for (int i = 0; i < kConnections; ++i) {
+    auto sockets = openPair();
+    executor.spawn(receivePoints(*sockets.second, received[i]));
+    executor.spawn(sendPoints(*sockets.first, 50));
+  }
+  executor.run();
+  for (int i = 0; i < kConnections; ++i) {
+    ASSERT_EQ(received[i], 50);
+  }
+}
+
+TEST_F(AsyncSocketTest, ClosedPeerTest)
+{
+  auto sockets = openPair();
+  ::shutdown(sockets.second->getFd(), SHUT_RD);
+  bool sent = true;
+  executor.spawn([](AsyncSocket & _socket, bool & _result) -> Task<void> {
+    HeapPackBuffer buffer(16);
+    buffer.put(AsyncPoint{1, 2});
+    _result = co_await buffers::asyncSend(_socket, buffer);
+  }(*sockets.first, sent));
+  executor.run();
+  ASSERT_EQ(sent, false);
+}
+
+#endif
@@ -0,0 +1,120 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/BitPacked.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::BitPacking;
+using buffers::BitPackedVector;
+
+namespace {
+enum class Direction : uint8_t {
+  North,
+  East,
+  South,
+  West,
+};
+
+enum Level {
+  kLevelDebug,
+  kLevelInfo,
+  kLevelWarning,
+  kLevelError,
+  kLevelFatal,
+};
+}
+
+struct BitPackedTest : testing::Test
+{
+  HeapPackBuffer buffer{1 << 20};
+};
+
+TEST_F(BitPackedTest, KernelsAreIdenticalTest) {
+  std::mt19937 random(3);
+  for (unsigned bits = 1; bits <= BitPacking::getBitsCount(0xFFFFFFFFu); ++bits) {
+    for (const size_t kCount : {0, 1, 8, 13, 1000}) {
+      std::vector<uint32_t> values(kCount);
+      for (auto & value : values) {
+        value = static_cast<uint32_t>(random() & ((uint64_t{1} << bits) - 1));
+      }
+      std::vector<uint8_t> expected(BitPacking::getPackedSize(kCount, bits));
+      BitPacking::pack(values.data(), kCount, bits, expected.data(), BitPacking::Kernel::Scalar);
+      for (const auto kKernel : {BitPacking::Kernel::Scalar, BitPacking::Kernel::Bmi2}) {
+        if (!BitPacking::isSupported(kKernel)) {
+          continue;
+        }
+        std::vector<uint8_t> packed(expected.size());
+        BitPacking::pack(values.data(), kCount, bits, packed.data(), kKernel);
+        ASSERT_EQ(packed, expected);
+        std::vector<uint32_t> unpacked(kCount);
+        BitPacking::unpack(packed.data(), kCount, bits, unpacked.data(), kKernel);
+        ASSERT_EQ(unpacked, values);
+      }
+    }
+  }
+}
+
+TEST_F(BitPackedTest, BoolVectorTest) {
+  std::mt19937 random(9);
+  for (const size_t kCount : {0, 1, 63, 64, 65, 1000}) {
+    std::vector<bool> flags(kCount);
+    for (size_t i = 0; i < kCount; ++i) {
+      flags[i] = (random() % 3) == 0;
+    }
+    buffer.reset();
+    ASSERT_EQ(buffer.put(flags), true);
+    ASSERT_EQ(buffer.put(9), true);
+    // One bit per value, bits are aligned to int like every packed value
+    const size_t kBitsSize = (kCount + 7) / 8;
+    ASSERT_EQ(buffer.getDataSize(), sizeof(size_t) + (kBitsSize + 3) / 4 * 4 + sizeof(int));
+    UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+    ASSERT_EQ(unpack.get<std::vector<bool>>(), flags);
+    ASSERT_EQ(unpack.get<int>(), 9);
+  }
+
+  // Corrupted size could not wrap around on rounding up to bytes
+  buffer.reset();
+  ASSERT_EQ(buffer.put(std::numeric_limits<size_t>::max() - 3), true);
+  ASSERT_EQ(buffer.put(9), true);
+  UnpackBuffer corrupted(buffer.getData(), buffer.getDataSize());
+  ASSERT_THROW(corrupted.get<std::vector<bool>>(), std::out_of_range);
+}
+
+TEST_F(BitPackedTest, EnumVectorTest) {
+  BitPackedVector<Direction, Direction::West> directions;
+  BitPackedVector<Level, kLevelFatal> levels;
+  for (int i = 0; i < 1001; ++i) {
+    directions.push_back(static_cast<Direction>(i % 4));
+    levels.push_back(static_cast<Level>(i * 7 % 5));
+  }
+  ASSERT_EQ(buffer.put(directions), true);
+  const size_t kDirectionsSize = buffer.getDataSize();
+  // Two bits per direction instead of one byte
+  ASSERT_LE(kDirectionsSize, sizeof(size_t) + 1001 / 4 + 4);
+  ASSERT_EQ(buffer.put(levels), true);
+  ASSERT_EQ(buffer.put(3), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ((unpack.get<BitPackedVector<Direction, Direction::West>>()), directions);
+  ASSERT_EQ((unpack.get<BitPackedVector<Level, kLevelFatal>>()), levels);
+  ASSERT_EQ(unpack.get<int>(), 3);
+}
+
+TEST_F(BitPackedTest, ViewAndInvalidValueTest) {
+  const std::vector<uint16_t> kCodes{0, 1000, 999, 1023, 5};
+  ASSERT_EQ((buffer.put(buffers::bitPacked<uint16_t, 1023>(kCodes))), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ((unpack.get<BitPackedVector<uint16_t, 1023>>()), kCodes);
+
+  buffer.reset();
+  ASSERT_EQ((buffer.put(buffers::bitPacked<uint16_t, 999>(kCodes))), false);
+  ASSERT_EQ(buffer.getDataSize(), 0);
+  const std::vector<int> kNegative{1, -1};
+  ASSERT_EQ((buffer.put(buffers::bitPacked<int, 3>(kNegative))), false);
+  ASSERT_EQ(buffer.getDataSize(), 0);
+}
@@ -0,0 +1,142 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/BlockCompression.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::BlockCompressor;
+using buffers::BlockDecompressor;
+using buffers::DecompressedUnpackBuffer;
+using buffers::CompressedFormat;
+
+struct BlockCompressionTest : testing::Test
+{
+  HeapPackBuffer buffer{1 << 20};
+
+  /**
+   * Method for packing of messages with repeated strings and alignment padding
+   */
+  void packMessages(const int _count) {
+    for (int i = 0; i < _count; ++i) {
+      ASSERT_EQ(buffer.put(i), true);
+      ASSERT_EQ(buffer.put(std::string("instrument.symbol=AAPL;exchange=XNAS")), true);
+      ASSERT_EQ(buffer.put(static_cast<uint8_t>(i % 7)), true);
+      ASSERT_EQ(buffer.put(1.5 * i), true);
+    }
+  }
+
+  /**
+   * Method for checking of messages packed with packMessages
+   */
+  void checkMessages(buffers::UnpackBuffer & _unpack, const int _count) {
+    for (int i = 0; i < _count; ++i) {
+      ASSERT_EQ(_unpack.get<int>(), i);
+      ASSERT_EQ(std::string(_unpack.get<const char *>()), "instrument.symbol=AAPL;exchange=XNAS");
+      ASSERT_EQ(_unpack.get<uint8_t>(), i % 7);
+      ASSERT_EQ(_unpack.get<double>(), 1.5 * i);
+    }
+  }
+};
+
+TEST_F(BlockCompressionTest, RoundTripTest) {
+  packMessages(2000);
+  BlockCompressor compressor;
+  std::vector<uint8_t> compressed;
+  compressor.compress(buffer, compressed);
+  ASSERT_LT(compressed.size() * 4, buffer.getDataSize());
+  DecompressedUnpackBuffer unpack(compressed);
+  ASSERT_EQ(unpack.isOpen(), true);
+  ASSERT_EQ(unpack.getDataSize(), buffer.getDataSize());
+  ASSERT_EQ(std::memcmp(unpack.getData(), buffer.getData(), buffer.getDataSize()), 0);
+  checkMessages(unpack, 2000);
+}
+
+TEST_F(BlockCompressionTest, StreamingBlocksTest) {
+  packMessages(500);
+  BlockCompressor compressor(1024);
+  std::vector<uint8_t> compressed;
+  compressor.compress(buffer.getData(), buffer.getDataSize(), compressed);
+  BlockDecompressor decompressor(compressed.data(), compressed.size());
+  ASSERT_EQ(decompressor.getBlockSize(), 1024);
+  ASSERT_EQ(decompressor.getDecompressedSize(), buffer.getDataSize());
+  // Only one block is kept in memory while reading
+  std::vector<uint8_t> block(decompressor.getBlockSize());
+  size_t offset = 0;
+  size_t size = 0;
+  size_t blocksCount = 0;
+  while (decompressor.next(block.data(), size)) {
+    ASSERT_EQ(std::memcmp(block.data(), buffer.getData() + offset, size), 0);
+    offset += size;
+    ++blocksCount;
+  }
+  ASSERT_EQ(decompressor.isFinished(), true);
+  ASSERT_EQ(offset, buffer.getDataSize());
+  ASSERT_EQ(blocksCount, (buffer.getDataSize() + 1023) / 1024);
+}
+
+TEST_F(BlockCompressionTest, IncompressibleAndEmptyTest) {
+  std::mt19937 random(17);
+  std::vector<uint8_t> noise(100000);
+  for (auto & byte : noise) {
+    byte = static_cast<uint8_t>(random());
+  }
+  BlockCompressor compressor;
+  std::vector<uint8_t> compressed;
+  compressor.compress(noise.data(), noise.size(), compressed);
+  // Blocks are stored as is, so only framing is added
+  ASSERT_EQ(compressed.size(), CompressedFormat::getMaxCompressedSize(noise.size(), compressor.getBlockSize()));
+  DecompressedUnpackBuffer unpack(compressed);
+  ASSERT_EQ(std::memcmp(unpack.getData(), noise.data(), noise.size()), 0);
+
+  compressor.compress(nullptr, 0, compressed);
+  const size_t kHeaderSize = CompressedFormat::kHeaderSize;
+  ASSERT_EQ(compressed.size(), kHeaderSize);
+  DecompressedUnpackBuffer empty(compressed);
+  ASSERT_EQ(empty.isOpen(), true);
+  ASSERT_EQ(empty.getDataSize(), 0);
+
+  // Long runs are encoded with extended lengths of literals and matches
+  std::vector<uint8_t> runs(300, 'a');
+  runs.insert(runs.end(), noise.begin(), noise.begin() + 300);
+  runs.insert(runs.end(), 5000, 'b');
+  compressor.compress(runs.data(), runs.size(), compressed);
+  ASSERT_LT(compressed.size(), 400);
+  DecompressedUnpackBuffer unpackRuns(compressed);
+  ASSERT_EQ(std::memcmp(unpackRuns.getData(), runs.data(), runs.size()), 0);
+}
+
+TEST_F(BlockCompressionTest, CorruptionTest) {
+  packMessages(100);
+  BlockCompressor compressor(512);
+  std::vector<uint8_t> compressed;
+  compressor.compress(buffer, compressed);
+
+  std::vector<uint8_t> truncated(compressed.begin(), compressed.end() - 1);
+  ASSERT_THROW(DecompressedUnpackBuffer{truncated}, std::out_of_range);
+
+  std::vector<uint8_t> badMagic = compressed;
+  badMagic[0] ^= 0xFF;
+  ASSERT_THROW(DecompressedUnpackBuffer{badMagic}, std::out_of_range);
+
+  // Decompressed size which could not be produced by data is rejected before allocation
+  std::vector<uint8_t> badSize = compressed;
+  badSize[CompressedFormat::kHeaderSize - 1] = 0x7F;
+  ASSERT_THROW(DecompressedUnpackBuffer{badSize}, std::out_of_range);
+
+  // Every corrupted byte of payload is either detected or decompressed within bounds
+  for (size_t i = CompressedFormat::kHeaderSize; i < compressed.size(); ++i) {
+    std::vector<uint8_t> corrupted = compressed;
+    corrupted[i] ^= 0x5A;
+    BlockDecompressor decompressor(corrupted.data(), corrupted.size());
+    std::vector<uint8_t> block(decompressor.getBlockSize());
+    size_t size = 0;
+    while (decompressor.next(block.data(), size)) {
+      ASSERT_LE(size, block.size());
+    }
+  }
+}
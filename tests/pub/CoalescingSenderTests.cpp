@@ -0,0 +1,163 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <fcntl.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/CoalescingSender.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::FrameReader;
+using buffers::CoalescingSender;
+
+struct CoalescingSenderTest : testing::Test
+{
+  int fds[2];
+
+  void open(const int _type) {
+    ASSERT_EQ(::socketpair(AF_UNIX, _type, 0, fds), 0);
+  }
+
+  virtual void TearDown() {
+    ::close(fds[0]);
+    ::close(fds[1]);
+  };
+
+  static std::unique_ptr<PackBuffer> makeMessage(const int _value) {
+    std::unique_ptr<PackBuffer> buffer(new HeapPackBuffer(64));
+    buffer->put(_value);
+    buffer->put(std::string("message ") + std::to_string(_value));
+    return buffer;
+  }
+};
+
+TEST_F(CoalescingSenderTest, StreamCountThresholdTest)
+{
+  open(SOCK_STREAM);
+  CoalescingSender::Options options;
+  options.max_messages = 10;
+  options.max_delay = std::chrono::seconds{10};
+  CoalescingSender sender(fds[0], options);
+  for (int i = 0; i < 95; ++i) {
+    ASSERT_EQ(sender.send(makeMessage(i)), true);
+  }
+  ASSERT_EQ(sender.getPendingCount(), 5);
+  ASSERT_EQ(sender.flush(), true);
+  ASSERT_EQ(sender.getPendingCount(), 0);
+  ASSERT_EQ(sender.getStatistics().flushes_by_count, 9);
+  ASSERT_EQ(sender.getStatistics().flushes_by_request, 1);
+  ASSERT_EQ(sender.getStatistics().messages, 95);
+  ASSERT_EQ(sender.getStatistics().syscalls, 10);
+
+  std::vector<uint8_t> received;
+  uint8_t chunk[4096];
+  while (received.size() < sender.getStatistics().bytes) {
+    const ssize_t kRead = ::read(fds[1], chunk, sizeof(chunk));
+    ASSERT_GT(kRead, 0);
+    received.insert(received.end(), chunk, chunk + kRead);
+  }
+  FrameReader reader(received.data(), received.size());
+  int i = 0;
+  for (auto frame : reader) {
+    ASSERT_EQ(frame.get<int>(), i);
+    ASSERT_EQ(frame.get(), std::string("message ") + std::to_string(i));
+    ++i;
+  }
+  ASSERT_EQ(i, 95);
+}
+
+TEST_F(CoalescingSenderTest, StreamBytesThresholdTest)
+{
+  open(SOCK_STREAM);
+  CoalescingSender::Options options;
+  options.max_bytes = 100;
+  options.max_delay = std::chrono::seconds{10};
+  CoalescingSender sender(fds[0], options);
+  ASSERT_EQ(sender.send(makeMessage(1)), true);
+  ASSERT_EQ(sender.send(makeMessage(2)), true);
+  ASSERT_EQ(sender.getStatistics().flushes, 0);
+  ASSERT_EQ(sender.send(makeMessage(3)), true);
+  ASSERT_EQ(sender.send(makeMessage(4)), true);
+  ASSERT_EQ(sender.getPendingBytes(), 80);
+  ASSERT_EQ(sender.send(makeMessage(5)), true);
+  ASSERT_EQ(sender.getStatistics().flushes_by_bytes, 1);
+  ASSERT_EQ(sender.getStatistics().bytes, 100);
+  ASSERT_EQ(sender.getPendingCount(), 0);
+}
+
+TEST_F(CoalescingSenderTest, DeadlineTest)
+{
+  open(SOCK_STREAM);
+  CoalescingSender::Options options;
+  options.max_delay = std::chrono::milliseconds{1};
+  CoalescingSender sender(fds[0], options);
+  ASSERT_EQ(sender.send(makeMessage(1)), true);
+  ASSERT_EQ(sender.poll(), true);
+  ASSERT_EQ(sender.getPendingCount(), 1);
+  std::this_thread::sleep_until(sender.getDeadline());
+  ASSERT_EQ(sender.poll(), true);
+  ASSERT_EQ(sender.getPendingCount(), 0);
+  ASSERT_EQ(sender.getStatistics().flushes_by_deadline, 1);
+  ASSERT_EQ(sender.getDeadline(), CoalescingSender::Clock::time_point::max());
+}
+
+TEST_F(CoalescingSenderTest, DatagramTest)
+{
+  open(SOCK_DGRAM);
+  CoalescingSender::Options options;
+  options.max_messages = 16;
+  CoalescingSender sender(fds[0], options);
+  for (int i = 0; i < 16; ++i) {
+    ASSERT_EQ(sender.send(makeMessage(i)), true);
+  }
+  ASSERT_EQ(sender.getStatistics().syscalls, 1);
+  for (int i = 0; i < 16; ++i) {
+    uint8_t datagram[64];
+    const ssize_t kRead = ::recv(fds[1], datagram, sizeof(datagram), 0);
+    ASSERT_GT(kRead, 0);
+    UnpackBuffer unbuffer(datagram, static_cast<size_t>(kRead));
+    ASSERT_EQ(unbuffer.get<int>(), i);
+    ASSERT_EQ(unbuffer.get(), std::string("message ") + std::to_string(i));
+  }
+}
+
+TEST_F(CoalescingSenderTest, NonBlockingPartialTest)
+{
+  open(SOCK_STREAM);
+  int sendBuffer = 4096;
+  ::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &sendBuffer, sizeof(sendBuffer));
+  ::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+  CoalescingSender::Options options;
+  options.max_messages = 100000;
+  options.max_bytes = 1 << 30;
+  options.max_delay = std::chrono::seconds{10};
+  CoalescingSender sender(fds[0], options);
+  const int kCount = 20000;
+  for (int i = 0; i < kCount; ++i) {
+    ASSERT_EQ(sender.send(makeMessage(i)), true);
+  }
+  const size_t kTotal = sender.getPendingBytes();
+  std::vector<uint8_t> received;
+  uint8_t chunk[65536];
+  while (received.size() < kTotal) {
+    if (!sender.flush()) {
+      ASSERT_EQ(errno == EAGAIN || errno == EWOULDBLOCK, true);
+    }
+    const ssize_t kRead = ::recv(fds[1], chunk, sizeof(chunk), MSG_DONTWAIT);
+    if (kRead > 0) {
+      received.insert(received.end(), chunk, chunk + kRead);
+    }
+  }
+  ASSERT_EQ(sender.getPendingCount(), 0);
+  FrameReader reader(received.data(), received.size());
+  int i = 0;
+  for (auto frame : reader) {
+    ASSERT_EQ(frame.get<int>(), i);
+    ++i;
+  }
+  ASSERT_EQ(i, kCount);
+}
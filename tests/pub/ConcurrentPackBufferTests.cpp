@@ -0,0 +1,119 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "pub/ConcurrentPackBuffer.hpp"
+
+using buffers::ConcurrentPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+
+struct ConcurrentPackBufferTest : testing::Test
+{
+  ConcurrentPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new ConcurrentPackBuffer(1 << 20);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(ConcurrentPackBufferTest, AppendReadTest)
+{
+  ASSERT_EQ(buffer->begin() == buffer->end(), true);
+  ASSERT_EQ(buffer->append(1), true);
+  ASSERT_EQ(buffer->append(std::string{"Hello"}), true);
+  {
+    ConcurrentPackBuffer::Writer writer(*buffer);
+    ASSERT_EQ(writer.begin(16), true);
+    ASSERT_EQ(writer.put(2), true);
+    writer.abort();
+  }
+  ASSERT_EQ(buffer->append(std::vector<int>{3, 4}), true);
+  ASSERT_EQ(buffer->isComplete(), true);
+
+  auto it = buffer->begin();
+  ASSERT_EQ((*it).get<int>(), 1);
+  ++it;
+  ASSERT_EQ((*it).get<std::string>(), std::string{"Hello"});
+  ++it;
+  ASSERT_EQ((*it).get<std::vector<int>>(), (std::vector<int>{3, 4}));
+  ++it;
+  ASSERT_EQ(it == buffer->end(), true);
+
+  buffer->clear();
+  ASSERT_EQ(buffer->begin() == buffer->end(), true);
+  ASSERT_EQ(buffer->getCommittedSize(), 0);
+}
+
+TEST_F(ConcurrentPackBufferTest, IncompleteRecordTest)
+{
+  ConcurrentPackBuffer::Writer first(*buffer);
+  ConcurrentPackBuffer::Writer second(*buffer);
+  ASSERT_EQ(first.begin(4), true);
+  ASSERT_EQ(second.begin(4), true);
+  ASSERT_EQ(second.put(2), true);
+  ASSERT_EQ(second.commit(), true);
+  // Committed record after not committed one is not visible yet
+  ASSERT_EQ(buffer->begin() == buffer->end(), true);
+  ASSERT_EQ(buffer->isComplete(), false);
+  ASSERT_EQ(first.put(1), true);
+  ASSERT_EQ(first.commit(), true);
+  ASSERT_EQ(buffer->isComplete(), true);
+  int sum = 0;
+  for (UnpackBuffer record : *buffer) {
+    sum += record.get<int>();
+  }
+  ASSERT_EQ(sum, 3);
+}
+
+TEST_F(ConcurrentPackBufferTest, OverflowTest)
+{
+  ConcurrentPackBuffer small(64);
+  int appended = 0;
+  while (small.append(uint64_t(appended))) {
+    ++appended;
+  }
+  // Every record is 8 bytes of header and 8 bytes of value with 8 bytes reserved for alignment
+  ASSERT_EQ(appended, 2);
+  ASSERT_EQ(small.isComplete(), true);
+  ASSERT_EQ(small.getCommittedSize(), 64);
+  int read = 0;
+  for (UnpackBuffer record : small) {
+    ASSERT_EQ(record.get<uint64_t>(), read);
+    ++read;
+  }
+  ASSERT_EQ(read, appended);
+}
+
+TEST_F(ConcurrentPackBufferTest, MultipleWritersTest)
+{
+  const int kThreads = 8;
+  const int kCount = 5000;
+  std::vector<std::thread> writers;
+  for (int t = 0; t < kThreads; ++t) {
+    writers.emplace_back([this, t, kCount] {
+      for (int i = 0; i < kCount; ++i) {
+        ASSERT_EQ(buffer->append(std::make_pair(t, i)), true);
+      }
+    });
+  }
+  for (auto & writer : writers) {
+    writer.join();
+  }
+  ASSERT_EQ(buffer->isComplete(), true);
+  std::vector<int> expected(kThreads, 0);
+  for (UnpackBuffer record : *buffer) {
+    auto value = record.get<std::pair<int, int>>();
+    ASSERT_EQ(value.second, expected[value.first]);
+    ++expected[value.first];
+  }
+  for (int t = 0; t < kThreads; ++t) {
+    ASSERT_EQ(expected[t], kCount);
+  }
+}
@@ -0,0 +1,110 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <limits>
+#include <string>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/DeltaKeys.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::DeltaSet;
+using buffers::DeltaMap;
+using buffers::Varint;
+
+struct DeltaKeysTest : testing::Test
+{
+  HeapPackBuffer buffer{1 << 20};
+};
+
+TEST(VarintTest, RoundTripTest) {
+  const uint64_t kValues[] = {0, 1, 127, 128, 300, 1ULL << 35, std::numeric_limits<uint64_t>::max()};
+  for (const uint64_t kValue : kValues) {
+    uint8_t encoded[Varint::kMaxSize];
+    uint8_t * pEnd = Varint::encode(kValue, encoded);
+    ASSERT_EQ(static_cast<size_t>(pEnd - encoded), Varint::getSize(kValue));
+    uint64_t decoded = 0;
+    ASSERT_EQ(Varint::decode(encoded, pEnd, decoded), pEnd);
+    ASSERT_EQ(decoded, kValue);
+    if (pEnd - encoded > 1) {
+      ASSERT_EQ(Varint::decode(encoded, pEnd - 1, decoded) == nullptr, true);
+    }
+  }
+  ASSERT_EQ(Varint::unzigzag(Varint::zigzag(-1)), -1);
+  ASSERT_EQ(Varint::zigzag(-1), 1);
+  ASSERT_EQ(Varint::unzigzag(Varint::zigzag(std::numeric_limits<int64_t>::min())),
+            std::numeric_limits<int64_t>::min());
+}
+
+TEST_F(DeltaKeysTest, DenseSetTest) {
+  DeltaSet<uint64_t> ids;
+  for (uint64_t i = 0; i < 10000; ++i) {
+    ids.insert(1000000000000ULL + i * 3);
+  }
+  ASSERT_EQ(buffer.put(ids), true);
+  const size_t kDeltaSize = buffer.getDataSize();
+  ASSERT_LT(kDeltaSize * 6, HeapPackBuffer::getTypeSize(static_cast<const std::set<uint64_t> &>(ids)));
+
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  DeltaSet<uint64_t> decoded = unpack.get<DeltaSet<uint64_t>>();
+  ASSERT_EQ(decoded == ids, true);
+  ASSERT_EQ(unpack.getBufferSize(), 0);
+}
+
+TEST_F(DeltaKeysTest, SignedKeysTest) {
+  DeltaSet<int64_t> keys{std::numeric_limits<int64_t>::min(), -5, -1, 0, 7, std::numeric_limits<int64_t>::max()};
+  DeltaSet<int8_t> small{-128, -3, 0, 127};
+  ASSERT_EQ(buffer.put(keys), true);
+  ASSERT_EQ(buffer.put(small), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<DeltaSet<int64_t>>() == keys, true);
+  ASSERT_EQ(unpack.get<DeltaSet<int8_t>>() == small, true);
+}
+
+TEST_F(DeltaKeysTest, MapTest) {
+  DeltaMap<uint32_t, std::string> names;
+  for (uint32_t i = 0; i < 100; ++i) {
+    names[i * 2] = "name" + std::to_string(i);
+  }
+  ASSERT_EQ(buffer.put(names), true);
+  ASSERT_EQ(buffer.put(42), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  DeltaMap<uint32_t, std::string> decoded = unpack.get<DeltaMap<uint32_t, std::string>>();
+  ASSERT_EQ(decoded == names, true);
+  ASSERT_EQ(unpack.get<int>(), 42);
+}
+
+TEST_F(DeltaKeysTest, ViewTest) {
+  std::set<uint16_t> ids{1, 2, 3, 500, 60000};
+  ASSERT_EQ(buffer.put(buffers::deltaKeys(ids)), true);
+  HeapPackBuffer expected(1024);
+  ASSERT_EQ(expected.put(DeltaSet<uint16_t>(ids)), true);
+  ASSERT_EQ(buffer.getDataSize(), expected.getDataSize());
+  ASSERT_EQ(std::memcmp(buffer.getData(), expected.getData(), expected.getDataSize()), 0);
+
+  std::map<int, double> values{{-10, 1.5}, {20, 2.5}};
+  ASSERT_EQ(buffer.put(buffers::deltaKeys(values)), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<DeltaSet<uint16_t>>() == DeltaSet<uint16_t>(ids), true);
+  std::map<int, double> decoded = unpack.get<DeltaMap<int, double>>();
+  ASSERT_EQ(decoded, values);
+}
+
+TEST_F(DeltaKeysTest, EmptyAndOverflowTest) {
+  DeltaSet<int> empty;
+  ASSERT_EQ(buffer.put(empty), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<DeltaSet<int>>().empty(), true);
+
+  uint8_t storage[32];
+  buffers::PackBuffer small(storage, sizeof(storage));
+  DeltaSet<uint64_t> large;
+  for (uint64_t i = 0; i < 100; ++i) {
+    large.insert(i << 40);
+  }
+  ASSERT_EQ(small.put(large), false);
+  ASSERT_EQ(small.getDataSize(), 0);
+}
@@ -0,0 +1,237 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/DeltaSnapshot.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::DeltaEncoder;
+using buffers::DeltaDecoder;
+
+namespace {
+struct Order {
+  uint64_t id;
+  double price;
+  std::string owner;
+
+  bool operator==(const Order & _other) const {
+    return id == _other.id && price == _other.price && owner == _other.owner;
+  }
+};
+
+struct Venue {
+  std::string name;
+  int32_t status;
+
+  bool operator==(const Venue & _other) const {
+    return name == _other.name && status == _other.status;
+  }
+};
+
+struct Snapshot {
+  uint64_t sequence;
+  std::array<double, 200> metrics;
+  Venue venue;
+  std::vector<Order> orders;
+  std::map<int32_t, std::string> tags;
+
+  bool operator==(const Snapshot & _other) const {
+    return sequence == _other.sequence && metrics == _other.metrics && venue == _other.venue &&
+           orders == _other.orders && tags == _other.tags;
+  }
+};
+}
+
+namespace buffers {
+template <>
+struct StructFields<Order> {
+  template <typename TVisitor>
+  static void visit(TVisitor & _visitor) {
+    _visitor(&Order::id);
+    _visitor(&Order::price);
+    _visitor(&Order::owner);
+  }
+};
+
+template <>
+struct StructFields<Venue> {
+  template <typename TVisitor>
+  static void visit(TVisitor & _visitor) {
+    _visitor(&Venue::name);
+    _visitor(&Venue::status);
+  }
+};
+
+template <>
+struct StructFields<Snapshot> {
+  template <typename TVisitor>
+  static void visit(TVisitor & _visitor) {
+    _visitor(&Snapshot::sequence);
+    _visitor(&Snapshot::metrics);
+    _visitor(&Snapshot::venue);
+    _visitor(&Snapshot::orders);
+    _visitor(&Snapshot::tags);
+  }
+};
+}
+
+struct DeltaSnapshotTest : testing::Test
+{
+  HeapPackBuffer buffer{1 << 16};
+
+  /**
+   * Method for packing of snapshot and unpacking it with decoder
+   * @return Size of packed difference
+   */
+  size_t send(DeltaEncoder<Snapshot> & _encoder, DeltaDecoder<Snapshot> & _decoder, const Snapshot & _snapshot) {
+    buffer.reset();
+    EXPECT_EQ(buffer.put(_encoder.delta(_snapshot)), true);
+    EXPECT_EQ(buffer.put(-1), true);
+    UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+    Snapshot const * pSnapshot = _decoder.get(unpack);
+    EXPECT_NE(pSnapshot, nullptr);
+    EXPECT_EQ(*pSnapshot == _snapshot, true);
+    EXPECT_EQ(unpack.get<int>(), -1);
+    return buffer.getDataSize();
+  }
+};
+
+TEST_F(DeltaSnapshotTest, FewChangedFieldsTest) {
+  DeltaEncoder<Snapshot> encoder;
+  DeltaDecoder<Snapshot> decoder;
+  Snapshot snapshot{};
+  for (size_t i = 0; i < snapshot.metrics.size(); ++i) {
+    snapshot.metrics[i] = 0.5 * i;
+  }
+  snapshot.venue = Venue{"XNAS", 1};
+  snapshot.orders = {Order{1, 10.5, "alice"}, Order{2, 11.0, "bob"}};
+  snapshot.tags = {{1, "open"}, {2, "liquid"}};
+  const size_t kKeyFrameSize = send(encoder, decoder, snapshot);
+  ASSERT_GT(kKeyFrameSize, 200 * sizeof(double));
+
+  // Sequence, one metric and price of one order are changed
+  snapshot.sequence = 2;
+  snapshot.metrics[117] = -1.0;
+  snapshot.orders[1].price = 11.25;
+  const size_t kDeltaSize = send(encoder, decoder, snapshot);
+  ASSERT_LT(kDeltaSize, 100);
+
+  // Nothing is changed
+  ASSERT_LE(send(encoder, decoder, snapshot), 3 * sizeof(uint32_t));
+
+  // Containers grow, shrink and nested struct is changed
+  snapshot.orders.push_back(Order{3, 12.0, "carol"});
+  snapshot.orders.erase(snapshot.orders.begin());
+  snapshot.tags.erase(1);
+  snapshot.tags[5] = "halted";
+  snapshot.venue.status = 2;
+  send(encoder, decoder, snapshot);
+  snapshot.orders.clear();
+  snapshot.tags.clear();
+  send(encoder, decoder, snapshot);
+}
+
+TEST_F(DeltaSnapshotTest, RandomChangesTest) {
+  DeltaEncoder<Snapshot> encoder;
+  DeltaDecoder<Snapshot> decoder;
+  std::mt19937 random(23);
+  Snapshot snapshot{};
+  for (int message = 0; message < 300; ++message) {
+    snapshot.sequence = message;
+    for (int change = random() % 4; change > 0; --change) {
+      switch (random() % 6) {
+        case 0:
+          snapshot.metrics[random() % 200] = static_cast<double>(random() % 1000);
+          break;
+        case 1:
+          snapshot.orders.push_back(Order{random() % 100, 1.0, std::string(random() % 5, 'o')});
+          break;
+        case 2:
+          if (!snapshot.orders.empty()) {
+            snapshot.orders.erase(snapshot.orders.begin() + random() % snapshot.orders.size());
+          }
+          break;
+        case 3:
+          if (!snapshot.orders.empty()) {
+            snapshot.orders[random() % snapshot.orders.size()].owner += 'x';
+          }
+          break;
+        case 4:
+          snapshot.tags[random() % 10] = std::to_string(random() % 3);
+          break;
+        default:
+          snapshot.tags.erase(random() % 10);
+          break;
+      }
+    }
+    send(encoder, decoder, snapshot);
+    ASSERT_EQ(encoder.getPrevious() == snapshot, true);
+  }
+}
+
+TEST_F(DeltaSnapshotTest, KeyFrameAndFailedPutTest) {
+  DeltaEncoder<Snapshot> encoder;
+  DeltaDecoder<Snapshot> decoder;
+  Snapshot snapshot{};
+  snapshot.venue.name = "XLON";
+  send(encoder, decoder, snapshot);
+
+  // Failed put does not change the previous message
+  snapshot.orders.assign(100, Order{7, 1.0, "dave"});
+  uint8_t storage[64];
+  buffers::PackBuffer small(storage, sizeof(storage));
+  ASSERT_EQ(small.put(encoder.delta(snapshot)), false);
+  ASSERT_EQ(encoder.getPrevious().orders.empty(), true);
+  send(encoder, decoder, snapshot);
+
+  // Decoder which missed key frame could not apply difference
+  snapshot.sequence = 10;
+  buffer.reset();
+  ASSERT_EQ(buffer.put(encoder.delta(snapshot)), true);
+  DeltaDecoder<Snapshot> lateDecoder;
+  UnpackBuffer delta(buffer.getData(), buffer.getDataSize());
+  ASSERT_THROW(lateDecoder.get(delta), std::out_of_range);
+  ASSERT_EQ(lateDecoder.isSynchronized(), false);
+
+  // Key frame after reset synchronizes every decoder again
+  encoder.reset();
+  snapshot.sequence = 11;
+  send(encoder, lateDecoder, snapshot);
+  ASSERT_EQ(lateDecoder.isSynchronized(), true);
+  UnpackBuffer keyFrame(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(*decoder.get(keyFrame) == snapshot, true);
+}
+
+TEST_F(DeltaSnapshotTest, MissedMessageTest) {
+  DeltaEncoder<Snapshot> encoder;
+  DeltaDecoder<Snapshot> decoder;
+  Snapshot snapshot{};
+  snapshot.venue.name = "XPAR";
+  send(encoder, decoder, snapshot);
+
+  // The second message is lost, the third one is difference against it
+  snapshot.sequence = 2;
+  buffer.reset();
+  ASSERT_EQ(buffer.put(encoder.delta(snapshot)), true);
+  snapshot.sequence = 3;
+  buffer.reset();
+  ASSERT_EQ(buffer.put(encoder.delta(snapshot)), true);
+  UnpackBuffer delta(buffer.getData(), buffer.getDataSize());
+  ASSERT_THROW(decoder.get(delta), std::out_of_range);
+  ASSERT_EQ(decoder.isSynchronized(), false);
+
+  // Decoder stays out of sync for the following differences till key frame
+  snapshot.sequence = 4;
+  buffer.reset();
+  ASSERT_EQ(buffer.put(encoder.delta(snapshot)), true);
+  UnpackBuffer next(buffer.getData(), buffer.getDataSize());
+  ASSERT_THROW(decoder.get(next), std::out_of_range);
+  encoder.reset();
+  send(encoder, decoder, snapshot);
+  ASSERT_EQ(decoder.isSynchronized(), true);
+}
@@ -0,0 +1,122 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/Float16.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::Float16;
+using buffers::FloatFormat;
+using buffers::HalfVector;
+using buffers::BFloat16Vector;
+
+struct Float16Test : testing::Test
+{
+  HeapPackBuffer buffer{1 << 20};
+
+  /**
+   * Method for checking that every kernel gives the same bits as scalar one
+   */
+  static void checkKernels(const FloatFormat _format) {
+    const Float16::Kernel kKernels[] = {Float16::Kernel::Avx2, Float16::Kernel::Avx512};
+    std::mt19937 random(5);
+    std::vector<float> values(1 << 16);
+    for (auto & value : values) {
+      const uint32_t kBits = random();
+      std::memcpy(&value, &kBits, sizeof(kBits));
+    }
+    const float kSpecials[] = {0.0f, -0.0f, 65504.0f, 65519.0f, 65520.0f, 1e-8f, -6.1e-5f, 2.98e-8f,
+                               std::numeric_limits<float>::infinity(), std::numeric_limits<float>::quiet_NaN(),
+                               std::numeric_limits<float>::signaling_NaN(), std::numeric_limits<float>::max()};
+    std::copy(std::begin(kSpecials), std::end(kSpecials), values.begin());
+    std::vector<uint8_t> expected(2 * values.size() + 1);
+    std::vector<uint16_t> allValues(1 << 16);
+    for (size_t i = 0; i < allValues.size(); ++i) {
+      allValues[i] = static_cast<uint16_t>(i);
+    }
+    std::vector<float> expectedDecoded(allValues.size());
+    Float16::encode(_format, values.data(), values.size(), expected.data() + 1, Float16::Kernel::Scalar);
+    Float16::decode(_format, reinterpret_cast<const uint8_t *>(allValues.data()), allValues.size(),
+                    expectedDecoded.data(), Float16::Kernel::Scalar);
+    for (const auto kKernel : kKernels) {
+      if (!Float16::isSupported(kKernel)) {
+        continue;
+      }
+      // Odd counts and unaligned destination check tails of kernels
+      for (const size_t kCount : {values.size(), size_t{37}}) {
+        std::vector<uint8_t> encoded(expected.size());
+        Float16::encode(_format, values.data(), kCount, encoded.data() + 1, kKernel);
+        ASSERT_EQ(std::memcmp(encoded.data() + 1, expected.data() + 1, 2 * kCount), 0);
+      }
+      std::vector<float> decoded(allValues.size());
+      Float16::decode(_format, reinterpret_cast<const uint8_t *>(allValues.data()), allValues.size(),
+                      decoded.data(), kKernel);
+      ASSERT_EQ(std::memcmp(decoded.data(), expectedDecoded.data(), decoded.size() * sizeof(float)), 0);
+    }
+  }
+};
+
+TEST_F(Float16Test, HalfKernelsAreIdenticalTest) {
+  checkKernels(FloatFormat::Half);
+}
+
+TEST_F(Float16Test, BFloat16KernelsAreIdenticalTest) {
+  checkKernels(FloatFormat::BFloat16);
+}
+
+TEST_F(Float16Test, RoundingTest) {
+  const HalfVector kHalves{1.0f, 0.1f, -2.5f, 65504.0f, 70000.0f, 1e-7f, 1.0f + 1.0f / 2048};
+  const BFloat16Vector kBFloats{1.0f, 3.0e38f, 1.0f + 1.0f / 256, 1.0f + 3.0f / 256, -1e-30f};
+  ASSERT_EQ(buffer.put(kHalves), true);
+  ASSERT_EQ(buffer.put(kBFloats), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  const HalfVector kUnpackedHalves = unpack.get<HalfVector>();
+  ASSERT_EQ(kUnpackedHalves.size(), kHalves.size());
+  ASSERT_EQ(kUnpackedHalves[0], 1.0f);
+  ASSERT_LT(std::fabs(kUnpackedHalves[1] - 0.1f), 1e-4f);
+  ASSERT_EQ(kUnpackedHalves[2], -2.5f);
+  ASSERT_EQ(kUnpackedHalves[3], 65504.0f);
+  ASSERT_EQ(std::isinf(kUnpackedHalves[4]), true);
+  ASSERT_LT(std::fabs(kUnpackedHalves[5] - 1e-7f), 6e-8f);
+  // Tie is rounded to even mantissa
+  ASSERT_EQ(kUnpackedHalves[6], 1.0f);
+  const BFloat16Vector kUnpackedBFloats = unpack.get<BFloat16Vector>();
+  ASSERT_EQ(kUnpackedBFloats.size(), kBFloats.size());
+  ASSERT_EQ(kUnpackedBFloats[0], 1.0f);
+  ASSERT_LT(std::fabs(kUnpackedBFloats[1] / 3.0e38f - 1.0f), 1.0f / 128);
+  ASSERT_EQ(kUnpackedBFloats[2], 1.0f);
+  ASSERT_EQ(kUnpackedBFloats[3], 1.0f + 4.0f / 256);
+  ASSERT_LT(kUnpackedBFloats[4], 0.0f);
+}
+
+TEST_F(Float16Test, SizeAndViewTest) {
+  std::vector<float> features(1000);
+  for (size_t i = 0; i < features.size(); ++i) {
+    features[i] = static_cast<float>(i) / 8;
+  }
+  ASSERT_EQ(buffer.put(buffers::half(features)), true);
+  ASSERT_EQ(buffer.put(buffers::bfloat16(features)), true);
+  ASSERT_EQ(buffer.put(5), true);
+  ASSERT_LE(buffer.getDataSize(), 2 * (sizeof(size_t) + 2 * features.size()) + sizeof(int) + 8);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<HalfVector>(), features);
+  // Values up to 999 / 8 need 10 bits of mantissa, bfloat16 keeps only 8 bits
+  const BFloat16Vector kBFloats = unpack.get<BFloat16Vector>();
+  ASSERT_EQ(kBFloats.size(), features.size());
+  for (size_t i = 0; i < features.size(); ++i) {
+    ASSERT_LE(std::fabs(kBFloats[i] - features[i]), features[i] / 256);
+  }
+  ASSERT_EQ(unpack.get<int>(), 5);
+
+  uint8_t storage[64];
+  buffers::PackBuffer small(storage, sizeof(storage));
+  ASSERT_EQ(small.put(buffers::half(features)), false);
+  ASSERT_EQ(small.getDataSize(), 0);
+}
@@ -0,0 +1,91 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/Frame.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::FrameWriter;
+using buffers::FrameReader;
+
+struct FrameTest : testing::Test
+{
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    buffer = new HeapPackBuffer(400);
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+  };
+};
+
+TEST_F(FrameTest, ValidFramesTest)
+{
+  FrameWriter writer(*buffer);
+  ASSERT_EQ(writer.put(uint8_t{ 1 }), true);
+  ASSERT_EQ(writer.put(std::string{"Hello"}), true);
+  ASSERT_EQ(writer.beginFrame(), true);
+  ASSERT_EQ(buffer->put(uint16_t{ 2 }), true);
+  ASSERT_EQ(buffer->put(std::vector<int>{1, 2, 3}), true);
+  ASSERT_EQ(writer.commitFrame(), true);
+  ASSERT_EQ(writer.getFramesCount(), 3);
+
+  FrameReader reader(*buffer);
+  auto it = reader.begin();
+  UnpackBuffer frame0 = *it++;
+  ASSERT_EQ(frame0.get<uint8_t>(), 1);
+  ASSERT_EQ(frame0.getBufferSize(), 0);
+  UnpackBuffer frame1 = *it++;
+  ASSERT_EQ(frame1.get(), std::string{"Hello"});
+  UnpackBuffer frame2 = *it++;
+  ASSERT_EQ(frame2.get<uint16_t>(), 2);
+  ASSERT_EQ(frame2.get<std::vector<int>>(), (std::vector<int>{1, 2, 3}));
+  ASSERT_EQ(it == reader.end(), true);
+  ASSERT_EQ(reader.getCompleteSize(), buffer->getDataSize());
+}
+
+TEST_F(FrameTest, AbortFrameTest)
+{
+  FrameWriter writer(*buffer);
+  ASSERT_EQ(writer.put(1), true);
+  ASSERT_EQ(writer.beginFrame(), true);
+  ASSERT_EQ(buffer->put(2), true);
+  writer.abortFrame();
+  ASSERT_EQ(writer.put(std::string(1000, 'x')), false);
+  ASSERT_EQ(writer.put(3), true);
+
+  FrameReader reader(*buffer);
+  std::vector<int> values;
+  for (auto frame : reader) {
+    values.push_back(frame.get<int>());
+  }
+  ASSERT_EQ(values, (std::vector<int>{1, 3}));
+}
+
+TEST_F(FrameTest, PartialFrameTest)
+{
+  FrameWriter writer(*buffer);
+  ASSERT_EQ(writer.put(std::string{"first"}), true);
+  const size_t kFirstSize = buffer->getDataSize();
+  ASSERT_EQ(writer.put(std::string{"second"}), true);
+
+  FrameReader reader(buffer->getData(), buffer->getDataSize() - 1);
+  ASSERT_EQ(reader.getCompleteSize(), kFirstSize);
+  size_t count = 0;
+  for (auto frame : reader) {
+    ASSERT_EQ(frame.get(), std::string{"first"});
+    ++count;
+  }
+  ASSERT_EQ(count, 1);
+}
+
+TEST_F(FrameTest, FrameFormatTest)
+{
+  ASSERT_EQ(buffers::FrameFormat::getHeaderSize(buffers::AlignMemory::Bits_8), 4);
+  ASSERT_EQ(buffers::FrameFormat::getHeaderSize(buffers::AlignMemory::Bits_64), 8);
+  ASSERT_EQ(buffers::FrameFormat::getFrameSize(5, buffers::AlignMemory::Bits_32), 12);
+}
@@ -0,0 +1,129 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "pub/FrozenMessage.hpp"
+#include "pub/CoalescingSender.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::FrozenMessage;
+using buffers::PackBufferPool;
+using buffers::PooledPackBuffer;
+using buffers::FrameReader;
+using buffers::CoalescingSender;
+
+TEST(FrozenMessageTest, FreezeHeapBufferTest)
+{
+  HeapPackBuffer buffer(64);
+  ASSERT_EQ(buffer.put(42), true);
+  ASSERT_EQ(buffer.put(std::string{"update"}), true);
+  const uint8_t * const kData = buffer.getData();
+  FrozenMessage message = FrozenMessage::freeze(buffer);
+  ASSERT_EQ(buffer.getDataSize(), 0);
+  ASSERT_EQ(buffer.getData(), nullptr);
+  ASSERT_EQ(message.getData(), kData);
+  ASSERT_EQ(message.getReferencesCount(), 1);
+  {
+    FrozenMessage copy = message;
+    ASSERT_EQ(message.getReferencesCount(), 2);
+    UnpackBuffer unbuffer = copy.getUnpackBuffer();
+    ASSERT_EQ(unbuffer.get<int>(), 42);
+    ASSERT_EQ(unbuffer.get<std::string>(), std::string{"update"});
+  }
+  ASSERT_EQ(message.getReferencesCount(), 1);
+  FrozenMessage moved = std::move(message);
+  ASSERT_EQ(static_cast<bool>(message), false);
+  ASSERT_EQ(moved.getReferencesCount(), 1);
+}
+
+TEST(FrozenMessageTest, ConcurrentReadersTest)
+{
+  HeapPackBuffer buffer(1024);
+  buffer.put(std::vector<int>(100, 7));
+  FrozenMessage message = FrozenMessage::copy(buffer);
+  std::vector<std::thread> readers;
+  std::vector<int> sums(8, 0);
+  for (int t = 0; t < 8; ++t) {
+    readers.emplace_back([message, &sums, t] {
+      for (int i = 0; i < 100; ++i) {
+        FrozenMessage local = message;
+        UnpackBuffer unbuffer = local.getUnpackBuffer();
+        for (int value : unbuffer.get<std::vector<int>>()) {
+          sums[t] += value;
+        }
+      }
+    });
+  }
+  for (auto & reader : readers) {
+    reader.join();
+  }
+  for (int sum : sums) {
+    ASSERT_EQ(sum, 100 * 100 * 7);
+  }
+  ASSERT_EQ(message.getReferencesCount(), 1);
+}
+
+TEST(FrozenMessageTest, PoolTest)
+{
+  PackBufferPool pool(256);
+  {
+    PooledPackBuffer buffer(pool);
+    ASSERT_EQ(buffer.put(1), true);
+  }
+  ASSERT_EQ(pool.getFreeCount(), 1);
+  FrozenMessage message;
+  {
+    PooledPackBuffer buffer(pool);
+    ASSERT_EQ(pool.getFreeCount(), 0);
+    ASSERT_EQ(buffer.put(std::string{"pooled"}), true);
+    message = buffer.freeze();
+    ASSERT_EQ(buffer.getDataSize(), 0);
+  }
+  ASSERT_EQ(pool.getFreeCount(), 0);
+  std::thread([message] {
+    FrozenMessage local = message;
+    ASSERT_EQ(local.getUnpackBuffer().get<std::string>(), std::string{"pooled"});
+  }).join();
+  message = FrozenMessage();
+  ASSERT_EQ(pool.getFreeCount(), 1);
+}
+
+TEST(FrozenMessageTest, FanOutTest)
+{
+  const int kSubscribers = 3;
+  int fds[kSubscribers][2];
+  std::vector<std::unique_ptr<CoalescingSender>> senders;
+  for (int i = 0; i < kSubscribers; ++i) {
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds[i]), 0);
+    senders.emplace_back(new CoalescingSender(fds[i][0]));
+  }
+  PackBufferPool pool(64);
+  FrozenMessage message;
+  {
+    PooledPackBuffer buffer(pool);
+    buffer.put(std::string{"market update"});
+    message = buffer.freeze();
+  }
+  for (auto & sender : senders) {
+    ASSERT_EQ(sender->send(message), true);
+  }
+  ASSERT_EQ(message.getReferencesCount(), kSubscribers + 1);
+  for (auto & sender : senders) {
+    ASSERT_EQ(sender->flush(), true);
+  }
+  ASSERT_EQ(message.getReferencesCount(), 1);
+  for (int i = 0; i < kSubscribers; ++i) {
+    uint8_t received[64];
+    const ssize_t kRead = ::read(fds[i][1], received, sizeof(received));
+    ASSERT_GT(kRead, 0);
+    FrameReader reader(received, static_cast<size_t>(kRead));
+    ASSERT_EQ((*reader.begin()).get<std::string>(), std::string{"market update"});
+    ::close(fds[i][0]);
+    ::close(fds[i][1]);
+  }
+}
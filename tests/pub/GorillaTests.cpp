@@ -0,0 +1,103 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/Gorilla.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::GorillaVector;
+using buffers::BitWriter;
+using buffers::BitReader;
+
+struct GorillaTest : testing::Test
+{
+  HeapPackBuffer buffer{1 << 20};
+
+  /**
+   * Method for comparing bit patterns, so NaN and negative zero are checked too
+   */
+  template <typename T>
+  static bool isBitwiseEqual(const std::vector<T> & _lhs, const std::vector<T> & _rhs) {
+    return _lhs.size() == _rhs.size() &&
+           (_lhs.empty() || std::memcmp(_lhs.data(), _rhs.data(), _lhs.size() * sizeof(T)) == 0);
+  }
+};
+
+TEST(BitStreamTest, RoundTripTest) {
+  uint8_t storage[64] = {};
+  BitWriter writer(storage, storage + sizeof(storage));
+  writer.write(1, 1);
+  writer.write(0x1234567890ABCDEFULL, 64);
+  writer.write(5, 3);
+  writer.write(0xFFFFFFFFFULL, 36);
+  uint8_t * pEnd = writer.finish();
+  ASSERT_EQ(pEnd, storage + 13);
+  BitReader reader(storage, pEnd);
+  ASSERT_EQ(reader.read(1), 1);
+  ASSERT_EQ(reader.read(64), 0x1234567890ABCDEFULL);
+  ASSERT_EQ(reader.read(3), 5);
+  ASSERT_EQ(reader.read(36), 0xFFFFFFFFFULL);
+  ASSERT_EQ(reader.isOverflow(), false);
+  reader.read(8);
+  ASSERT_EQ(reader.isOverflow(), true);
+}
+
+TEST_F(GorillaTest, TimeSeriesTest) {
+  GorillaVector<double> temperatures;
+  double value = 21.5;
+  for (int i = 0; i < 10000; ++i) {
+    if (i % 10 == 0) {
+      value += (i % 20 == 0) ? 0.25 : -0.125;
+    }
+    temperatures.push_back(value);
+  }
+  ASSERT_EQ(buffer.put(temperatures), true);
+  ASSERT_LT(buffer.getDataSize() * 5, temperatures.size() * sizeof(double));
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(isBitwiseEqual<double>(unpack.get<GorillaVector<double>>(), temperatures), true);
+}
+
+TEST_F(GorillaTest, ArbitraryValuesTest) {
+  std::mt19937_64 random(7);
+  std::uniform_real_distribution<double> distribution(-1e6, 1e6);
+  GorillaVector<double> doubles{0.0, -0.0, std::numeric_limits<double>::quiet_NaN(),
+                                std::numeric_limits<double>::infinity(), std::numeric_limits<double>::denorm_min()};
+  GorillaVector<float> floats{1.0f, -0.0f, std::numeric_limits<float>::max(), 1.0f, 1.5f};
+  for (int i = 0; i < 1000; ++i) {
+    doubles.push_back(distribution(random));
+    floats.push_back(static_cast<float>(distribution(random)));
+  }
+  ASSERT_EQ(buffer.put(doubles), true);
+  ASSERT_EQ(buffer.put(floats), true);
+  ASSERT_EQ(buffer.put(3), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(isBitwiseEqual<double>(unpack.get<GorillaVector<double>>(), doubles), true);
+  ASSERT_EQ(isBitwiseEqual<float>(unpack.get<GorillaVector<float>>(), floats), true);
+  ASSERT_EQ(unpack.get<int>(), 3);
+}
+
+TEST_F(GorillaTest, ViewAndOverflowTest) {
+  const std::vector<float> kSamples{0.5f, 0.5f, 0.75f, 0.5f};
+  ASSERT_EQ(buffer.put(buffers::gorilla(kSamples)), true);
+  const std::vector<double> kEmpty;
+  ASSERT_EQ(buffer.put(buffers::gorilla(kEmpty)), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(isBitwiseEqual<float>(unpack.get<GorillaVector<float>>(), kSamples), true);
+  ASSERT_EQ(unpack.get<GorillaVector<double>>().empty(), true);
+
+  std::vector<double> noise(64);
+  for (size_t i = 0; i < noise.size(); ++i) {
+    noise[i] = std::sqrt(static_cast<double>(i) + 0.1);
+  }
+  uint8_t storage[128];
+  buffers::PackBuffer small(storage, sizeof(storage));
+  ASSERT_EQ(small.put(buffers::gorilla(noise)), false);
+  ASSERT_EQ(small.getDataSize(), 0);
+}
@@ -0,0 +1,227 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "pub/IoRing.hpp"
+
+using buffers::IoRing;
+using buffers::UnpackBuffer;
+
+class IoRingTest : public ::testing::Test {
+ protected:
+  explicit IoRingTest(const bool _useUring)
+      : use_uring_{_useUring} {
+  }
+
+  void SetUp() override {
+    char path[] = "/tmp/pub_io_ring_XXXXXX";
+    fd_ = ::mkstemp(path);
+    ::unlink(path);
+    IoRing::Options options;
+    options.buffers_count = 8;
+    options.buffer_size = 4096;
+    options.use_uring = use_uring_;
+    ring_ = new IoRing(options);
+  }
+
+  void TearDown() override {
+    delete ring_;
+    ::close(fd_);
+  }
+
+  void checkWriteAndReadFile();
+  void checkSocketStream();
+  void checkPoolExhaustion();
+  void checkShortReads();
+
+  const bool use_uring_;
+  int fd_;
+  IoRing * ring_;
+};
+
+class IoRingUringTest : public IoRingTest {
+ protected:
+  IoRingUringTest()
+      : IoRingTest(true) {
+  }
+};
+
+class IoRingFallbackTest : public IoRingTest {
+ protected:
+  IoRingFallbackTest()
+      : IoRingTest(false) {
+  }
+};
+
+void IoRingTest::checkWriteAndReadFile() {
+  ASSERT_EQ(ring_->isOpen(), true);
+  std::vector<int64_t> offsets;
+  std::vector<size_t> sizes;
+  int64_t offset = 0;
+  for (int i = 0; i < 6; ++i) {
+    IoRing::Buffer buffer(*ring_);
+    ASSERT_EQ(buffer.isValid(), true);
+    ASSERT_EQ(buffer.put(i), true);
+    ASSERT_EQ(buffer.put(std::string(static_cast<size_t>(i) * 10, 'a' + i)), true);
+    offsets.push_back(offset);
+    sizes.push_back(buffer.getDataSize());
+    offset += buffer.getDataSize();
+    ASSERT_EQ(ring_->write(fd_, buffer, offsets.back(), static_cast<uint64_t>(i)), true);
+    ASSERT_EQ(buffer.isValid(), false);
+  }
+  ASSERT_EQ(ring_->submit(), true);
+  size_t completed = 0;
+  while (completed < 6) {
+    completed += ring_->poll([&sizes](const IoRing::Completion & _completion) {
+      ASSERT_EQ(_completion.isRead(), false);
+      ASSERT_EQ(_completion.getResult(), static_cast<int32_t>(sizes[_completion.getUserData()]));
+    }, 1);
+  }
+  ASSERT_EQ(ring_->getInflightCount(), 0);
+  ASSERT_EQ(ring_->getFreeBuffersCount(), 8);
+
+  for (int i = 0; i < 6; ++i) {
+    ASSERT_EQ(ring_->read(fd_, sizes[i], offsets[i], static_cast<uint64_t>(i)), true);
+  }
+  completed = 0;
+  while (completed < 6) {
+    completed += ring_->poll([](const IoRing::Completion & _completion) {
+      const int kIndex = static_cast<int>(_completion.getUserData());
+      ASSERT_EQ(_completion.isRead(), true);
+      UnpackBuffer buffer = _completion.getUnpackBuffer();
+      ASSERT_EQ(buffer.get<int>(), kIndex);
+      ASSERT_EQ(buffer.get<std::string>(), std::string(static_cast<size_t>(kIndex) * 10, 'a' + kIndex));
+    }, 6);
+  }
+}
+
+void IoRingTest::checkSocketStream() {
+  int sockets[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+  for (int i = 0; i < 4; ++i) {
+    IoRing::Buffer buffer(*ring_);
+    ASSERT_EQ(buffer.put(i * 100), true);
+    ASSERT_EQ(ring_->write(sockets[0], buffer, IoRing::kCurrentPosition, static_cast<uint64_t>(i)), true);
+  }
+  size_t completed = 0;
+  while (completed < 4) {
+    completed += ring_->poll([](const IoRing::Completion & _completion) {
+      ASSERT_EQ(_completion.getResult(), static_cast<int32_t>(sizeof(int)));
+    }, 4);
+  }
+  ASSERT_EQ(ring_->read(sockets[1], 4 * sizeof(int), IoRing::kCurrentPosition, 0), true);
+  int32_t read = 0;
+  std::vector<int> values;
+  while (read == 0) {
+    ring_->poll([&read, &values](const IoRing::Completion & _completion) {
+      read = _completion.getResult();
+      UnpackBuffer buffer = _completion.getUnpackBuffer();
+      while (buffer.getBufferSize() >= sizeof(int)) {
+        values.push_back(buffer.get<int>());
+      }
+    }, 1);
+  }
+  ASSERT_EQ(read, static_cast<int32_t>(4 * sizeof(int)));
+  ASSERT_EQ(values, std::vector<int>({0, 100, 200, 300}));
+  ::close(sockets[0]);
+  ::close(sockets[1]);
+}
+
+void IoRingTest::checkPoolExhaustion() {
+  std::vector<std::unique_ptr<IoRing::Buffer>> buffers;
+  for (int i = 0; i < 8; ++i) {
+    buffers.emplace_back(new IoRing::Buffer(*ring_));
+    ASSERT_EQ(buffers.back()->isValid(), true);
+  }
+  IoRing::Buffer extra(*ring_);
+  ASSERT_EQ(extra.isValid(), false);
+  ASSERT_EQ(ring_->read(fd_, 16, 0, 0), false);
+  buffers[0]->put(7);
+  ASSERT_EQ(ring_->write(fd_, *buffers[0], 0, 0), true);
+  ASSERT_EQ(extra.acquire(), false);
+  while (ring_->poll([](const IoRing::Completion &) {}, 1) == 0) {
+  }
+  ASSERT_EQ(extra.acquire(), true);
+}
+
+void IoRingTest::checkShortReads() {
+  const char kData[] = "0123456789";
+  ASSERT_EQ(::pwrite(fd_, kData, 10, 0), 10);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(ring_->read(fd_, 4, 4 * i, static_cast<uint64_t>(i)), true);
+  }
+  std::vector<int32_t> results(4, -1);
+  size_t completed = 0;
+  while (completed < 4) {
+    completed += ring_->poll([&results, &kData](const IoRing::Completion & _completion) {
+      const size_t kIndex = static_cast<size_t>(_completion.getUserData());
+      results[kIndex] = _completion.getResult();
+      if (_completion.getResult() > 0) {
+        ASSERT_EQ(std::memcmp(_completion.getUnpackBuffer().getData(), kData + 4 * kIndex,
+                              static_cast<size_t>(_completion.getResult())), 0);
+      }
+    }, 4);
+  }
+  // Reads after the end of file complete as single reads would
+  ASSERT_EQ(results, std::vector<int32_t>({4, 4, 2, 0}));
+}
+
+TEST_F(IoRingUringTest, WriteAndReadFileTest) {
+  checkWriteAndReadFile();
+}
+
+TEST_F(IoRingUringTest, SocketStreamTest) {
+  checkSocketStream();
+}
+
+TEST_F(IoRingUringTest, PoolExhaustionTest) {
+  checkPoolExhaustion();
+}
+
+TEST_F(IoRingUringTest, ShortReadsTest) {
+  checkShortReads();
+}
+
+TEST_F(IoRingFallbackTest, WriteAndReadFileTest) {
+  ASSERT_EQ(ring_->isUringEnabled(), false);
+  ASSERT_EQ(ring_->isFixed(), false);
+  checkWriteAndReadFile();
+}
+
+TEST_F(IoRingFallbackTest, SocketStreamTest) {
+  checkSocketStream();
+}
+
+TEST_F(IoRingFallbackTest, PoolExhaustionTest) {
+  checkPoolExhaustion();
+}
+
+TEST_F(IoRingFallbackTest, ShortReadsTest) {
+  checkShortReads();
+}
+
+TEST_F(IoRingFallbackTest, ClosedPeerTest) {
+  int sockets[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+  ::close(sockets[1]);
+  IoRing::Buffer buffer(*ring_);
+  ASSERT_EQ(buffer.put(1), true);
+  ASSERT_EQ(ring_->write(sockets[0], buffer, IoRing::kCurrentPosition, 0), true);
+  int32_t result = 0;
+  while (ring_->poll([&result](const IoRing::Completion & _completion) {
+    result = _completion.getResult();
+  }, 1) == 0) {
+  }
+  // Process is not killed by SIGPIPE, write reports error
+  ASSERT_EQ(result, -EPIPE);
+  ::close(sockets[0]);
+}
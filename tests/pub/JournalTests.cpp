@@ -0,0 +1,144 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include "pub/Journal.hpp"
+
+using buffers::JournalWriter;
+using buffers::JournalReader;
+using buffers::UnpackBuffer;
+
+struct JournalTest : testing::Test
+{
+  std::string path;
+  virtual void SetUp() {
+    path = testing::TempDir() + "pub_journal_test.bin";
+  };
+
+  virtual void TearDown() {
+    ::unlink(path.c_str());
+  };
+
+  void writeJournal(const uint64_t _count) {
+    JournalWriter writer(path, 8, 4);
+    ASSERT_EQ(writer.isOpen(), true);
+    for (uint64_t i = 0; i < _count; ++i) {
+      ASSERT_EQ(writer.append(i * 2 + 10, std::string("record ") + std::to_string(i)), true);
+    }
+    ASSERT_EQ(writer.getRecordsCount(), _count);
+  }
+};
+
+TEST_F(JournalTest, ReplayTest)
+{
+  writeJournal(1000);
+  JournalReader reader(path);
+  ASSERT_EQ(reader.isOpen(), true);
+  ASSERT_EQ(reader.getIndex().size(), 125);
+  uint64_t i = 0;
+  for (auto it = reader.begin(); it != reader.end(); ++it, ++i) {
+    ASSERT_EQ(it.sequence(), i * 2 + 10);
+    UnpackBuffer unbuffer = *it;
+    ASSERT_EQ(unbuffer.get<std::string>(), std::string("record ") + std::to_string(i));
+  }
+  ASSERT_EQ(i, 1000);
+}
+
+TEST_F(JournalTest, SeekTest)
+{
+  writeJournal(1000);
+  JournalReader reader(path);
+  auto it = reader.seek(10);
+  ASSERT_EQ(it.sequence(), 10);
+  it = reader.seek(777);
+  ASSERT_EQ(it.sequence(), 778);
+  ASSERT_EQ((*it).get<std::string>(), std::string("record 384"));
+  it = reader.seek(2008);
+  ASSERT_EQ(it.sequence(), 2008);
+  ASSERT_EQ(reader.seek(2009) == reader.end(), true);
+  ASSERT_EQ(reader.seek(0) == reader.begin(), true);
+}
+
+TEST_F(JournalTest, MultiValueRecordTest)
+{
+  {
+    JournalWriter writer(path);
+    buffers::PackBuffer * buffer = writer.beginRecord(1);
+    ASSERT_NE(buffer, nullptr);
+    ASSERT_EQ(buffer->put(uint8_t{ 5 }), true);
+    ASSERT_EQ(buffer->put(std::vector<int>{1, 2, 3}), true);
+    ASSERT_EQ(writer.commitRecord(), true);
+    ASSERT_NE(writer.beginRecord(2), nullptr);
+    writer.abortRecord();
+    ASSERT_EQ(writer.append(1, 1), false);
+    ASSERT_EQ(writer.append(3, 3), true);
+  }
+  JournalReader reader(path);
+  auto it = reader.begin();
+  UnpackBuffer unbuffer = *it;
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 5);
+  ASSERT_EQ(unbuffer.get<std::vector<int>>(), (std::vector<int>{1, 2, 3}));
+  ++it;
+  ASSERT_EQ(it.sequence(), 3);
+  ASSERT_EQ((*it).get<int>(), 3);
+  ++it;
+  ASSERT_EQ(it == reader.end(), true);
+}
+
+TEST_F(JournalTest, RecoveryWithoutFooterTest)
+{
+  {
+    JournalWriter writer(path, 4, 2);
+    for (uint64_t i = 1; i <= 100; ++i) {
+      ASSERT_EQ(writer.append(i, i), true);
+    }
+    ASSERT_EQ(writer.sync(), true);
+    // Simulate crash: file is left mapped without footer
+    std::string copy = path + ".crash";
+    std::ifstream src(path, std::ios::binary);
+    std::ofstream dst(copy, std::ios::binary);
+    dst << src.rdbuf();
+  }
+  std::rename((path + ".crash").c_str(), path.c_str());
+  JournalReader reader(path);
+  ASSERT_EQ(reader.isOpen(), true);
+  ASSERT_EQ(reader.getIndex().size(), 25);
+  uint64_t i = 1;
+  for (auto it = reader.begin(); it != reader.end(); ++it, ++i) {
+    ASSERT_EQ((*it).get<uint64_t>(), i);
+  }
+  ASSERT_EQ(i, 101);
+  ASSERT_EQ(reader.seek(50).sequence(), 50);
+}
+
+TEST_F(JournalTest, CorruptedJournalTest)
+{
+  writeJournal(100);
+  std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+  // Checkpoint which points to itself is rejected and index is rebuilt by scanning
+  buffers::JournalFormat::Footer footer;
+  file.seekg(-static_cast<std::streamoff>(sizeof(footer)), std::ios::end);
+  file.read(reinterpret_cast<char *>(&footer), sizeof(footer));
+  file.seekp(static_cast<std::streamoff>(footer.checkpoint_offset + sizeof(buffers::JournalFormat::RecordHeader)));
+  file.write(reinterpret_cast<const char *>(&footer.checkpoint_offset), sizeof(footer.checkpoint_offset));
+  file.flush();
+  {
+    JournalReader reader(path);
+    ASSERT_EQ(reader.isOpen(), true);
+    uint64_t i = 0;
+    for (auto it = reader.begin(); it != reader.end(); ++it, ++i) {
+      ASSERT_EQ(it.sequence(), i * 2 + 10);
+    }
+    ASSERT_EQ(i, 100);
+  }
+
+  // Journal with unknown alignment is not opened
+  const uint16_t kAlignment = 0;
+  file.seekp(offsetof(buffers::JournalFormat::Header, alignment));
+  file.write(reinterpret_cast<const char *>(&kAlignment), sizeof(kAlignment));
+  file.flush();
+  JournalReader reader(path);
+  ASSERT_EQ(reader.isOpen(), false);
+}
@@ -0,0 +1,136 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/MessageRegistry.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::MessageRegistry;
+using buffers::MessageId;
+
+struct Quote {
+  int instrument;
+  double price;
+};
+
+struct Trade {
+  int instrument;
+  std::string venue;
+};
+
+namespace buffers {
+template <>
+struct MessageTypeId<Quote> {
+  static constexpr MessageId value = 1;
+};
+
+template <>
+struct MessageTypeId<Trade> {
+  static constexpr MessageId value = 2;
+};
+
+template <>
+struct MessageTypeId<std::string> {
+  static constexpr MessageId value = 5;
+};
+
+template <>
+class PackBuffer::DelegatePackBuffer<Trade> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const Trade & _trade) {
+    return DelegatePackBuffer<int>::put(_ctx, _trade.instrument) &&
+           DelegatePackBuffer<std::string>::put(_ctx, _trade.venue);
+  }
+
+  static size_t getTypeSize(const Trade & _trade) {
+    return sizeof(int) + DelegatePackBuffer<std::string>::getTypeSize(_trade.venue);
+  }
+};
+
+template <>
+class UnpackBuffer::DelegateUnpackBuffer<Trade> {
+ public:
+  template <typename TBufferContext>
+  static Trade get(TBufferContext & _ctx) {
+    Trade result;
+    result.instrument = DelegateUnpackBuffer<int>::get(_ctx);
+    result.venue = DelegateUnpackBuffer<std::string>::get(_ctx);
+    return result;
+  }
+};
+}
+
+using Registry = MessageRegistry<Quote, Trade, std::string>;
+
+struct RegistryHandler {
+  int quotes = 0;
+  int trades = 0;
+  std::string last;
+
+  void operator()(Quote && _quote) {
+    EXPECT_EQ(_quote.instrument, 7);
+    EXPECT_EQ(_quote.price, 1.5);
+    ++quotes;
+  }
+
+  void operator()(Trade && _trade) {
+    EXPECT_EQ(_trade.instrument, 8);
+    ++trades;
+    last = _trade.venue;
+  }
+
+  void operator()(std::string && _str) {
+    last = _str;
+  }
+};
+
+TEST(MessageRegistryTest, DispatchTest)
+{
+  ASSERT_EQ(Registry::getId<Quote>(), 1);
+  ASSERT_EQ(Registry::getId<Trade>(), 2);
+
+  RegistryHandler handler;
+  {
+    HeapPackBuffer buffer(64);
+    ASSERT_EQ(Registry::put(buffer, Quote{7, 1.5}), true);
+    UnpackBuffer unbuffer(buffer.getData(), buffer.getDataSize());
+    ASSERT_EQ(Registry::dispatch(unbuffer, handler), true);
+  }
+  {
+    HeapPackBuffer buffer(64);
+    ASSERT_EQ(Registry::put(buffer, Trade{8, "XNAS"}), true);
+    UnpackBuffer unbuffer(buffer.getData(), buffer.getDataSize());
+    ASSERT_EQ(Registry::dispatch(unbuffer, handler), true);
+  }
+  {
+    HeapPackBuffer buffer(64);
+    ASSERT_EQ(Registry::put(buffer, std::string{"text"}), true);
+    UnpackBuffer unbuffer(buffer.getData(), buffer.getDataSize());
+    ASSERT_EQ(Registry::dispatch(unbuffer, handler), true);
+  }
+  ASSERT_EQ(handler.quotes, 1);
+  ASSERT_EQ(handler.trades, 1);
+  ASSERT_EQ(handler.last, std::string{"text"});
+}
+
+TEST(MessageRegistryTest, UnknownIdTest)
+{
+  RegistryHandler handler;
+  for (const MessageId kId : {MessageId{0}, MessageId{3}, MessageId{6}, MessageId{1000}}) {
+    HeapPackBuffer buffer(16);
+    buffer.put(kId);
+    UnpackBuffer unbuffer(buffer.getData(), buffer.getDataSize());
+    ASSERT_EQ(Registry::dispatch(unbuffer, handler), false);
+  }
+  UnpackBuffer empty(nullptr, 0);
+  ASSERT_EQ(Registry::dispatch(empty, handler), false);
+
+  HeapPackBuffer small(8);
+  ASSERT_EQ(Registry::put(small, Trade{8, "VERY LONG VENUE NAME"}), false);
+  ASSERT_EQ(small.getDataSize(), 0);
+}
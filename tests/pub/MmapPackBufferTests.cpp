@@ -0,0 +1,81 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include "pub/MmapPackBuffer.hpp"
+#include "pub/MmapUnpackBuffer.hpp"
+
+using buffers::MmapPackBuffer;
+using buffers::MmapUnpackBuffer;
+
+struct MmapPackBufferTest : testing::Test
+{
+  std::string path;
+  virtual void SetUp() {
+    path = testing::TempDir() + "pub_mmap_pack_buffer_test.bin";
+  };
+
+  virtual void TearDown() {
+    ::unlink(path.c_str());
+  };
+};
+
+TEST_F(MmapPackBufferTest, ValidDataTest)
+{
+  {
+    MmapPackBuffer buffer(path);
+    ASSERT_EQ(buffer.isOpen(), true);
+    ASSERT_EQ(buffer.put(uint8_t{ 1 }), true);
+    ASSERT_EQ(buffer.put(std::string{"Hello"}), true);
+    ASSERT_EQ(buffer.put(std::vector<int>{1, 2, 3}), true);
+    ASSERT_EQ(buffer.sync(), true);
+  }
+  MmapUnpackBuffer unbuffer(path);
+  ASSERT_EQ(unbuffer.isOpen(), true);
+  ASSERT_EQ(unbuffer.get<uint8_t>(), 1);
+  ASSERT_EQ(unbuffer.get(), std::string{"Hello"});
+  ASSERT_EQ(unbuffer.get<std::vector<int>>(), (std::vector<int>{1, 2, 3}));
+  ASSERT_EQ(unbuffer.getBufferSize(), 0);
+}
+
+TEST_F(MmapPackBufferTest, GrowTest)
+{
+  std::vector<uint64_t> vec(100000);
+  for (size_t i = 0; i < vec.size(); ++i) {
+    vec[i] = i * 3;
+  }
+  {
+    MmapPackBuffer buffer(path, 4096);
+    for (int i = 0; i < 2000; ++i) {
+      ASSERT_EQ(buffer.put(i), true);
+    }
+    ASSERT_EQ(buffer.put(vec), true);
+    ASSERT_EQ(buffer.put(std::string(10000, 'x')), true);
+  }
+  MmapUnpackBuffer unbuffer(path);
+  for (int i = 0; i < 2000; ++i) {
+    ASSERT_EQ(unbuffer.get<int>(), i);
+  }
+  ASSERT_EQ(unbuffer.get<std::vector<uint64_t>>(), vec);
+  ASSERT_EQ(unbuffer.get<std::string>(), std::string(10000, 'x'));
+}
+
+TEST_F(MmapPackBufferTest, TruncateOnCloseTest)
+{
+  {
+    MmapPackBuffer buffer(path);
+    ASSERT_EQ(buffer.put(uint32_t{ 7 }), true);
+    ASSERT_EQ(buffer.put(uint32_t{ 8 }), true);
+  }
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  ASSERT_EQ(file.tellg(), 8);
+}
+
+TEST_F(MmapPackBufferTest, MissingFileTest)
+{
+#ifdef __cpp_exceptions
+  ASSERT_THROW(MmapUnpackBuffer(path + ".missing"), std::system_error);
+#endif
+}
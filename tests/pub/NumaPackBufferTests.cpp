@@ -0,0 +1,63 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <string>
+#include "pub/NumaPackBuffer.hpp"
+#include "pub/FrozenMessage.hpp"
+#include "pub/UnpackBuffer.hpp"
+
+using buffers::NumaPackBuffer;
+using buffers::NumaOptions;
+using buffers::NumaMemory;
+using buffers::PackBufferPool;
+using buffers::PooledPackBuffer;
+using buffers::FrozenMessage;
+using buffers::UnpackBuffer;
+
+TEST(NumaPackBufferTest, TopologyTest) {
+  ASSERT_GE(NumaMemory::getNodesCount(), 1);
+  ASSERT_GE(NumaMemory::getCurrentNode(), 0);
+  ASSERT_LT(NumaMemory::getCurrentNode(), NumaMemory::getNodesCount());
+}
+
+TEST(NumaPackBufferTest, LocalPlacementTest) {
+  NumaPackBuffer buffer(64 * 1024, NumaOptions(NumaOptions::kLocalNode, true));
+  ASSERT_EQ(buffer.isOpen(), true);
+  // Pages are pre-faulted, so they are already placed
+  const int kNode = NumaMemory::getNodeOfAddress(buffer.getData());
+  if (kNode >= 0) {
+    ASSERT_LT(kNode, NumaMemory::getNodesCount());
+  }
+  ASSERT_EQ(buffer.put(42), true);
+  ASSERT_EQ(buffer.put(std::string("numa")), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<int>(), 42);
+  ASSERT_EQ(unpack.get<std::string>(), "numa");
+}
+
+TEST(NumaPackBufferTest, HugePagesTest) {
+  const size_t kSize = 3 * NumaMemory::kHugePageSize;
+  NumaPackBuffer buffer(kSize, NumaOptions(0, false, true));
+  ASSERT_EQ(buffer.isOpen(), true);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(buffer.getData()) % NumaMemory::kHugePageSize, 0);
+  ASSERT_EQ(buffer.getBufferSize(), kSize);
+  for (size_t i = 0; i < kSize / sizeof(uint64_t); ++i) {
+    ASSERT_EQ(buffer.put(static_cast<uint64_t>(i)), true);
+  }
+  ASSERT_EQ(buffer.put(1), false);
+}
+
+TEST(NumaPackBufferTest, PoolTest) {
+  PackBufferPool pool(4096, NumaOptions(NumaOptions::kLocalNode, true));
+  FrozenMessage message;
+  {
+    PooledPackBuffer buffer(pool);
+    ASSERT_EQ(buffer.put(7), true);
+    message = buffer.freeze();
+  }
+  ASSERT_EQ(message.getUnpackBuffer().get<int>(), 7);
+  message = FrozenMessage();
+  ASSERT_EQ(pool.getFreeCount(), 1);
+}
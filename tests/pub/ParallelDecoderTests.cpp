@@ -0,0 +1,121 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/ParallelDecoder.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::FrameWriter;
+using buffers::FrameReader;
+using buffers::MessageList;
+using buffers::ParallelDecoder;
+using buffers::ThreadPool;
+
+static const int kCount = 10000;
+
+struct ParallelDecoderTest : testing::Test
+{
+  ThreadPool * pool;
+  HeapPackBuffer * buffer;
+  virtual void SetUp() {
+    pool = new ThreadPool(3);
+    buffer = new HeapPackBuffer(1 << 20);
+    FrameWriter writer(*buffer);
+    for (int i = 0; i < kCount; ++i) {
+      writer.put(std::make_pair(i, std::to_string(i)));
+    }
+  };
+
+  virtual void TearDown() {
+    delete buffer;
+    delete pool;
+  };
+};
+
+TEST_F(ParallelDecoderTest, WorkStealingTest)
+{
+  std::vector<std::atomic<int>> visited(1000);
+  pool->parallelFor(visited.size(), [&visited](const size_t _index) {
+    // The first indices are much heavier, so other participants have to steal them
+    if (_index < 10) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    ++visited[_index];
+  });
+  for (auto & value : visited) {
+    ASSERT_EQ(value.load(), 1);
+  }
+
+  std::atomic<int> nested{0};
+  pool->parallelFor(8, [this, &nested](const size_t) {
+    pool->parallelFor(8, [&nested](const size_t) {
+      ++nested;
+    });
+  });
+  ASSERT_EQ(nested.load(), 64);
+}
+
+TEST_F(ParallelDecoderTest, OrderedDecodeTest)
+{
+  MessageList messages{FrameReader(*buffer)};
+  ASSERT_EQ(messages.size(), kCount);
+  ParallelDecoder decoder(*pool, 64);
+  int expected = 0;
+  decoder.decode<std::pair<int, std::string>>(messages, [&expected](const size_t _index, std::pair<int, std::string> && _value) {
+    EXPECT_EQ(_index, expected);
+    EXPECT_EQ(_value.first, expected);
+    EXPECT_EQ(_value.second, std::to_string(expected));
+    ++expected;
+  }, ParallelDecoder::Order::Input);
+  ASSERT_EQ(expected, kCount);
+}
+
+TEST_F(ParallelDecoderTest, UnorderedDecodeTest)
+{
+  MessageList messages{FrameReader(*buffer)};
+  ParallelDecoder decoder(*pool, 64);
+  std::atomic<long> sum{0};
+  std::atomic<int> count{0};
+  decoder.decode<std::pair<int, std::string>>(messages, [&sum, &count](const size_t _index, std::pair<int, std::string> && _value) {
+    EXPECT_EQ(static_cast<int>(_index), _value.first);
+    sum += _value.first;
+    ++count;
+  });
+  ASSERT_EQ(count.load(), kCount);
+  ASSERT_EQ(sum.load(), static_cast<long>(kCount) * (kCount - 1) / 2);
+
+  std::vector<std::pair<int, std::string>> slots(messages.size());
+  decoder.decode(messages, slots.data());
+  for (int i = 0; i < kCount; ++i) {
+    ASSERT_EQ(slots[i].first, i);
+    ASSERT_EQ(slots[i].second, std::to_string(i));
+  }
+}
+
+TEST_F(ParallelDecoderTest, FixedStrideTest)
+{
+  const size_t kStride = 16;
+  std::vector<uint8_t> records(kStride * kCount, 0);
+  for (int i = 0; i < kCount; ++i) {
+    PackBuffer record(records.data() + i * kStride, kStride);
+    record.put(i);
+    record.put(static_cast<double>(i) / 2);
+  }
+  MessageList messages(records.data(), kCount, kStride);
+  ParallelDecoder decoder(*pool);
+  std::vector<double> halves(kCount, 0);
+  decoder.forEach(messages, [&halves](const size_t _index, UnpackBuffer & _buffer) {
+    const int kValue = _buffer.get<int>();
+    EXPECT_EQ(kValue, static_cast<int>(_index));
+    halves[_index] = _buffer.get<double>();
+  });
+  for (int i = 0; i < kCount; ++i) {
+    ASSERT_EQ(halves[i], static_cast<double>(i) / 2);
+  }
+}
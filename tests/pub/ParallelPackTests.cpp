@@ -0,0 +1,164 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/UnpackBuffer.hpp"
+#include "pub/ParallelPack.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+using buffers::ThreadPool;
+
+struct ParallelRecord {
+  int id;
+  std::string name;
+  std::vector<double> values;
+};
+
+namespace buffers {
+template <>
+class PackBuffer::DelegatePackBuffer<ParallelRecord> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const ParallelRecord & _record) {
+    return DelegatePackBuffer<int>::put(_ctx, _record.id) &&
+           DelegatePackBuffer<std::string>::put(_ctx, _record.name) &&
+           DelegatePackBuffer<std::vector<double>>::put(_ctx, _record.values);
+  }
+
+  static size_t getTypeSize(const ParallelRecord & _record) {
+    return sizeof(int) +
+           DelegatePackBuffer<std::string>::getTypeSize(_record.name) +
+           DelegatePackBuffer<std::vector<double>>::getTypeSize(_record.values);
+  }
+};
+
+template <>
+class UnpackBuffer::DelegateUnpackBuffer<ParallelRecord> {
+ public:
+  template <typename TBufferContext>
+  static ParallelRecord get(TBufferContext & _ctx) {
+    ParallelRecord result;
+    result.id = DelegateUnpackBuffer<int>::get(_ctx);
+    result.name = DelegateUnpackBuffer<std::string>::get(_ctx);
+    result.values = DelegateUnpackBuffer<std::vector<double>>::get(_ctx);
+    return result;
+  }
+};
+}
+
+struct ParallelPackTest : testing::Test
+{
+  ThreadPool * pool;
+  virtual void SetUp() {
+    pool = new ThreadPool(3);
+  };
+
+  virtual void TearDown() {
+    delete pool;
+  };
+
+  template <typename C>
+  void checkIdentical(const C & _container, const size_t _size) {
+    HeapPackBuffer serial(_size);
+    HeapPackBuffer parallel(_size);
+    ASSERT_EQ(serial.put(_container), true);
+    ASSERT_EQ(parallel.put(buffers::parallel(_container, *pool, 7)), true);
+    ASSERT_EQ(parallel.getDataSize(), serial.getDataSize());
+    ASSERT_EQ(std::memcmp(parallel.getData(), serial.getData(), serial.getDataSize()), 0);
+  }
+};
+
+TEST_F(ParallelPackTest, ParallelForTest)
+{
+  std::vector<int> visited(1000, 0);
+  pool->parallelFor(visited.size(), [&visited](const size_t _index) {
+    ++visited[_index];
+  });
+  for (int value : visited) {
+    ASSERT_EQ(value, 1);
+  }
+}
+
+TEST_F(ParallelPackTest, VectorOfStringsTest)
+{
+  std::vector<std::string> strings;
+  for (int i = 0; i < 1000; ++i) {
+    strings.push_back(std::string(i % 13, 'a' + i % 26));
+  }
+  checkIdentical(strings, 32 * 1024);
+
+  HeapPackBuffer buffer(32 * 1024);
+  ASSERT_EQ(buffer.put(buffers::parallel(strings, *pool, 7)), true);
+  UnpackBuffer unbuffer(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unbuffer.get<std::vector<std::string>>(), strings);
+}
+
+TEST_F(ParallelPackTest, VectorOfUserTypeTest)
+{
+  std::vector<ParallelRecord> records;
+  for (int i = 0; i < 500; ++i) {
+    records.push_back(ParallelRecord{i, std::to_string(i), std::vector<double>(i % 5 + 1, i * 0.5)});
+  }
+  checkIdentical(records, 64 * 1024);
+
+  HeapPackBuffer buffer(64 * 1024);
+  ASSERT_EQ(buffer.put(buffers::parallel(records, *pool, 7)), true);
+  UnpackBuffer unbuffer(buffer.getData(), buffer.getDataSize());
+  auto unpacked = unbuffer.get<std::vector<ParallelRecord>>();
+  ASSERT_EQ(unpacked.size(), records.size());
+  for (size_t i = 0; i < records.size(); ++i) {
+    ASSERT_EQ(unpacked[i].id, records[i].id);
+    ASSERT_EQ(unpacked[i].name, records[i].name);
+    ASSERT_EQ(unpacked[i].values, records[i].values);
+  }
+}
+
+TEST_F(ParallelPackTest, MapsTest)
+{
+  std::unordered_map<int, std::string> strings;
+  std::map<int, int> numbers;
+  for (int i = 0; i < 1000; ++i) {
+    strings[i * 7] = std::to_string(i);
+    numbers[i] = -i;
+  }
+  checkIdentical(strings, 32 * 1024);
+  checkIdentical(numbers, 32 * 1024);
+  checkIdentical(std::vector<int>(1001, 5), 8 * 1024);
+}
+
+TEST_F(ParallelPackTest, InexactTypeSizeTest)
+{
+  // getTypeSize() of ParallelRecord is not aligned per field, so with 8 bytes alignment
+  // its packed size is not known exactly and records are packed serially
+  std::vector<ParallelRecord> records;
+  std::vector<std::vector<int>> vectors;
+  for (int i = 0; i < 100; ++i) {
+    records.push_back(ParallelRecord{i, std::to_string(i), std::vector<double>(i % 3 + 1, i * 0.5)});
+    vectors.push_back(std::vector<int>(i % 5 + 1, i));
+  }
+  std::vector<uint8_t> serialStorage(16 * 1024);
+  std::vector<uint8_t> parallelStorage(16 * 1024);
+  PackBuffer serial(serialStorage.data(), serialStorage.size(), buffers::AlignMemory::Bits_64);
+  PackBuffer parallel(parallelStorage.data(), parallelStorage.size(), buffers::AlignMemory::Bits_64);
+  ASSERT_EQ(serial.put(records), true);
+  ASSERT_EQ(serial.put(vectors), true);
+  ASSERT_EQ(parallel.put(buffers::parallel(records, *pool, 7)), true);
+  ASSERT_EQ(parallel.put(buffers::parallel(vectors, *pool, 7)), true);
+  ASSERT_EQ(parallel.getDataSize(), serial.getDataSize());
+  ASSERT_EQ(std::memcmp(parallel.getData(), serial.getData(), serial.getDataSize()), 0);
+}
+
+TEST_F(ParallelPackTest, NotEnoughSpaceTest)
+{
+  std::vector<std::string> strings(100, std::string(10, 's'));
+  HeapPackBuffer buffer(512);
+  ASSERT_EQ(buffer.put(buffers::parallel(strings, *pool)), false);
+  ASSERT_EQ(buffer.getDataSize(), 0);
+}
@@ -0,0 +1,238 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/PresenceBitmap.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::PresenceStruct;
+
+namespace {
+struct Limits {
+  int32_t maxOrders = 100;
+  std::string currency = "USD";
+
+  bool operator==(const Limits & _other) const {
+    return maxOrders == _other.maxOrders && currency == _other.currency;
+  }
+};
+
+struct Wide {
+  int32_t f0;
+  double f1;
+  uint16_t f2;
+  int64_t f3;
+  int32_t f4;
+  double f5;
+  uint16_t f6;
+  int64_t f7;
+  int32_t f8;
+  double f9;
+  uint16_t f10;
+  int64_t f11;
+  int32_t f12;
+  double f13;
+  uint16_t f14;
+  int64_t f15;
+  int32_t f16;
+  double f17;
+  uint16_t f18;
+  int64_t f19;
+  int32_t f20;
+  double f21;
+  uint16_t f22;
+  int64_t f23;
+  int32_t f24;
+  double f25;
+  uint16_t f26;
+  int64_t f27;
+  int32_t f28;
+  double f29;
+  uint16_t f30;
+  int64_t f31;
+  int32_t f32;
+  double f33;
+  std::string comment;
+  Limits limits;
+
+  bool operator==(const Wide & _other) const {
+    return f0 == _other.f0 && f1 == _other.f1 && f2 == _other.f2 && f3 == _other.f3 &&
+           f4 == _other.f4 && f5 == _other.f5 && f6 == _other.f6 && f7 == _other.f7 &&
+           f8 == _other.f8 && f9 == _other.f9 && f10 == _other.f10 && f11 == _other.f11 &&
+           f12 == _other.f12 && f13 == _other.f13 && f14 == _other.f14 && f15 == _other.f15 &&
+           f16 == _other.f16 && f17 == _other.f17 && f18 == _other.f18 && f19 == _other.f19 &&
+           f20 == _other.f20 && f21 == _other.f21 && f22 == _other.f22 && f23 == _other.f23 &&
+           f24 == _other.f24 && f25 == _other.f25 && f26 == _other.f26 && f27 == _other.f27 &&
+           f28 == _other.f28 && f29 == _other.f29 && f30 == _other.f30 && f31 == _other.f31 &&
+           f32 == _other.f32 && f33 == _other.f33 &&
+           comment == _other.comment && limits == _other.limits;
+  }
+};
+}
+
+namespace buffers {
+template <>
+struct StructFields<Limits> {
+  template <typename TVisitor>
+  static void visit(TVisitor & _visitor) {
+    _visitor(&Limits::maxOrders);
+    _visitor(&Limits::currency);
+  }
+};
+
+template <>
+struct StructFields<Wide> {
+  template <typename TVisitor>
+  static void visit(TVisitor & _visitor) {
+    _visitor(&Wide::f0);
+    _visitor(&Wide::f1);
+    _visitor(&Wide::f2);
+    _visitor(&Wide::f3);
+    _visitor(&Wide::f4);
+    _visitor(&Wide::f5);
+    _visitor(&Wide::f6);
+    _visitor(&Wide::f7);
+    _visitor(&Wide::f8);
+    _visitor(&Wide::f9);
+    _visitor(&Wide::f10);
+    _visitor(&Wide::f11);
+    _visitor(&Wide::f12);
+    _visitor(&Wide::f13);
+    _visitor(&Wide::f14);
+    _visitor(&Wide::f15);
+    _visitor(&Wide::f16);
+    _visitor(&Wide::f17);
+    _visitor(&Wide::f18);
+    _visitor(&Wide::f19);
+    _visitor(&Wide::f20);
+    _visitor(&Wide::f21);
+    _visitor(&Wide::f22);
+    _visitor(&Wide::f23);
+    _visitor(&Wide::f24);
+    _visitor(&Wide::f25);
+    _visitor(&Wide::f26);
+    _visitor(&Wide::f27);
+    _visitor(&Wide::f28);
+    _visitor(&Wide::f29);
+    _visitor(&Wide::f30);
+    _visitor(&Wide::f31);
+    _visitor(&Wide::f32);
+    _visitor(&Wide::f33);
+    _visitor(&Wide::comment);
+    _visitor(&Wide::limits);
+  }
+};
+}
+
+struct PresenceBitmapTest : testing::Test
+{
+  HeapPackBuffer buffer{1 << 16};
+
+  /**
+   * Method for packing of every field as usual
+   */
+  static void putPlain(HeapPackBuffer & _buffer, const Wide & _wide) {
+    EXPECT_EQ(_buffer.put(_wide.f0), true);
+    EXPECT_EQ(_buffer.put(_wide.f1), true);
+    EXPECT_EQ(_buffer.put(_wide.f2), true);
+    EXPECT_EQ(_buffer.put(_wide.f3), true);
+    EXPECT_EQ(_buffer.put(_wide.f4), true);
+    EXPECT_EQ(_buffer.put(_wide.f5), true);
+    EXPECT_EQ(_buffer.put(_wide.f6), true);
+    EXPECT_EQ(_buffer.put(_wide.f7), true);
+    EXPECT_EQ(_buffer.put(_wide.f8), true);
+    EXPECT_EQ(_buffer.put(_wide.f9), true);
+    EXPECT_EQ(_buffer.put(_wide.f10), true);
+    EXPECT_EQ(_buffer.put(_wide.f11), true);
+    EXPECT_EQ(_buffer.put(_wide.f12), true);
+    EXPECT_EQ(_buffer.put(_wide.f13), true);
+    EXPECT_EQ(_buffer.put(_wide.f14), true);
+    EXPECT_EQ(_buffer.put(_wide.f15), true);
+    EXPECT_EQ(_buffer.put(_wide.f16), true);
+    EXPECT_EQ(_buffer.put(_wide.f17), true);
+    EXPECT_EQ(_buffer.put(_wide.f18), true);
+    EXPECT_EQ(_buffer.put(_wide.f19), true);
+    EXPECT_EQ(_buffer.put(_wide.f20), true);
+    EXPECT_EQ(_buffer.put(_wide.f21), true);
+    EXPECT_EQ(_buffer.put(_wide.f22), true);
+    EXPECT_EQ(_buffer.put(_wide.f23), true);
+    EXPECT_EQ(_buffer.put(_wide.f24), true);
+    EXPECT_EQ(_buffer.put(_wide.f25), true);
+    EXPECT_EQ(_buffer.put(_wide.f26), true);
+    EXPECT_EQ(_buffer.put(_wide.f27), true);
+    EXPECT_EQ(_buffer.put(_wide.f28), true);
+    EXPECT_EQ(_buffer.put(_wide.f29), true);
+    EXPECT_EQ(_buffer.put(_wide.f30), true);
+    EXPECT_EQ(_buffer.put(_wide.f31), true);
+    EXPECT_EQ(_buffer.put(_wide.f32), true);
+    EXPECT_EQ(_buffer.put(_wide.f33), true);
+    EXPECT_EQ(_buffer.put(_wide.comment), true);
+    EXPECT_EQ(_buffer.put(_wide.limits.maxOrders), true);
+    EXPECT_EQ(_buffer.put(_wide.limits.currency), true);
+  }
+};
+
+TEST_F(PresenceBitmapTest, SparseFieldsTest) {
+  Wide wide{};
+  wide.f3 = -7;
+  wide.f17 = 2.5;
+  wide.f33 = 1;
+  wide.limits.maxOrders = 10;
+  ASSERT_EQ(buffer.put(buffers::presence(wide)), true);
+  const size_t kPresenceSize = buffer.getDataSize();
+  // Two words of bitmap, three 8-byte fields, one word of nested bitmap and one nested field
+  ASSERT_EQ(kPresenceSize, 2 * 4 + 3 * 8 + 4 + 4);
+  ASSERT_EQ(buffer.put(3), true);
+
+  HeapPackBuffer plain(1 << 12);
+  putPlain(plain, wide);
+  ASSERT_LT(kPresenceSize * 5, plain.getDataSize());
+
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  const Wide kWide = unpack.get<PresenceStruct<Wide>>();
+  ASSERT_EQ(kWide == wide, true);
+  ASSERT_EQ(unpack.get<int>(), 3);
+}
+
+TEST_F(PresenceBitmapTest, DefaultsTest) {
+  // Struct with only default fields takes only bitmap
+  const PresenceStruct<Wide> kDefault;
+  ASSERT_EQ(buffer.put(kDefault), true);
+  ASSERT_EQ(buffer.getDataSize(), 2 * sizeof(uint32_t));
+
+  // Default values of member initializers are not packed, changed ones are
+  Wide wide{};
+  wide.f1 = -0.0;
+  wide.comment = "manual";
+  wide.limits.currency = "EUR";
+  PresenceStruct<Wide> wrapped(wide);
+  wrapped.f0 = 1;
+  wrapped.f32 = 2;
+  wrapped.limits.maxOrders = 0;
+  wrapped.limits.currency.clear();
+  ASSERT_EQ(buffer.put(buffers::presence(wide)), true);
+  ASSERT_EQ(buffer.put(wrapped), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<PresenceStruct<Wide>>() == Wide(), true);
+  const Wide kWide = unpack.get<PresenceStruct<Wide>>();
+  ASSERT_EQ(kWide == wide, true);
+  ASSERT_EQ(std::signbit(kWide.f1), true);
+  ASSERT_EQ(kWide.limits.maxOrders, 100);
+  ASSERT_EQ(unpack.get<PresenceStruct<Wide>>() == wrapped, true);
+}
+
+TEST_F(PresenceBitmapTest, UnknownFieldTest) {
+  Wide wide{};
+  wide.f0 = 1;
+  ASSERT_EQ(buffer.put(buffers::presence(wide)), true);
+  // Wide has 36 fields, so bit 4 of the second word is not a field
+  std::vector<uint8_t> corrupted(buffer.getData(), buffer.getData() + buffer.getDataSize());
+  corrupted[4] |= 0x10;
+  UnpackBuffer unpack(corrupted.data(), corrupted.size());
+  ASSERT_THROW(unpack.get<PresenceStruct<Wide>>(), std::out_of_range);
+}
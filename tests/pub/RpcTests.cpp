@@ -0,0 +1,163 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <unistd.h>
+#include "pub/Rpc.hpp"
+
+using buffers::RpcServer;
+using buffers::RpcClient;
+using buffers::RpcStatus;
+using buffers::MessageId;
+
+struct SumRequest {
+  int first;
+  int second;
+};
+
+struct SumResponse {
+  int sum;
+};
+
+struct UnhandledRequest {
+  int value;
+};
+
+namespace buffers {
+template <>
+struct MessageTypeId<SumRequest> {
+  static constexpr MessageId value = 10;
+};
+
+template <>
+struct MessageTypeId<UnhandledRequest> {
+  static constexpr MessageId value = 11;
+};
+}
+
+class RpcTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = "/tmp/pub_rpc_test_" + std::to_string(::getpid()) + ".sock";
+    server_ = new RpcServer(path_);
+    server_->handle<SumRequest, SumResponse>([](SumRequest && _request) {
+      return SumResponse{_request.first + _request.second};
+    });
+    thread_ = std::thread([this] {
+      server_->run();
+    });
+  }
+
+  void TearDown() override {
+    server_->stop();
+    thread_.join();
+    delete server_;
+  }
+
+  std::string path_;
+  RpcServer * server_;
+  std::thread thread_;
+};
+
+TEST_F(RpcTest, SyncCallTest) {
+  RpcClient client(path_);
+  ASSERT_EQ(client.isOpen(), true);
+  SumResponse response{0};
+  ASSERT_EQ(client.call(SumRequest{2, 3}, response, 5000) == RpcStatus::Ok, true);
+  ASSERT_EQ(response.sum, 5);
+  ASSERT_EQ(client.call(SumRequest{-7, 3}, response, 5000) == RpcStatus::Ok, true);
+  ASSERT_EQ(response.sum, -4);
+  ASSERT_EQ(client.getPendingCount(), 0);
+}
+
+TEST_F(RpcTest, PipelinedCallsTest) {
+  RpcClient client(path_);
+  const int kCount = 1000;
+  std::vector<int> sums(kCount, -1);
+  for (int i = 0; i < kCount; ++i) {
+    const uint64_t kId = client.send<SumResponse>(SumRequest{i, i}, [&sums, i](RpcStatus _status, SumResponse && _response) {
+      sums[i] = (_status == RpcStatus::Ok) ? _response.sum : -2;
+    });
+    ASSERT_NE(kId, 0);
+  }
+  ASSERT_EQ(client.flush(), true);
+  size_t received = 0;
+  while (received < kCount && client.isOpen()) {
+    received += client.poll(5000);
+  }
+  ASSERT_EQ(received, kCount);
+  for (int i = 0; i < kCount; ++i) {
+    ASSERT_EQ(sums[i], 2 * i);
+  }
+}
+
+TEST_F(RpcTest, HalfClosedClientTest) {
+  RpcClient client(path_);
+  const int kCount = 1000;
+  int received = 0;
+  for (int i = 0; i < kCount; ++i) {
+    client.send<SumResponse>(SumRequest{i, 1}, [&received, i](RpcStatus _status, SumResponse && _response) {
+      if (_status == RpcStatus::Ok && _response.sum == i + 1) {
+        ++received;
+      }
+    });
+  }
+  ASSERT_EQ(client.flush(), true);
+  // Server reads end of input together with the last requests, their responses should still be sent
+  ASSERT_EQ(::shutdown(client.getFd(), SHUT_WR), 0);
+  while (received < kCount && client.isOpen()) {
+    client.poll(5000);
+  }
+  ASSERT_EQ(received, kCount);
+}
+
+TEST_F(RpcTest, UnknownMethodTest) {
+  RpcClient client(path_);
+  SumResponse response{0};
+  ASSERT_EQ(client.call(UnhandledRequest{1}, response, 5000) == RpcStatus::UnknownMethod, true);
+  ASSERT_EQ(client.call(SumRequest{1, 1}, response, 5000) == RpcStatus::Ok, true);
+  ASSERT_EQ(response.sum, 2);
+}
+
+TEST_F(RpcTest, MultipleClientsTest) {
+  std::vector<std::thread> threads;
+  std::atomic<int> succeeded{0};
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([this, t, &succeeded] {
+      RpcClient client(path_);
+      for (int i = 0; i < 100; ++i) {
+        SumResponse response{0};
+        if (client.call(SumRequest{t, i}, response, 5000) == RpcStatus::Ok && response.sum == t + i) {
+          ++succeeded;
+        }
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(succeeded.load(), 400);
+}
+
+TEST(RpcDisconnectTest, PendingCallsFailTest) {
+  const std::string kPath = "/tmp/pub_rpc_disconnect_" + std::to_string(::getpid()) + ".sock";
+  RpcClient * pClient = nullptr;
+  {
+    RpcServer server(kPath);
+    pClient = new RpcClient(kPath);
+    ASSERT_EQ(server.poll(1000), true);
+    ASSERT_EQ(server.getConnectionsCount(), 1);
+  }
+  RpcStatus status = RpcStatus::Ok;
+  pClient->send<SumResponse>(SumRequest{1, 2}, [&status](RpcStatus _status, SumResponse &&) {
+    status = _status;
+  });
+  pClient->flush();
+  pClient->poll(1000);
+  ASSERT_EQ(status == RpcStatus::Disconnected, true);
+  ASSERT_EQ(pClient->isOpen(), false);
+  ASSERT_EQ(pClient->getPendingCount(), 0);
+  delete pClient;
+}
@@ -0,0 +1,166 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "pub/SharedMemoryQueue.hpp"
+
+using buffers::SharedMemoryQueue;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+
+struct SharedMemoryQueueTest : testing::Test
+{
+  std::string name;
+  SharedMemoryQueue * queue;
+  virtual void SetUp() {
+    name = "/pub_queue_test_" + std::to_string(::getpid());
+    queue = new SharedMemoryQueue(name, SharedMemoryQueue::OpenMode::Create, 4096);
+  };
+
+  virtual void TearDown() {
+    delete queue;
+    SharedMemoryQueue::remove(name);
+  };
+};
+
+TEST_F(SharedMemoryQueueTest, PushPopTest)
+{
+  ASSERT_EQ(queue->isOpen(), true);
+  ASSERT_EQ(queue->getCapacity(), 4096);
+  ASSERT_EQ(queue->tryPush(1), true);
+  ASSERT_EQ(queue->tryPush(std::string{"Hello"}), true);
+  {
+    SharedMemoryQueue::Writer writer(*queue);
+    ASSERT_EQ(writer.begin(64), true);
+    ASSERT_EQ(writer.put(uint8_t{ 3 }), true);
+    ASSERT_EQ(writer.put(std::vector<int>{4, 5}), true);
+    ASSERT_EQ(writer.commit(), true);
+  }
+  {
+    SharedMemoryQueue::Writer writer(*queue);
+    ASSERT_EQ(writer.begin(16), true);
+    ASSERT_EQ(writer.put(7), true);
+  }
+
+  int value = 0;
+  ASSERT_EQ(queue->tryPop(value), true);
+  ASSERT_EQ(value, 1);
+  std::string str;
+  ASSERT_EQ(queue->tryPop(str), true);
+  ASSERT_EQ(str, std::string{"Hello"});
+  UnpackBuffer * unbuffer = queue->beginRead();
+  ASSERT_NE(unbuffer, nullptr);
+  ASSERT_EQ(unbuffer->get<uint8_t>(), 3);
+  ASSERT_EQ(unbuffer->get<std::vector<int>>(), (std::vector<int>{4, 5}));
+  queue->commitRead();
+  // Aborted record is skipped as padding
+  ASSERT_EQ(queue->beginRead(), nullptr);
+  ASSERT_EQ(queue->wait(std::chrono::milliseconds(1)), false);
+}
+
+TEST_F(SharedMemoryQueueTest, CorruptedAlignmentTest)
+{
+  // Alignment is the second 32-bit field of control block
+  const int kFd = ::shm_open(name.c_str(), O_RDWR, 0600);
+  ASSERT_GE(kFd, 0);
+  const uint32_t kAlignment = 0;
+  ASSERT_EQ(::pwrite(kFd, &kAlignment, sizeof(kAlignment), sizeof(uint32_t)), sizeof(kAlignment));
+  ::close(kFd);
+  ASSERT_THROW(SharedMemoryQueue(name, SharedMemoryQueue::OpenMode::Open), std::system_error);
+}
+
+TEST_F(SharedMemoryQueueTest, FullAndWrapAroundTest)
+{
+  int pushed = 0;
+  while (queue->tryPush(uint64_t(pushed))) {
+    ++pushed;
+  }
+  // Every record is 8 bytes of header and 8 bytes of value,
+  // reservation has 8 bytes more for alignment which are released only by consumer
+  ASSERT_EQ(pushed, 4096 / 24);
+  uint64_t value = 0;
+  ASSERT_EQ(queue->tryPop(value), true);
+  ASSERT_EQ(value, 0);
+  ASSERT_EQ(queue->tryPush(uint64_t(100)), true);
+  ASSERT_EQ(queue->tryPush(uint64_t(101)), false);
+  while (queue->tryPop(value)) {
+  }
+  ASSERT_EQ(value, 100);
+
+  const std::string kText(100, 't');
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(queue->tryPush(kText + std::to_string(i)), true);
+    ASSERT_EQ(queue->tryPush(i), true);
+    std::string str;
+    ASSERT_EQ(queue->tryPop(str), true);
+    ASSERT_EQ(str, kText + std::to_string(i));
+    int number = 0;
+    ASSERT_EQ(queue->tryPop(number), true);
+    ASSERT_EQ(number, i);
+  }
+  ASSERT_EQ(queue->beginRead(), nullptr);
+}
+
+TEST_F(SharedMemoryQueueTest, MultipleProducersTest)
+{
+  const int kProducers = 4;
+  const int kCount = 20000;
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([this, p, kCount] {
+      SharedMemoryQueue producerQueue(name, SharedMemoryQueue::OpenMode::Open);
+      for (int i = 0; i < kCount; ++i) {
+        while (!producerQueue.tryPush(std::make_pair(p, i))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  std::vector<int> expected(kProducers, 0);
+  for (int i = 0; i < kProducers * kCount; ++i) {
+    std::pair<int, int> value;
+    while (!queue->tryPop(value)) {
+      queue->wait(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(value.second, expected[value.first]);
+    ++expected[value.first];
+  }
+  for (auto & producer : producers) {
+    producer.join();
+  }
+  ASSERT_EQ(queue->beginRead(), nullptr);
+}
+
+TEST_F(SharedMemoryQueueTest, CrossProcessTest)
+{
+  const int kCount = 10000;
+  const pid_t kChild = ::fork();
+  if (kChild == 0) {
+    SharedMemoryQueue producerQueue(name, SharedMemoryQueue::OpenMode::Open);
+    for (int i = 0; i < kCount; ++i) {
+      while (!producerQueue.tryPush(std::string(i % 32, 'c'))) {
+        std::this_thread::yield();
+      }
+    }
+    ::_exit(0);
+  }
+  ASSERT_GT(kChild, 0);
+  for (int i = 0; i < kCount; ++i) {
+    std::string value;
+    while (!queue->tryPop(value)) {
+      queue->wait(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(value, std::string(i % 32, 'c'));
+  }
+  int status = 0;
+  ASSERT_EQ(::waitpid(kChild, &status, 0), kChild);
+  ASSERT_EQ(WIFEXITED(status) && WEXITSTATUS(status) == 0, true);
+}
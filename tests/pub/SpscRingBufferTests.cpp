@@ -0,0 +1,121 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "pub/SpscRingBuffer.hpp"
+
+using buffers::SpscRingBuffer;
+using buffers::PackBuffer;
+using buffers::UnpackBuffer;
+
+struct SpscRingBufferTest : testing::Test
+{
+  SpscRingBuffer * ring;
+  virtual void SetUp() {
+    ring = new SpscRingBuffer(256);
+  };
+
+  virtual void TearDown() {
+    delete ring;
+  };
+};
+
+TEST_F(SpscRingBufferTest, PushPopTest)
+{
+  ASSERT_EQ(ring->empty(), true);
+  ASSERT_EQ(ring->tryPush(1), true);
+  ASSERT_EQ(ring->tryPush(std::string{"Hello"}), true);
+  PackBuffer * buffer = ring->beginWrite();
+  ASSERT_NE(buffer, nullptr);
+  ASSERT_EQ(buffer->put(uint8_t{ 3 }), true);
+  ASSERT_EQ(buffer->put(std::vector<int>{4, 5}), true);
+  ASSERT_EQ(ring->commitWrite(), true);
+
+  int value = 0;
+  ASSERT_EQ(ring->tryPop(value), true);
+  ASSERT_EQ(value, 1);
+  std::string str;
+  ASSERT_EQ(ring->tryPop(str), true);
+  ASSERT_EQ(str, std::string{"Hello"});
+  UnpackBuffer * unbuffer = ring->beginRead();
+  ASSERT_NE(unbuffer, nullptr);
+  ASSERT_EQ(unbuffer->get<uint8_t>(), 3);
+  ASSERT_EQ(unbuffer->get<std::vector<int>>(), (std::vector<int>{4, 5}));
+  ring->commitRead();
+  ASSERT_EQ(ring->beginRead(), nullptr);
+  ASSERT_EQ(ring->empty(), true);
+}
+
+TEST_F(SpscRingBufferTest, FullTest)
+{
+  int pushed = 0;
+  while (ring->tryPush(uint64_t(pushed))) {
+    ++pushed;
+  }
+  // Every record is 4 bytes of header and 8 bytes of value aligned to 16 bytes
+  ASSERT_EQ(pushed, 16);
+  uint64_t value = 0;
+  ASSERT_EQ(ring->tryPop(value), true);
+  ASSERT_EQ(value, 0);
+  ASSERT_EQ(ring->tryPush(uint64_t(100)), true);
+  ASSERT_EQ(ring->tryPush(uint64_t(101)), false);
+}
+
+TEST_F(SpscRingBufferTest, StaleHeadTest)
+{
+  for (int i = 0; i < 14; ++i) {
+    ASSERT_EQ(ring->tryPush(uint64_t(i)), true);
+  }
+  uint64_t value = 0;
+  ASSERT_EQ(ring->tryPop(value), true);
+  ASSERT_EQ(ring->tryPop(value), true);
+  // Message does not fit till the end, so ring wraps and producer caches head of partially read ring
+  ASSERT_EQ(ring->beginWrite(60), nullptr);
+  while (ring->tryPop(value)) {
+  }
+  ASSERT_EQ(ring->empty(), true);
+  ASSERT_EQ(ring->tryPush(std::string(40, 's')), true);
+  std::string str;
+  ASSERT_EQ(ring->tryPop(str), true);
+  ASSERT_EQ(str, std::string(40, 's'));
+}
+
+TEST_F(SpscRingBufferTest, WrapAroundTest)
+{
+  const std::string kText(100, 't');
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(ring->tryPush(kText + std::to_string(i)), true);
+    ASSERT_EQ(ring->tryPush(i), true);
+    std::string str;
+    ASSERT_EQ(ring->tryPop(str), true);
+    ASSERT_EQ(str, kText + std::to_string(i));
+    int value = 0;
+    ASSERT_EQ(ring->tryPop(value), true);
+    ASSERT_EQ(value, i);
+  }
+  ASSERT_EQ(ring->empty(), true);
+}
+
+TEST_F(SpscRingBufferTest, ConcurrentTest)
+{
+  const int kCount = 200000;
+  std::thread producer([this, kCount] {
+    for (int i = 0; i < kCount; ++i) {
+      while (!ring->tryPush(std::make_pair(i, std::string(i % 50, 'a')))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (int i = 0; i < kCount; ++i) {
+    std::pair<int, std::string> value;
+    while (!ring->tryPop(value)) {
+      std::this_thread::yield();
+    }
+    ASSERT_EQ(value.first, i);
+    ASSERT_EQ(value.second, std::string(i % 50, 'a'));
+  }
+  producer.join();
+  ASSERT_EQ(ring->empty(), true);
+}
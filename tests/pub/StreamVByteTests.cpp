@@ -0,0 +1,106 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <limits>
+#include <random>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/StreamVByte.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::StreamVByte;
+using buffers::StreamVByteVector;
+
+struct StreamVByteTest : testing::Test
+{
+  HeapPackBuffer buffer{1 << 20};
+
+  /**
+   * Method for generating of mostly small values with rare large ones
+   */
+  template <typename T>
+  static std::vector<T> generate(const size_t _count) {
+    std::mt19937_64 random(42);
+    std::vector<T> result(_count);
+    for (auto & value : result) {
+      const unsigned kBits = (random() % 8 == 0) ? (8 * sizeof(T)) : 10;
+      value = static_cast<T>(random() >> (64 - kBits));
+    }
+    return result;
+  }
+};
+
+TEST_F(StreamVByteTest, KernelsAreIdenticalTest) {
+  const StreamVByte::Kernel kKernels[] = {
+    StreamVByte::Kernel::Scalar, StreamVByte::Kernel::Sse41, StreamVByte::Kernel::Avx2
+  };
+  for (const size_t kCount : {0, 1, 7, 8, 9, 1001}) {
+    const std::vector<uint32_t> kValues = generate<uint32_t>(kCount);
+    std::vector<uint8_t> expected(StreamVByte::getControlSize(kCount) + 4 * kCount + 1);
+    uint8_t * pExpectedEnd = StreamVByte::encode(kValues.data(), kCount, expected.data(),
+                                                 expected.data() + StreamVByte::getControlSize(kCount),
+                                                 expected.data() + expected.size(), StreamVByte::Kernel::Scalar);
+    ASSERT_NE(pExpectedEnd, nullptr);
+    for (const auto kKernel : kKernels) {
+      if (!StreamVByte::isSupported(kKernel)) {
+        continue;
+      }
+      std::vector<uint8_t> encoded(expected.size());
+      uint8_t * pEnd = StreamVByte::encode(kValues.data(), kCount, encoded.data(),
+                                           encoded.data() + StreamVByte::getControlSize(kCount),
+                                           encoded.data() + encoded.size(), kKernel);
+      ASSERT_EQ(pEnd - encoded.data(), pExpectedEnd - expected.data());
+      ASSERT_EQ(std::memcmp(encoded.data(), expected.data(), static_cast<size_t>(pEnd - encoded.data())), 0);
+
+      std::vector<uint32_t> decoded(kCount);
+      uint8_t const * pDecodedEnd = StreamVByte::decode(encoded.data(),
+                                                        encoded.data() + StreamVByte::getControlSize(kCount),
+                                                        pEnd, kCount, decoded.data(), kKernel);
+      ASSERT_EQ(pDecodedEnd, pEnd);
+      ASSERT_EQ(decoded, kValues);
+    }
+  }
+}
+
+TEST_F(StreamVByteTest, SmallValuesTest) {
+  StreamVByteVector<uint32_t> histogram = generate<uint32_t>(4096);
+  for (auto & value : histogram) {
+    value %= 200;
+  }
+  ASSERT_EQ(buffer.put(histogram), true);
+  // One data byte and quarter of control byte per value instead of four bytes
+  ASSERT_LT(buffer.getDataSize(), 4096 * 4 / 3);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<StreamVByteVector<uint32_t>>(), histogram);
+}
+
+TEST_F(StreamVByteTest, SignedAnd64BitTest) {
+  StreamVByteVector<int32_t> deltas{0, -1, 1, -300, 70000, std::numeric_limits<int32_t>::min(),
+                                    std::numeric_limits<int32_t>::max(), -2, 3, 4};
+  StreamVByteVector<uint64_t> offsets = generate<uint64_t>(333);
+  StreamVByteVector<int64_t> signedOffsets{-1, std::numeric_limits<int64_t>::min(), 5, 1LL << 40};
+  ASSERT_EQ(buffer.put(deltas), true);
+  ASSERT_EQ(buffer.put(offsets), true);
+  ASSERT_EQ(buffer.put(signedOffsets), true);
+  ASSERT_EQ(buffer.put(7), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<StreamVByteVector<int32_t>>(), deltas);
+  ASSERT_EQ(unpack.get<StreamVByteVector<uint64_t>>(), offsets);
+  ASSERT_EQ(unpack.get<StreamVByteVector<int64_t>>(), signedOffsets);
+  ASSERT_EQ(unpack.get<int>(), 7);
+}
+
+TEST_F(StreamVByteTest, ViewAndOverflowTest) {
+  const std::vector<uint32_t> kValues = generate<uint32_t>(100);
+  ASSERT_EQ(buffer.put(buffers::streamVByte(kValues)), true);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(unpack.get<StreamVByteVector<uint32_t>>(), kValues);
+
+  uint8_t storage[64];
+  buffers::PackBuffer small(storage, sizeof(storage));
+  ASSERT_EQ(small.put(buffers::streamVByte(kValues)), false);
+  ASSERT_EQ(small.getDataSize(), 0);
+}
@@ -0,0 +1,174 @@
+//
+// Created by redra on 19.10.26.
+//
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "pub/HeapPackBuffer.hpp"
+#include "pub/StringInterning.hpp"
+
+using buffers::HeapPackBuffer;
+using buffers::UnpackBuffer;
+using buffers::InternEncoder;
+using buffers::InternDecoder;
+
+struct InternedOrder {
+  InternEncoder * encoder;
+  std::string symbol;
+  std::string comment;
+};
+
+namespace buffers {
+template <>
+class PackBuffer::DelegatePackBuffer<InternedOrder> {
+ public:
+  template <typename TBufferContext>
+  static bool put(TBufferContext & _ctx, const InternedOrder & _order) {
+    return DelegatePackBuffer<InternedString>::put(_ctx, _order.encoder->intern(_order.symbol)) &&
+           DelegatePackBuffer<std::string>::put(_ctx, _order.comment);
+  }
+};
+}
+
+/**
+ * Buffer which grows on failed put, so failed put is retried by PackBuffer
+ */
+class GrowingPackBuffer : public buffers::PackBuffer {
+ public:
+  explicit GrowingPackBuffer(const size_t _size)
+      : PackBuffer(nullptr, 0)
+      , storage_(_size) {
+    rebind(storage_.data(), storage_.size());
+  }
+
+ protected:
+  bool expand(const size_t _size) override {
+    storage_.resize(getDataSize() + _size);
+    rebind(storage_.data(), storage_.size());
+    return true;
+  }
+
+ private:
+  std::vector<uint8_t> storage_;
+};
+
+struct StringInterningTest : testing::Test
+{
+  HeapPackBuffer buffer{1 << 16};
+
+  /**
+   * Method for packing of one message with interned keys followed by int
+   */
+  size_t packMessage(InternEncoder & _encoder, const std::vector<std::string> & _keys, const int _value) {
+    buffer.reset();
+    for (const auto & kKey : _keys) {
+      EXPECT_EQ(buffer.put(_encoder.intern(kKey)), true);
+    }
+    EXPECT_EQ(buffer.put(_value), true);
+    return buffer.getDataSize();
+  }
+};
+
+TEST_F(StringInterningTest, RepeatedKeysTest) {
+  InternEncoder encoder;
+  InternDecoder decoder;
+  const std::vector<std::string> kKeys{"instrument.symbol", "instrument.exchange", "order.quantity"};
+  std::shared_ptr<const std::string> firstKey;
+  size_t firstSize = 0;
+  for (int message = 0; message < 3; ++message) {
+    const size_t kSize = packMessage(encoder, kKeys, message);
+    if (message == 0) {
+      firstSize = kSize;
+    } else {
+      // Every key is sent as 4-byte reference
+      ASSERT_EQ(kSize, 4 * sizeof(uint32_t));
+      ASSERT_LT(kSize, firstSize);
+    }
+    UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+    for (const auto & kKey : kKeys) {
+      const auto kString = decoder.get(unpack);
+      ASSERT_NE(kString, nullptr);
+      ASSERT_EQ(*kString, kKey);
+      if (&kKey == &kKeys[0]) {
+        if (message == 0) {
+          firstKey = kString;
+        }
+        // The same string object is shared by all messages
+        ASSERT_EQ(kString.get(), firstKey.get());
+      }
+    }
+    ASSERT_EQ(unpack.get<int>(), message);
+  }
+  ASSERT_EQ(encoder.getSize(), kKeys.size());
+}
+
+TEST_F(StringInterningTest, EvictionAndLiteralTest) {
+  InternEncoder encoder(2, 8);
+  InternDecoder decoder(2);
+  const std::vector<std::string> kKeys{"a", "b", "c", "a", "very long key", "c", "b", "very long key"};
+  packMessage(encoder, kKeys, 1);
+  ASSERT_EQ(encoder.getSize(), 2);
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  for (const auto & kKey : kKeys) {
+    const auto kString = decoder.get(unpack);
+    ASSERT_NE(kString, nullptr);
+    ASSERT_EQ(*kString, kKey);
+  }
+  ASSERT_EQ(unpack.get<int>(), 1);
+
+  encoder.reset();
+  decoder.reset();
+  packMessage(encoder, {"c"}, 2);
+  ASSERT_GT(buffer.getDataSize(), 2 * sizeof(uint32_t));
+  UnpackBuffer afterReset(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(*decoder.get(afterReset), "c");
+}
+
+TEST_F(StringInterningTest, FailedPutAndUnknownReferenceTest) {
+  InternEncoder encoder;
+  uint8_t storage[8];
+  buffers::PackBuffer small(storage, sizeof(storage));
+  ASSERT_EQ(small.put(encoder.intern("too long for buffer")), false);
+  ASSERT_EQ(encoder.getSize(), 0);
+
+  packMessage(encoder, {"key", "key"}, 3);
+  InternDecoder decoder;
+  UnpackBuffer unpack(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(*decoder.get(unpack), "key");
+  ASSERT_EQ(*decoder.get(unpack), "key");
+
+  // The other decoder has not seen definition of the key
+  InternDecoder otherDecoder;
+  UnpackBuffer reference(buffer.getData() + 8, buffer.getDataSize() - 8);
+  ASSERT_THROW(otherDecoder.get(reference), std::out_of_range);
+}
+
+TEST_F(StringInterningTest, FailedOuterPutTest) {
+  InternEncoder encoder(2);
+  InternDecoder decoder(2);
+  packMessage(encoder, {"first", "second"}, 0);
+  UnpackBuffer first(buffer.getData(), buffer.getDataSize());
+  ASSERT_EQ(*decoder.get(first), "first");
+  ASSERT_EQ(*decoder.get(first), "second");
+
+  // Symbol fits to the buffer but comment does not, so the whole order is rolled back
+  uint8_t storage[32];
+  buffers::PackBuffer small(storage, sizeof(storage));
+  ASSERT_EQ(encoder.pack(small, InternedOrder{&encoder, "third", std::string(64, 'c')}), false);
+  ASSERT_EQ(small.getDataSize(), 0);
+
+  // Growing buffer fails the first attempt and retries the whole order after expanding
+  GrowingPackBuffer growing(16);
+  ASSERT_EQ(growing.put(1), true);
+  const InternedOrder kOrder{&encoder, "fourth", "cc"};
+  ASSERT_EQ(encoder.pack(growing, kOrder), true);
+  ASSERT_EQ(growing.put(encoder.intern("first")), true);
+  ASSERT_EQ(growing.put(encoder.intern("fourth")), true);
+  UnpackBuffer second(growing.getData(), growing.getDataSize());
+  ASSERT_EQ(second.get<int>(), 1);
+  ASSERT_EQ(*decoder.get(second), "fourth");
+  ASSERT_EQ(second.get<std::string>(), kOrder.comment);
+  ASSERT_EQ(*decoder.get(second), "first");
+  ASSERT_EQ(*decoder.get(second), "fourth");
+}